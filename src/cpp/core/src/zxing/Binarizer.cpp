@@ -21,6 +21,7 @@
  */
 
 #include <zxing/Binarizer.h>
+#include <zxing/Exception.h>
 
 namespace zxing {
 	
@@ -30,6 +31,18 @@ namespace zxing {
 	Binarizer::~Binarizer() {
 	}
 	
+  void Binarizer::getBlackRows(int firstRow, int count, int stride,
+                               std::vector<Ref<BitArray> >& rows) {
+    rows.resize(count);
+    for (int i = 0; i < count; i++) {
+      try {
+        rows[i] = getBlackRow(firstRow + i * stride, rows[i]);
+      } catch (Exception const&) {
+        rows[i] = NULL;
+      }
+    }
+  }
+
 	Ref<LuminanceSource> Binarizer::getLuminanceSource() const {
 		return source_;
 	}
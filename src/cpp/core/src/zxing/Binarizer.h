@@ -20,6 +20,7 @@
  * limitations under the License.
  */
 
+#include <vector>
 #include <zxing/LuminanceSource.h>
 #include <zxing/common/BitArray.h>
 #include <zxing/common/BitMatrix.h>
@@ -36,6 +37,10 @@ class Binarizer : public Counted {
   virtual ~Binarizer();
 
   virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row) = 0;
+  // Binarizes count rows, stride apart, starting at firstRow. Rows that
+  // cannot be binarized are set to NULL. The default calls getBlackRow.
+  virtual void getBlackRows(int firstRow, int count, int stride,
+                            std::vector<Ref<BitArray> >& rows);
   virtual Ref<BitMatrix> getBlackMatrix() = 0;
 
   Ref<LuminanceSource> getLuminanceSource() const ;
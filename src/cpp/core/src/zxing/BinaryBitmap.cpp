@@ -18,6 +18,7 @@
  */
 
 #include <zxing/BinaryBitmap.h>
+#include <zxing/common/IllegalArgumentException.h>
 
 namespace zxing {
 	
@@ -25,6 +26,10 @@ namespace zxing {
 		
 	}
 	
+	BinaryBitmap::BinaryBitmap(Ref<Binarizer> binarizer, Ref<BitMatrix> matrix) :
+	    binarizer_(binarizer), matrix_(matrix) {
+	}
+	
 	BinaryBitmap::~BinaryBitmap() {
 	}
 	
@@ -32,8 +37,16 @@ namespace zxing {
 		return binarizer_->getBlackRow(y, row);
 	}
 	
+	void BinaryBitmap::getBlackRows(int firstRow, int count, int stride,
+	                                std::vector<Ref<BitArray> >& rows) {
+		binarizer_->getBlackRows(firstRow, count, stride, rows);
+	}
+	
 	Ref<BitMatrix> BinaryBitmap::getBlackMatrix() {
-		return binarizer_->getBlackMatrix();
+		if (matrix_.empty()) {
+			matrix_ = binarizer_->getBlackMatrix();
+		}
+		return matrix_;
 	}
 	
 	int BinaryBitmap::getWidth() const {
@@ -47,6 +60,10 @@ namespace zxing {
 	Ref<LuminanceSource> BinaryBitmap::getLuminanceSource() const {
 		return binarizer_->getLuminanceSource();
 	}
+
+	Ref<Binarizer> BinaryBitmap::getBinarizer() const {
+		return binarizer_;
+	}
 	
 
 	bool BinaryBitmap::isCropSupported() const {
@@ -54,7 +71,11 @@ namespace zxing {
 	}
 
 	Ref<BinaryBitmap> BinaryBitmap::crop(int left, int top, int width, int height) {
-	  return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->crop(left, top, width, height))));
+	  Ref<Binarizer> binarizer(binarizer_->createBinarizer(getLuminanceSource()->crop(left, top, width, height)));
+	  if (matrix_.empty()) {
+	    return Ref<BinaryBitmap> (new BinaryBitmap(binarizer));
+	  }
+	  return Ref<BinaryBitmap> (new BinaryBitmap(binarizer, matrix_->crop(left, top, width, height)));
 	}
 
 	bool BinaryBitmap::isRotateSupported() const {
@@ -64,4 +85,22 @@ namespace zxing {
 	Ref<BinaryBitmap> BinaryBitmap::rotateCounterClockwise() {
 	  return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->rotateCounterClockwise())));
 	}
+
+	int BinaryBitmap::getLevelCount() const {
+	  return getLuminanceSource()->getLevelCount();
+	}
+
+	Ref<BinaryBitmap> BinaryBitmap::getLevel(int level) {
+	  if (levels_.empty()) {
+	    levels_.resize(getLevelCount() - 1);
+	  }
+	  if (level < 1 || level > (int)levels_.size()) {
+	    throw IllegalArgumentException("Requested level is outside the pyramid.");
+	  }
+	  Ref<BinaryBitmap>& bitmap = levels_[level - 1];
+	  if (bitmap.empty()) {
+	    bitmap = new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->getLevel(level)));
+	  }
+	  return bitmap;
+	}
 }
@@ -30,16 +30,26 @@ namespace zxing {
 	class BinaryBitmap : public Counted {
 	private:
 		Ref<Binarizer> binarizer_;
+		// Cached by getBlackMatrix(), or a view of the parent's for a crop.
+		Ref<BitMatrix> matrix_;
+		// Bitmaps of the source's downscaled levels, from level 1 up.
+		std::vector<Ref<BinaryBitmap> > levels_;
 		int __attribute ((unused)) cached_y_;
 		
 	public:
 		BinaryBitmap(Ref<Binarizer> binarizer);
+		// For a matrix already binarized from the binarizer's luminance source;
+		// the binarizer is then only used for rows.
+		BinaryBitmap(Ref<Binarizer> binarizer, Ref<BitMatrix> matrix);
 		virtual ~BinaryBitmap();
 		
 		Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+		void getBlackRows(int firstRow, int count, int stride, std::vector<Ref<BitArray> >& rows);
 		Ref<BitMatrix> getBlackMatrix();
 		
 		Ref<LuminanceSource> getLuminanceSource() const;
+		// For binarizing other sources the way this bitmap is binarized.
+		Ref<Binarizer> getBinarizer() const;
 
 		int getWidth() const;
 		int getHeight() const;
@@ -48,8 +58,15 @@ namespace zxing {
 		Ref<BinaryBitmap> rotateCounterClockwise();
 
 		bool isCropSupported() const;
+		// Once this bitmap's matrix exists, the crop's matrix is a view of it
+		// rather than a binarization of the cropped luminance.
 		Ref<BinaryBitmap> crop(int left, int top, int width, int height);
 
+		// The source's downscaled levels, binarized the same way as this
+		// bitmap. Each level's bitmap is made once and kept.
+		int getLevelCount() const;
+		Ref<BinaryBitmap> getLevel(int level);
+
 	};
 	
 }
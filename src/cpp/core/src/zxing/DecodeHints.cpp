@@ -104,6 +104,30 @@ bool DecodeHints::getTryHarder() const {
   return (hints & TRYHARDER_HINT);
 }
 
+void DecodeHints::setCoarseToFine(bool toset) {
+  if (toset) {
+    hints |= COARSE_TO_FINE_HINT;
+  } else {
+    hints &= ~COARSE_TO_FINE_HINT;
+  }
+}
+
+bool DecodeHints::getCoarseToFine() const {
+  return (hints & COARSE_TO_FINE_HINT);
+}
+
+void DecodeHints::setColumnCopy(bool toset) {
+  if (toset) {
+    hints |= COLUMN_COPY_HINT;
+  } else {
+    hints &= ~COLUMN_COPY_HINT;
+  }
+}
+
+bool DecodeHints::getColumnCopy() const {
+  return (hints & COLUMN_COPY_HINT);
+}
+
 void DecodeHints::setResultPointCallback(Ref<ResultPointCallback> const& _callback) {
     callback = _callback;
 }
@@ -46,6 +46,8 @@ class DecodeHints {
   static const DecodeHintType BARCODEFORMAT_CODE_39_HINT = 1 << BarcodeFormat_CODE_39;
   static const DecodeHintType BARCODEFORMAT_ITF_HINT = 1 << BarcodeFormat_ITF;
   static const DecodeHintType BARCODEFORMAT_AZTEC_HINT = 1 << BarcodeFormat_AZTEC;
+  static const DecodeHintType COLUMN_COPY_HINT = 1 << 28;
+  static const DecodeHintType COARSE_TO_FINE_HINT = 1 << 29;
   static const DecodeHintType CHARACTER_SET = 1 << 30;
   static const DecodeHintType TRYHARDER_HINT = 1 << 31;
 
@@ -60,6 +62,17 @@ class DecodeHints {
   bool containsFormat(BarcodeFormat tocheck) const;
   void setTryHarder(bool toset);
   bool getTryHarder() const;
+  // With a pyramid source (see PyramidLuminanceSource), the QR Code, Data
+  // Matrix and Aztec readers look for symbols on the coarsest level first,
+  // and sample the grid they find at full resolution. A level whose symbol
+  // does not decode falls through to the next finer one.
+  void setCoarseToFine(bool toset);
+  bool getCoarseToFine() const;
+  // The QR Code detector reads the vertical runs of its cross-checks from
+  // a transposed copy of the black matrix (see BitMatrix::setColumnCopy),
+  // which pays off on large frames with many long vertical runs.
+  void setColumnCopy(bool toset);
+  bool getColumnCopy() const;
 
   void setResultPointCallback(Ref<ResultPointCallback> const&);
   Ref<ResultPointCallback> getResultPointCallback() const;
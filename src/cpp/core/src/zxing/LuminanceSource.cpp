@@ -24,12 +24,30 @@
 
 namespace zxing {
 
+LuminanceView::LuminanceView(unsigned char const* data, int stride, int width, int height) :
+  data_(data), stride_(stride), width_(width), height_(height) {
+}
+
+LuminanceView::LuminanceView(ArrayRef<unsigned char> copy, int width, int height) :
+  data_(copy.size() == 0 ? 0 : &copy[0]), stride_(width), width_(width), height_(height), copy_(copy) {
+}
+
 LuminanceSource::LuminanceSource() {
 }
 
 LuminanceSource::~LuminanceSource() {
 }
 
+LuminanceView LuminanceSource::getMatrixView() {
+  int width = getWidth();
+  int height = getHeight();
+  ArrayRef<unsigned char> copy(width * height);
+  for (int y = 0; y < height && width > 0; y++) {
+    getRow(y, &copy[y * width]);
+  }
+  return LuminanceView(copy, width, height);
+}
+
 bool LuminanceSource::isCropSupported() const {
   return false;
 }
@@ -50,6 +68,15 @@ Ref<LuminanceSource> LuminanceSource::rotateCounterClockwise() {
   throw IllegalArgumentException("This luminance source does not support rotation.");
 }
 
+int LuminanceSource::getLevelCount() const {
+  return 1;
+}
+
+Ref<LuminanceSource> LuminanceSource::getLevel(int level) {
+  (void)level;
+  throw IllegalArgumentException("This luminance source has no downscaled levels.");
+}
+
 LuminanceSource::operator std::string() {
   unsigned char* row = 0;
   std::ostringstream oss;
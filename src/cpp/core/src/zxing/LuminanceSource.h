@@ -21,10 +21,47 @@
  */
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/Array.h>
 #include <string.h>
 
 namespace zxing {
 
+/**
+ * Read-only access to a source's luminance, row y starting at
+ * getRow(y) and rows stride bytes apart. A view either borrows the
+ * source's own pixels, in which case it is only valid while the source is,
+ * or holds a copy that it keeps alive itself.
+ */
+class LuminanceView {
+private:
+  unsigned char const* data_;
+  int stride_;
+  int width_;
+  int height_;
+  ArrayRef<unsigned char> copy_;
+
+public:
+  LuminanceView(unsigned char const* data, int stride, int width, int height);
+  // Takes a width * height copy with stride == width.
+  LuminanceView(ArrayRef<unsigned char> copy, int width, int height);
+
+  unsigned char const* getRow(int y) const {
+    return data_ + y * stride_;
+  }
+  int getStride() const {
+    return stride_;
+  }
+  int getWidth() const {
+    return width_;
+  }
+  int getHeight() const {
+    return height_;
+  }
+  bool isBorrowed() const {
+    return copy_.array_ == 0;
+  }
+};
+
 class LuminanceSource : public Counted {
 public:
   LuminanceSource();
@@ -36,6 +73,9 @@ public:
   // Callers take ownership of the returned memory and must call delete [] on it themselves.
   virtual unsigned char* getRow(int y, unsigned char* row) = 0;
   virtual unsigned char* getMatrix() = 0;
+  // Returns the whole image without copying it where the source allows.
+  // The default copies it a row at a time with getRow().
+  virtual LuminanceView getMatrixView();
 
   virtual bool isCropSupported() const;
   virtual Ref<LuminanceSource> crop(int left, int top, int width, int height);
@@ -43,6 +83,12 @@ public:
   virtual bool isRotateSupported() const;
   virtual Ref<LuminanceSource> rotateCounterClockwise();
 
+  // Downscaled copies for coarse-to-fine detection, level n at 1 / 2^n of
+  // the size. Level 0 is the source itself, so getLevel() takes levels 1
+  // to getLevelCount() - 1. The default has no other levels.
+  virtual int getLevelCount() const;
+  virtual Ref<LuminanceSource> getLevel(int level);
+
   operator std::string (); // should be const but don't want to make sure a
                            // large breaking change right now
 };
@@ -21,6 +21,7 @@
 
 #include <zxing/ResultPoint.h>
 #include <zxing/common/detector/math_utils.h>
+#include <algorithm>
 
 namespace math_utils = zxing::common::detector::math_utils;
 
@@ -40,7 +41,11 @@ float ResultPoint::getY() const {
   return posY_;
 }
 
-bool ResultPoint::equals(Ref<ResultPoint> other) {
+Point ResultPoint::getPoint() const {
+  return Point(getX(), getY());
+}
+
+bool ResultPoint::equals(Ref<ResultPoint> const& other) {
   return posX_ == other->getX() && posY_ == other->getY();
 }
 
@@ -49,43 +54,47 @@ bool ResultPoint::equals(Ref<ResultPoint> other) {
  * BC < AC and the angle between BC and BA is less than 180 degrees.
  */
 void ResultPoint::orderBestPatterns(std::vector<Ref<ResultPoint> > &patterns) {
+    Point points[] = { patterns[0]->getPoint(), patterns[1]->getPoint(), patterns[2]->getPoint() };
     // Find distances between pattern centers
-    float zeroOneDistance = distance(patterns[0]->getX(), patterns[1]->getX(),patterns[0]->getY(), patterns[1]->getY());
-    float oneTwoDistance = distance(patterns[1]->getX(), patterns[2]->getX(),patterns[1]->getY(), patterns[2]->getY());
-    float zeroTwoDistance = distance(patterns[0]->getX(), patterns[2]->getX(),patterns[0]->getY(), patterns[2]->getY());
+    float zeroOneDistance = distance(points[0], points[1]);
+    float oneTwoDistance = distance(points[1], points[2]);
+    float zeroTwoDistance = distance(points[0], points[2]);
 
-    Ref<ResultPoint> pointA, pointB, pointC;
+    int a, b, c;
     // Assume one closest to other two is B; A and C will just be guesses at first
     if (oneTwoDistance >= zeroOneDistance && oneTwoDistance >= zeroTwoDistance) {
-      pointB = patterns[0];
-      pointA = patterns[1];
-      pointC = patterns[2];
+      b = 0;
+      a = 1;
+      c = 2;
     } else if (zeroTwoDistance >= oneTwoDistance && zeroTwoDistance >= zeroOneDistance) {
-      pointB = patterns[1];
-      pointA = patterns[0];
-      pointC = patterns[2];
+      b = 1;
+      a = 0;
+      c = 2;
     } else {
-      pointB = patterns[2];
-      pointA = patterns[0];
-      pointC = patterns[1];
+      b = 2;
+      a = 0;
+      c = 1;
     }
 
     // Use cross product to figure out whether A and C are correct or flipped.
     // This asks whether BC x BA has a positive z component, which is the arrangement
     // we want for A, B, C. If it's negative, then we've got it flipped around and
     // should swap A and C.
-    if (crossProductZ(pointA, pointB, pointC) < 0.0f) {
-      Ref<ResultPoint> temp = pointA;
-      pointA = pointC;
-      pointC = temp;
+    if (crossProductZ(points[a], points[b], points[c]) < 0.0f) {
+      std::swap(a, c);
     }
 
-    patterns[0] = pointA;
-    patterns[1] = pointB;
-    patterns[2] = pointC;
+    // Swapped rather than copied into place, which leaves the counts alone.
+    Ref<ResultPoint> pointA, pointB, pointC;
+    pointA.swap(patterns[a]);
+    pointB.swap(patterns[b]);
+    pointC.swap(patterns[c]);
+    patterns[0].swap(pointA);
+    patterns[1].swap(pointB);
+    patterns[2].swap(pointC);
 }
 
-  float ResultPoint::distance(Ref<ResultPoint> pattern1, Ref<ResultPoint> pattern2) {
+float ResultPoint::distance(Ref<ResultPoint> const& pattern1, Ref<ResultPoint> const& pattern2) {
   return math_utils::distance(pattern1->posX_,
                               pattern1->posY_,
                               pattern2->posX_,
@@ -98,9 +107,13 @@ float ResultPoint::distance(float x1, float x2, float y1, float y2) {
   return (float) sqrt((double) (xDiff * xDiff + yDiff * yDiff));
 }
 
-float ResultPoint::crossProductZ(Ref<ResultPoint> pointA, Ref<ResultPoint> pointB, Ref<ResultPoint> pointC) {
-  float bX = pointB->getX();
-  float bY = pointB->getY();
-  return ((pointC->getX() - bX) * (pointA->getY() - bY)) - ((pointC->getY() - bY) * (pointA->getX() - bX));
+float ResultPoint::distance(Point const& point1, Point const& point2) {
+  return math_utils::distance(point1.x, point1.y, point2.x, point2.y);
+}
+
+float ResultPoint::crossProductZ(Point const& pointA, Point const& pointB, Point const& pointC) {
+  float bX = pointB.x;
+  float bY = pointB.y;
+  return ((pointC.x - bX) * (pointA.y - bY)) - ((pointC.y - bY) * (pointA.x - bX));
 }
 }
@@ -22,11 +22,13 @@
  */
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/DecodeContext.h>
+#include <zxing/common/Point.h>
 #include <vector>
 
 namespace zxing {
 
-class ResultPoint : public Counted {
+class ResultPoint : public Counted, public ArenaObject {
 protected:
   float posX_;
   float posY_;
@@ -38,15 +40,18 @@ public:
 
   virtual float getX() const;
   virtual float getY() const;
+  // The position alone, as the detectors do their geometry on it.
+  Point getPoint() const;
 
-  bool equals(Ref<ResultPoint> other);
+  bool equals(Ref<ResultPoint> const& other);
 
   static void orderBestPatterns(std::vector<Ref<ResultPoint> > &patterns);
-  static float distance(Ref<ResultPoint> point1, Ref<ResultPoint> point2);
+  static float distance(Ref<ResultPoint> const& point1, Ref<ResultPoint> const& point2);
   static float distance(float x1, float x2, float y1, float y2);
+  static float distance(Point const& point1, Point const& point2);
 
 private:
-  static float crossProductZ(Ref<ResultPoint> pointA, Ref<ResultPoint> pointB, Ref<ResultPoint> pointC);
+  static float crossProductZ(Point const& pointA, Point const& pointB, Point const& pointC);
 };
 
 }
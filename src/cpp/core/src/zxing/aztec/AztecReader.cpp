@@ -21,6 +21,7 @@
 
 #include <zxing/aztec/AztecReader.h>
 #include <zxing/aztec/detector/Detector.h>
+#include <zxing/Exception.h>
 #include <iostream>
 
 namespace zxing {
@@ -47,8 +48,23 @@ namespace zxing {
       return result;
     }
         
-    Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints) {
-      //cout << "decoding with hints not supported for aztec" << "\n" << flush;
+    Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+      if (hints.getCoarseToFine()) {
+        for (int level = image->getLevelCount() - 1; level > 0; level--) {
+          try {
+            Detector detector(image->getBlackMatrix());
+            Ref<AztecDetectorResult> detectorResult(
+              detector.detect(image->getLevel(level)->getBlackMatrix(), 1 << level));
+            Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult));
+            return Ref<Result>(new Result(decoderResult->getText(),
+                                          decoderResult->getRawBytes(),
+                                          detectorResult->getPoints(),
+                                          BarcodeFormat_AZTEC));
+          } catch (zxing::Exception const&) {
+            // Too coarse for the modules, or a false find; try the next level.
+          }
+        }
+      }
       return this->decode(image);
     }
         
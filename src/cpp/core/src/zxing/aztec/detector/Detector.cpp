@@ -49,8 +49,16 @@ Detector::Detector(Ref<BitMatrix> image):
 // using namespace std;
 
 Ref<AztecDetectorResult> Detector::detect() {
-  Ref<Point> pCenter = getMatrixCenter();
-            
+  return detect(getMatrixCenter());
+}
+
+Ref<AztecDetectorResult> Detector::detect(Ref<BitMatrix> coarse, int scale) {
+  Ref<Point> estimate = Detector(coarse).estimateMatrixCenter();
+  return detect(refineMatrixCenter(estimate->x * scale + scale / 2,
+                                   estimate->y * scale + scale / 2));
+}
+
+Ref<AztecDetectorResult> Detector::detect(Ref<Point> pCenter) {
   std::vector<Ref<Point> > bullEyeCornerPoints = getBullEyeCornerPoints(pCenter);
             
   extractParameters(bullEyeCornerPoints);
@@ -294,6 +302,11 @@ std::vector<Ref<Point> > Detector::getBullEyeCornerPoints(Ref<zxing::aztec::Poin
 }
         
 Ref<Point> Detector::getMatrixCenter() {
+  Ref<Point> estimate = estimateMatrixCenter();
+  return refineMatrixCenter(estimate->x, estimate->y);
+}
+
+Ref<Point> Detector::estimateMatrixCenter() {
   Ref<ResultPoint> pointA, pointB, pointC, pointD;
   try {
                 
@@ -317,7 +330,11 @@ Ref<Point> Detector::getMatrixCenter() {
             
   int cx = math_utils::round((pointA->getX() + pointD->getX() + pointB->getX() + pointC->getX()) / 4);
   int cy = math_utils::round((pointA->getY() + pointD->getY() + pointB->getY() + pointC->getY()) / 4);
-            
+  return Ref<Point>(new Point(cx, cy));
+}
+
+Ref<Point> Detector::refineMatrixCenter(int cx, int cy) {
+  Ref<ResultPoint> pointA, pointB, pointC, pointD;
   try {
                 
     std::vector<Ref<ResultPoint> > cornerPoints = WhiteRectangleDetector(image_, 15, cx, cy).detect();
@@ -60,6 +60,12 @@ namespace zxing {
             static void correctParameterData(Ref<BitArray> parameterData, bool compact);
             std::vector<Ref<Point> > getBullEyeCornerPoints(Ref<Point> pCenter);
             Ref<Point> getMatrixCenter();
+            // getMatrixCenter() in two steps: a rough center from the white
+            // rectangle around the whole symbol, then one from the rectangle
+            // around the bull's eye near it.
+            Ref<Point> estimateMatrixCenter();
+            Ref<Point> refineMatrixCenter(int cx, int cy);
+            Ref<AztecDetectorResult> detect(Ref<Point> pCenter);
             Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image,
                                       Ref<ResultPoint> topLeft,
                                       Ref<ResultPoint> bottomLeft,
@@ -79,6 +85,9 @@ namespace zxing {
         public:
             Detector(Ref<BitMatrix> image);
             Ref<AztecDetectorResult> detect();
+            // Takes the rough center from coarse, this detector's image
+            // scaled down by scale, and does the rest in the full image.
+            Ref<AztecDetectorResult> detect(Ref<BitMatrix> coarse, int scale);
         };
         
     }
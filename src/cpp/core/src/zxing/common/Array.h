@@ -29,11 +29,12 @@
 #endif
 
 #include <zxing/common/Counted.h>
+#include <zxing/common/DecodeContext.h>
 
 
 namespace zxing {
 
-template<typename T> class Array : public Counted {
+template<typename T> class Array : public Counted, public ArenaObject {
 protected:
 public:
   std::vector<T> values_;
@@ -0,0 +1,169 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  BandLuminanceSource.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/BandLuminanceSource.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <string.h>
+
+namespace zxing {
+
+namespace {
+  // A crop or rotation of the band, which keeps the band's buffer alive
+  // after the band itself is gone, as are its own crops and rotations.
+  class BandPartSource : public LuminanceSource {
+   private:
+    ArrayRef<unsigned char> luminances_;
+    Ref<LuminanceSource> source_;
+
+   public:
+    BandPartSource(ArrayRef<unsigned char> luminances, Ref<LuminanceSource> source) :
+        luminances_(luminances), source_(source) {
+    }
+
+    int getWidth() const {
+      return source_->getWidth();
+    }
+
+    int getHeight() const {
+      return source_->getHeight();
+    }
+
+    unsigned char* getRow(int y, unsigned char* row) {
+      return source_->getRow(y, row);
+    }
+
+    unsigned char* getMatrix() {
+      return source_->getMatrix();
+    }
+
+    LuminanceView getMatrixView() {
+      return source_->getMatrixView();
+    }
+
+    bool isCropSupported() const {
+      return source_->isCropSupported();
+    }
+
+    Ref<LuminanceSource> crop(int left, int top, int width, int height) {
+      return Ref<LuminanceSource>(new BandPartSource(luminances_,
+                                                     source_->crop(left, top, width, height)));
+    }
+
+    bool isRotateSupported() const {
+      return source_->isRotateSupported();
+    }
+
+    Ref<LuminanceSource> rotateCounterClockwise() {
+      return Ref<LuminanceSource>(new BandPartSource(luminances_,
+                                                     source_->rotateCounterClockwise()));
+    }
+  };
+}
+
+BandLuminanceSource::BandLuminanceSource(Ref<LuminanceSource> source, int capacity) :
+    source_(source), capacity_(capacity), top_(0), height_(0) {
+  if (capacity <= 0 || capacity > source->getHeight()) {
+    throw IllegalArgumentException("Band capacity must be between 1 and the image height.");
+  }
+  luminances_ = new Array<unsigned char>(source->getWidth() * capacity);
+}
+
+void BandLuminanceSource::moveTo(int top, int height) {
+  if (top < top_ || height <= 0 || height > capacity_ || top + height > source_->getHeight()) {
+    throw IllegalArgumentException("Band does not fit within the image or moves up.");
+  }
+  int width = source_->getWidth();
+  unsigned char* luminances = &luminances_[0];
+  int kept = 0;
+  if (top < top_ + height_) {
+    kept = top_ + height_ - top;
+    if (kept > height) {
+      kept = height;
+    }
+    memmove(luminances, luminances + (top - top_) * width, kept * width);
+  }
+  for (int y = kept; y < height; y++) {
+    source_->getRow(top + y, luminances + y * width);
+  }
+  top_ = top;
+  height_ = height;
+}
+
+int BandLuminanceSource::getTop() const {
+  return top_;
+}
+
+int BandLuminanceSource::getCapacity() const {
+  return capacity_;
+}
+
+unsigned char* BandLuminanceSource::getRow(int y, unsigned char* row) {
+  if (y < 0 || y >= height_) {
+    throw IllegalArgumentException("Requested row is outside the band.");
+  }
+  int width = getWidth();
+  if (row == NULL) {
+    row = new unsigned char[width];
+  }
+  memcpy(row, &luminances_[y * width], width);
+  return row;
+}
+
+unsigned char* BandLuminanceSource::getMatrix() {
+  int size = getWidth() * height_;
+  unsigned char* result = new unsigned char[size];
+  memcpy(result, &luminances_[0], size);
+  return result;
+}
+
+LuminanceView BandLuminanceSource::getMatrixView() {
+  return LuminanceView(&luminances_[0], getWidth(), getWidth(), height_);
+}
+
+int BandLuminanceSource::getWidth() const {
+  return source_->getWidth();
+}
+
+int BandLuminanceSource::getHeight() const {
+  return height_;
+}
+
+bool BandLuminanceSource::isCropSupported() const {
+  return true;
+}
+
+Ref<LuminanceSource> BandLuminanceSource::crop(int left, int top, int width, int height) {
+  Ref<LuminanceSource> cropped(new GreyscaleLuminanceSource(&luminances_[0], getWidth(),
+      height_, left, top, width, height));
+  return Ref<LuminanceSource>(new BandPartSource(luminances_, cropped));
+}
+
+bool BandLuminanceSource::isRotateSupported() const {
+  return true;
+}
+
+Ref<LuminanceSource> BandLuminanceSource::rotateCounterClockwise() {
+  Ref<LuminanceSource> upright(new GreyscaleLuminanceSource(&luminances_[0], getWidth(),
+      height_, 0, 0, getWidth(), height_));
+  return Ref<LuminanceSource>(new BandPartSource(luminances_, upright->rotateCounterClockwise()));
+}
+
+} /* namespace */
@@ -0,0 +1,71 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __BAND_LUMINANCE_SOURCE_H__
+#define __BAND_LUMINANCE_SOURCE_H__
+/*
+ *  BandLuminanceSource.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/LuminanceSource.h>
+
+namespace zxing {
+
+/**
+ * A band of whole rows of another source, for images too large to hold.
+ * The source is only ever read a row at a time with getRow(), never as a
+ * matrix. moveTo() slides the band down the image; rows still inside the
+ * band are moved up rather than read again, so a pass from top to bottom
+ * reads each source row once. The band's rows, matrix view, crops and
+ * rotations all point into its buffer, so what they show changes with the
+ * next move. Crops and rotations keep the buffer alive, so they may
+ * outlive the band; a matrix view may not.
+ */
+class BandLuminanceSource : public LuminanceSource {
+
+ private:
+  Ref<LuminanceSource> source_;
+  int capacity_;
+  ArrayRef<unsigned char> luminances_;
+  int top_;
+  int height_;
+
+ public:
+  // Holds up to capacity rows; the band starts empty.
+  BandLuminanceSource(Ref<LuminanceSource> source, int capacity);
+
+  // Shows source rows top to top + height - 1. The band may only move down.
+  void moveTo(int top, int height);
+  int getTop() const;
+  int getCapacity() const;
+
+  unsigned char* getRow(int y, unsigned char* row);
+  unsigned char* getMatrix();
+  LuminanceView getMatrixView();
+
+  int getWidth() const;
+  int getHeight() const;
+
+  bool isCropSupported() const;
+  Ref<LuminanceSource> crop(int left, int top, int width, int height);
+  bool isRotateSupported() const;
+  Ref<LuminanceSource> rotateCounterClockwise();
+
+};
+
+} /* namespace */
+
+#endif
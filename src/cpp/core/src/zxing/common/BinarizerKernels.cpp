@@ -0,0 +1,357 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  BinarizerKernels.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/BinarizerKernels.h>
+
+#ifdef ZXING_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef ZXING_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#ifdef ZXING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace zxing;
+using namespace zxing::simd;
+
+namespace {
+  const int BLOCK_SIZE = 8;
+
+  void blockStatisticsScalar(unsigned char const* luminances,
+                             int stride,
+                             int count,
+                             int* sums,
+                             int* mins,
+                             int* maxs) {
+    for (int i = 0; i < count; i++) {
+      unsigned char const* block = luminances + i * BLOCK_SIZE;
+      int sum = 0;
+      int min = 0xFF;
+      int max = 0;
+      for (int yy = 0; yy < BLOCK_SIZE; yy++, block += stride) {
+        for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+          int pixel = block[xx];
+          sum += pixel;
+          if (pixel < min) {
+            min = pixel;
+          }
+          if (pixel > max) {
+            max = pixel;
+          }
+        }
+      }
+      sums[i] = sum;
+      mins[i] = min;
+      maxs[i] = max;
+    }
+  }
+
+  void thresholdRowScalar(unsigned char const* pixels,
+                          unsigned char const* thresholds,
+                          int count,
+                          unsigned int* bits) {
+    for (int i = 0; i < count; i += 32) {
+      int end = count - i < 32 ? count - i : 32;
+      unsigned int word = 0;
+      for (int j = 0; j < end; j++) {
+        if (pixels[i + j] <= thresholds[i + j]) {
+          word |= 1u << j;
+        }
+      }
+      bits[i >> 5] = word;
+    }
+  }
+
+#ifdef ZXING_SIMD_SSE2
+  // Two blocks per 16 byte register. psadbw against zero sums each 8 byte
+  // half; the min/max reductions fold each 64 bit lane down into its lowest
+  // byte.
+  void blockStatisticsSse2(unsigned char const* luminances,
+                           int stride,
+                           int count,
+                           int* sums,
+                           int* mins,
+                           int* maxs) {
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+      unsigned char const* p = luminances + i * BLOCK_SIZE;
+      __m128i row = _mm_loadu_si128((__m128i const*)p);
+      __m128i sum = _mm_sad_epu8(row, zero);
+      __m128i min = row;
+      __m128i max = row;
+      for (int yy = 1; yy < BLOCK_SIZE; yy++) {
+        p += stride;
+        row = _mm_loadu_si128((__m128i const*)p);
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(row, zero));
+        min = _mm_min_epu8(min, row);
+        max = _mm_max_epu8(max, row);
+      }
+      min = _mm_min_epu8(min, _mm_srli_epi64(min, 32));
+      min = _mm_min_epu8(min, _mm_srli_epi64(min, 16));
+      min = _mm_min_epu8(min, _mm_srli_epi64(min, 8));
+      max = _mm_max_epu8(max, _mm_srli_epi64(max, 32));
+      max = _mm_max_epu8(max, _mm_srli_epi64(max, 16));
+      max = _mm_max_epu8(max, _mm_srli_epi64(max, 8));
+      sums[i] = _mm_cvtsi128_si32(sum);
+      sums[i + 1] = _mm_extract_epi16(sum, 4);
+      mins[i] = _mm_cvtsi128_si32(min) & 0xFF;
+      mins[i + 1] = _mm_extract_epi16(min, 4) & 0xFF;
+      maxs[i] = _mm_cvtsi128_si32(max) & 0xFF;
+      maxs[i + 1] = _mm_extract_epi16(max, 4) & 0xFF;
+    }
+    blockStatisticsScalar(luminances + i * BLOCK_SIZE, stride, count - i,
+                          sums + i, mins + i, maxs + i);
+  }
+
+  // Unsigned p <= t is min(p, t) == p; movemask then packs one bit per byte.
+  void thresholdRowSse2(unsigned char const* pixels,
+                        unsigned char const* thresholds,
+                        int count,
+                        unsigned int* bits) {
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+      __m128i p0 = _mm_loadu_si128((__m128i const*)(pixels + i));
+      __m128i p1 = _mm_loadu_si128((__m128i const*)(pixels + i + 16));
+      __m128i t0 = _mm_loadu_si128((__m128i const*)(thresholds + i));
+      __m128i t1 = _mm_loadu_si128((__m128i const*)(thresholds + i + 16));
+      unsigned int lo = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(p0, t0), p0));
+      unsigned int hi = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(p1, t1), p1));
+      bits[i >> 5] = lo | (hi << 16);
+    }
+    thresholdRowScalar(pixels + i, thresholds + i, count - i, bits + (i >> 5));
+  }
+#endif
+
+#ifdef ZXING_SIMD_AVX2
+  // Same as the SSE2 kernel with four blocks per 32 byte register.
+  __attribute__ ((target("avx2")))
+  void blockStatisticsAvx2(unsigned char const* luminances,
+                           int stride,
+                           int count,
+                           int* sums,
+                           int* mins,
+                           int* maxs) {
+    const __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+      unsigned char const* p = luminances + i * BLOCK_SIZE;
+      __m256i row = _mm256_loadu_si256((__m256i const*)p);
+      __m256i sum = _mm256_sad_epu8(row, zero);
+      __m256i min = row;
+      __m256i max = row;
+      for (int yy = 1; yy < BLOCK_SIZE; yy++) {
+        p += stride;
+        row = _mm256_loadu_si256((__m256i const*)p);
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(row, zero));
+        min = _mm256_min_epu8(min, row);
+        max = _mm256_max_epu8(max, row);
+      }
+      min = _mm256_min_epu8(min, _mm256_srli_epi64(min, 32));
+      min = _mm256_min_epu8(min, _mm256_srli_epi64(min, 16));
+      min = _mm256_min_epu8(min, _mm256_srli_epi64(min, 8));
+      max = _mm256_max_epu8(max, _mm256_srli_epi64(max, 32));
+      max = _mm256_max_epu8(max, _mm256_srli_epi64(max, 16));
+      max = _mm256_max_epu8(max, _mm256_srli_epi64(max, 8));
+      // Each result sits in the low bits of its 64 bit lane, i.e. in 16 bit
+      // element 4 * lane.
+      sums[i] = _mm256_extract_epi16(sum, 0);
+      sums[i + 1] = _mm256_extract_epi16(sum, 4);
+      sums[i + 2] = _mm256_extract_epi16(sum, 8);
+      sums[i + 3] = _mm256_extract_epi16(sum, 12);
+      mins[i] = _mm256_extract_epi16(min, 0) & 0xFF;
+      mins[i + 1] = _mm256_extract_epi16(min, 4) & 0xFF;
+      mins[i + 2] = _mm256_extract_epi16(min, 8) & 0xFF;
+      mins[i + 3] = _mm256_extract_epi16(min, 12) & 0xFF;
+      maxs[i] = _mm256_extract_epi16(max, 0) & 0xFF;
+      maxs[i + 1] = _mm256_extract_epi16(max, 4) & 0xFF;
+      maxs[i + 2] = _mm256_extract_epi16(max, 8) & 0xFF;
+      maxs[i + 3] = _mm256_extract_epi16(max, 12) & 0xFF;
+    }
+    blockStatisticsScalar(luminances + i * BLOCK_SIZE, stride, count - i,
+                          sums + i, mins + i, maxs + i);
+  }
+
+  __attribute__ ((target("avx2")))
+  void thresholdRowAvx2(unsigned char const* pixels,
+                        unsigned char const* thresholds,
+                        int count,
+                        unsigned int* bits) {
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+      __m256i p = _mm256_loadu_si256((__m256i const*)(pixels + i));
+      __m256i t = _mm256_loadu_si256((__m256i const*)(thresholds + i));
+      bits[i >> 5] = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(p, t), p));
+    }
+    thresholdRowScalar(pixels + i, thresholds + i, count - i, bits + (i >> 5));
+  }
+#endif
+
+#ifdef ZXING_SIMD_NEON
+  // Two blocks per 16 byte register. The sums are widened pairwise; the
+  // min/max reductions use pairwise ops on each 8 byte half so that this
+  // also builds for ARMv7.
+  void blockStatisticsNeon(unsigned char const* luminances,
+                           int stride,
+                           int count,
+                           int* sums,
+                           int* mins,
+                           int* maxs) {
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+      unsigned char const* p = luminances + i * BLOCK_SIZE;
+      uint8x16_t row = vld1q_u8(p);
+      uint16x8_t sum = vpaddlq_u8(row);
+      uint8x16_t min = row;
+      uint8x16_t max = row;
+      for (int yy = 1; yy < BLOCK_SIZE; yy++) {
+        p += stride;
+        row = vld1q_u8(p);
+        sum = vpadalq_u8(sum, row);
+        min = vminq_u8(min, row);
+        max = vmaxq_u8(max, row);
+      }
+      uint64x2_t sum64 = vpaddlq_u32(vpaddlq_u16(sum));
+      uint8x8_t minLo = vget_low_u8(min);
+      uint8x8_t minHi = vget_high_u8(min);
+      uint8x8_t maxLo = vget_low_u8(max);
+      uint8x8_t maxHi = vget_high_u8(max);
+      for (int step = 0; step < 3; step++) {
+        minLo = vpmin_u8(minLo, minLo);
+        minHi = vpmin_u8(minHi, minHi);
+        maxLo = vpmax_u8(maxLo, maxLo);
+        maxHi = vpmax_u8(maxHi, maxHi);
+      }
+      sums[i] = (int)vgetq_lane_u64(sum64, 0);
+      sums[i + 1] = (int)vgetq_lane_u64(sum64, 1);
+      mins[i] = vget_lane_u8(minLo, 0);
+      mins[i + 1] = vget_lane_u8(minHi, 0);
+      maxs[i] = vget_lane_u8(maxLo, 0);
+      maxs[i + 1] = vget_lane_u8(maxHi, 0);
+    }
+    blockStatisticsScalar(luminances + i * BLOCK_SIZE, stride, count - i,
+                          sums + i, mins + i, maxs + i);
+  }
+
+  // NEON has no movemask: weight each lane's compare result by its bit and
+  // add the lanes of each 8 byte half together.
+  void thresholdRowNeon(unsigned char const* pixels,
+                        unsigned char const* thresholds,
+                        int count,
+                        unsigned int* bits) {
+    static const unsigned char weights[16] = {
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+    };
+    const uint8x16_t weight = vld1q_u8(weights);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+      unsigned int word = 0;
+      for (int half = 0; half < 2; half++) {
+        uint8x16_t p = vld1q_u8(pixels + i + half * 16);
+        uint8x16_t t = vld1q_u8(thresholds + i + half * 16);
+        uint8x16_t dark = vandq_u8(vcleq_u8(p, t), weight);
+        uint64x2_t packed = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(dark)));
+        word |= (unsigned int)vgetq_lane_u64(packed, 0) << (half * 16);
+        word |= (unsigned int)vgetq_lane_u64(packed, 1) << (half * 16 + 8);
+      }
+      bits[i >> 5] = word;
+    }
+    thresholdRowScalar(pixels + i, thresholds + i, count - i, bits + (i >> 5));
+  }
+#endif
+}
+
+namespace zxing {
+namespace kernels {
+
+void blockStatistics(unsigned char const* luminances,
+                     int stride,
+                     int count,
+                     int* sums,
+                     int* mins,
+                     int* maxs) {
+  blockStatistics(bestLevel(), luminances, stride, count, sums, mins, maxs);
+}
+
+void blockStatistics(Level level,
+                     unsigned char const* luminances,
+                     int stride,
+                     int count,
+                     int* sums,
+                     int* mins,
+                     int* maxs) {
+  switch (level) {
+#ifdef ZXING_SIMD_AVX2
+    case AVX2:
+      blockStatisticsAvx2(luminances, stride, count, sums, mins, maxs);
+      return;
+#endif
+#ifdef ZXING_SIMD_SSE2
+    case SSE2:
+      blockStatisticsSse2(luminances, stride, count, sums, mins, maxs);
+      return;
+#endif
+#ifdef ZXING_SIMD_NEON
+    case NEON:
+      blockStatisticsNeon(luminances, stride, count, sums, mins, maxs);
+      return;
+#endif
+    default:
+      blockStatisticsScalar(luminances, stride, count, sums, mins, maxs);
+  }
+}
+
+void thresholdRow(unsigned char const* pixels,
+                  unsigned char const* thresholds,
+                  int count,
+                  unsigned int* bits) {
+  thresholdRow(bestLevel(), pixels, thresholds, count, bits);
+}
+
+void thresholdRow(Level level,
+                  unsigned char const* pixels,
+                  unsigned char const* thresholds,
+                  int count,
+                  unsigned int* bits) {
+  switch (level) {
+#ifdef ZXING_SIMD_AVX2
+    case AVX2:
+      thresholdRowAvx2(pixels, thresholds, count, bits);
+      return;
+#endif
+#ifdef ZXING_SIMD_SSE2
+    case SSE2:
+      thresholdRowSse2(pixels, thresholds, count, bits);
+      return;
+#endif
+#ifdef ZXING_SIMD_NEON
+    case NEON:
+      thresholdRowNeon(pixels, thresholds, count, bits);
+      return;
+#endif
+    default:
+      thresholdRowScalar(pixels, thresholds, count, bits);
+  }
+}
+
+}
+}
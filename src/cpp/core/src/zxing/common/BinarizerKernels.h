@@ -0,0 +1,66 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __BINARIZER_KERNELS_H__
+#define __BINARIZER_KERNELS_H__
+/*
+ *  BinarizerKernels.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Simd.h>
+
+namespace zxing {
+
+/**
+ * Inner loops of the binarizers, with vectorized versions for the
+ * instruction sets in Simd.h. Every level produces exactly the same output
+ * as the scalar code; the overloads without a level use simd::bestLevel().
+ * An explicit level must be one for which simd::isSupported() is true.
+ */
+namespace kernels {
+
+// Sum, minimum and maximum of count horizontally adjacent 8x8 blocks. The
+// first block's top left pixel is at luminances; rows are stride bytes apart.
+void blockStatistics(unsigned char const* luminances,
+                     int stride,
+                     int count,
+                     int* sums,
+                     int* mins,
+                     int* maxs);
+void blockStatistics(simd::Level level,
+                     unsigned char const* luminances,
+                     int stride,
+                     int count,
+                     int* sums,
+                     int* mins,
+                     int* maxs);
+
+// Packs (pixels[i] <= thresholds[i]) for i < count into bits, least
+// significant bit first, 32 pixels per word. The last word is zero padded.
+void thresholdRow(unsigned char const* pixels,
+                  unsigned char const* thresholds,
+                  int count,
+                  unsigned int* bits);
+void thresholdRow(simd::Level level,
+                  unsigned char const* pixels,
+                  unsigned char const* thresholds,
+                  int count,
+                  unsigned int* bits);
+
+}
+}
+
+#endif // __BINARIZER_KERNELS_H__
@@ -21,6 +21,21 @@ using namespace std;
 
 namespace zxing {
 
+namespace {
+  // The index of the lowest set bit of a nonzero word.
+  unsigned int countTrailingZeros(unsigned int word) {
+#ifdef __GNUC__
+    return __builtin_ctz(word);
+#else
+    unsigned int count = 0;
+    while ((word & 1) == 0) {
+      word >>= 1;
+      count++;
+    }
+    return count;
+#endif
+  }
+}
 
 size_t BitArray::wordsForBits(size_t bits) {
   int arraySize = (bits + bitsPerWord_ - 1) >> logBits_;
@@ -38,6 +53,48 @@ size_t BitArray::getSize() {
   return size_;
 }
 
+size_t BitArray::getNextSet(size_t from) {
+  if (from >= size_) {
+    return size_;
+  }
+  size_t word = from >> logBits_;
+  unsigned int current = bits_[word] & ~((1u << (from & bitsMask_)) - 1);
+  while (current == 0) {
+    if (++word == bits_.size()) {
+      return size_;
+    }
+    current = bits_[word];
+  }
+  size_t result = (word << logBits_) + countTrailingZeros(current);
+  return result < size_ ? result : size_;
+}
+
+size_t BitArray::getNextUnset(size_t from) {
+  if (from >= size_) {
+    return size_;
+  }
+  size_t word = from >> logBits_;
+  unsigned int current = ~bits_[word] & ~((1u << (from & bitsMask_)) - 1);
+  while (current == 0) {
+    if (++word == bits_.size()) {
+      return size_;
+    }
+    current = ~bits_[word];
+  }
+  size_t result = (word << logBits_) + countTrailingZeros(current);
+  return result < size_ ? result : size_;
+}
+
+void BitArray::toRunLengths(vector<int>& runs) {
+  runs.clear();
+  bool set = false;
+  for (size_t i = 0; i < size_; set = !set) {
+    size_t next = set ? getNextUnset(i) : getNextSet(i);
+    runs.push_back(next - i);
+    i = next;
+  }
+}
+
 void BitArray::setBulk(size_t i, unsigned int newBits) {
   bits_[i >> logBits_] = newBits;
 }
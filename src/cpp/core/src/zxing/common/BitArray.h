@@ -57,6 +57,15 @@ public:
     bits_[i >> logBits_] |= 1 << (i & bitsMask_);
   }
 
+  // The first set or unset bit at or after from; getSize() if there is
+  // none. Whole words of the other value are skipped at once.
+  size_t getNextSet(size_t from);
+  size_t getNextUnset(size_t from);
+
+  // The widths of the runs of equal bits, first unset, then set, and so on;
+  // the first width is 0 if the array starts with a set bit.
+  void toRunLengths(std::vector<int>& runs);
+
   void setBulk(size_t i, unsigned int newBits);
   void setRange(int start, int end);
   void clear();
@@ -18,6 +18,7 @@
 #include <zxing/common/BitMatrix.h>
 #include <zxing/common/IllegalArgumentException.h>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -32,39 +33,216 @@ using zxing::Ref;
 namespace {
   size_t wordsForSize(size_t width,
                       size_t height,
-                      unsigned int bitsPerWord,
                       unsigned int logBits) {
-    size_t bits = width * height;
-    int arraySize = (bits + bitsPerWord - 1) >> logBits;
-    return arraySize;
+    return (BitMatrix::getRowStride(width) >> logBits) * height;
+  }
+
+  // Bits [0, count) of a word, for 0 < count <= 32.
+  unsigned int lowMask(size_t count) {
+    return count >= 32 ? 0xFFFFFFFF : (1u << count) - 1;
+  }
+
+  // Sets or clears count bits from bit offset on, a word at a time.
+  void fillBits(unsigned int* bits, size_t offset, size_t count, bool value) {
+    size_t end = offset + count;
+    while (offset < end) {
+      unsigned int shift = offset & 31;
+      size_t n = end - offset < 32 - shift ? end - offset : 32 - shift;
+      unsigned int mask = lowMask(n) << shift;
+      if (value) {
+        bits[offset >> 5] |= mask;
+      } else {
+        bits[offset >> 5] &= ~mask;
+      }
+      offset += n;
+    }
+  }
+
+  // Word j of the width bits from bit start on, with the bits past width
+  // clear. Only the words holding those bits are read, so a view's last
+  // row never reads past its parent's words.
+  unsigned int loadWord(unsigned int const* bits, size_t start, size_t width, size_t j) {
+    size_t offset = start + (j << 5);
+    size_t remaining = width - (j << 5);
+    unsigned int shift = offset & 31;
+    unsigned int value = bits[offset >> 5] >> shift;
+    if (shift != 0 && remaining > 32 - shift) {
+      value |= bits[(offset >> 5) + 1] << (32 - shift);
+    }
+    return value & lowMask(remaining);
+  }
+
+  // Word k of the width bits from bit start on as a 64 bit word, low half
+  // first, with the bits past width clear.
+  uint64_t loadWord64(unsigned int const* bits, size_t start, size_t width, size_t k) {
+    uint64_t low = loadWord(bits, start, width, 2 * k);
+    uint64_t high = (2 * k + 1) << 5 < width ? loadWord(bits, start, width, 2 * k + 1) : 0;
+    return low | (high << 32);
+  }
+
+  // Stores word j of the width bits from bit start on, leaving every bit
+  // outside them alone.
+  void storeWord(unsigned int* bits, size_t start, size_t width, size_t j, unsigned int value) {
+    size_t offset = start + (j << 5);
+    size_t remaining = width - (j << 5);
+    unsigned int mask = lowMask(remaining);
+    unsigned int shift = offset & 31;
+    size_t word = offset >> 5;
+    value &= mask;
+    bits[word] = (bits[word] & ~(mask << shift)) | (value << shift);
+    if (shift != 0 && remaining > 32 - shift) {
+      unsigned int spill = 32 - shift;
+      bits[word + 1] = (bits[word + 1] & ~(mask >> spill)) | (value >> spill);
+    }
+  }
+
+  /**
+   * Transposes a 64 x 64 block kept as 64 words, bit j of word i being
+   * (j, i), by swapping ever smaller blocks across the diagonal: the two
+   * off-diagonal 32 x 32 blocks first, then the 16 x 16 ones inside each
+   * quarter, and so on down to single bits. Each of the six rounds is 32
+   * masked word swaps.
+   */
+  void transpose64(uint64_t* block) {
+    uint64_t mask = (uint64_t)0xFFFFFFFFu;
+    for (size_t j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+      for (size_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+        uint64_t swapped = ((block[k] >> j) ^ block[k | j]) & mask;
+        block[k] ^= swapped << j;
+        block[k | j] ^= swapped;
+      }
+    }
+  }
+
+  // The index of the lowest set bit of a word that is not 0.
+  size_t countTrailingZeros(uint64_t word) {
+#ifdef __GNUC__
+    return __builtin_ctzll(word);
+#else
+    size_t count = 0;
+    while ((word & 1) == 0) {
+      word >>= 1;
+      count++;
+    }
+    return count;
+#endif
+  }
+
+  // The index of the highest set bit of a word that is not 0.
+  size_t highestSetBit(uint64_t word) {
+#ifdef __GNUC__
+    return 63 - __builtin_clzll(word);
+#else
+    size_t index = 63;
+    while ((word >> 63) == 0) {
+      word <<= 1;
+      index--;
+    }
+    return index;
+#endif
+  }
+
+  /**
+   * The first x in (from, end) whose bit differs from bit from, or end.
+   * Whole words of the run's color are stepped over, and the first bit of
+   * another color found in a word by counting its trailing zeros. Words is
+   * anything indexed by word, and only the words up to end are read.
+   */
+  template<typename Words> size_t findRunEnd(Words const& words, size_t from, size_t end) {
+    size_t k = from >> 6;
+    uint64_t word = words[k];
+    uint64_t color = ((word >> (from & 63)) & 1) != 0 ? ~(uint64_t)0 : 0;
+    uint64_t current = (word ^ color) & (~(uint64_t)0 << (from & 63));
+    while (current == 0) {
+      if (++k << 6 >= end) {
+        return end;
+      }
+      current = words[k] ^ color;
+    }
+    size_t x = (k << 6) + countTrailingZeros(current);
+    return x < end ? x : end;
+  }
+
+  // The first x in [begin, from] from which every bit up to from is bit
+  // from, reading down to the word holding begin.
+  template<typename Words> size_t findRunStart(Words const& words, size_t from, size_t begin) {
+    size_t k = from >> 6;
+    uint64_t word = words[k];
+    uint64_t color = ((word >> (from & 63)) & 1) != 0 ? ~(uint64_t)0 : 0;
+    uint64_t current = (word ^ color) & (~(uint64_t)0 >> (63 - (from & 63)));
+    while (current == 0) {
+      if (k << 6 <= begin) {
+        return begin;
+      }
+      current = words[--k] ^ color;
+    }
+    size_t x = (k << 6) + highestSetBit(current) + 1;
+    return x > begin ? x : begin;
   }
 }
 
 BitMatrix::BitMatrix(size_t dimension) :
-  width_(dimension), height_(dimension), words_(0), bits_(NULL) {
-  words_ = wordsForSize(width_, height_, bitsPerWord, logBits);
+  width_(dimension), height_(dimension), words_(0), bits_(NULL),
+  left_(0), top_(0), origin_(0), rowStride_(getRowStride(dimension)),
+  columnCopy_(false), columnWords_((dimension + 63) >> 6),
+  lazy_(false), tilesWide_(0), tilesHigh_(0), tilesFilled_(0) {
+  words_ = wordsForSize(width_, height_, logBits);
   bits_ = new unsigned int[words_];
   clear();
 }
 
 BitMatrix::BitMatrix(size_t width, size_t height) :
-  width_(width), height_(height), words_(0), bits_(NULL) {
-  words_ = wordsForSize(width_, height_, bitsPerWord, logBits);
+  width_(width), height_(height), words_(0), bits_(NULL),
+  left_(0), top_(0), origin_(0), rowStride_(getRowStride(width)),
+  columnCopy_(false), columnWords_((height + 63) >> 6),
+  lazy_(false), tilesWide_(0), tilesHigh_(0), tilesFilled_(0) {
+  words_ = wordsForSize(width_, height_, logBits);
   bits_ = new unsigned int[words_];
   clear();
 }
 
+BitMatrix::BitMatrix(Ref<BitMatrix> parent, size_t left, size_t top,
+                     size_t width, size_t height) :
+  width_(width), height_(height), words_(parent->words_), bits_(parent->bits_),
+  parent_(parent), left_(left), top_(top),
+  origin_(parent->origin_ + top * parent->rowStride_ + left), rowStride_(parent->rowStride_),
+  columnCopy_(false), columnWords_(0),
+  lazy_(parent->lazy_), tilesWide_(0), tilesHigh_(0), tilesFilled_(0) {
+}
+
 BitMatrix::~BitMatrix() {
-  delete[] bits_;
+  if (parent_.empty()) {
+    delete[] bits_;
+  }
 }
 
 
 void BitMatrix::flip(size_t x, size_t y) {
-  size_t offset = x + width_ * y;
+  dropColumns();
+  if (lazy_) {
+    fillAllTiles();
+  }
+  size_t offset = origin_ + x + rowStride_ * y;
   bits_[offset >> logBits] ^= 1 << (offset & bitsMask);
 }
 
 void BitMatrix::clear() {
+  dropColumns();
+  if (!parent_.empty()) {
+    // Only this view's bits are cleared, so the rest must be filled first.
+    if (lazy_) {
+      fillAllTiles();
+    }
+    for (size_t y = 0; y < height_; y++) {
+      fillBits(bits_, origin_ + rowStride_ * y, width_, false);
+    }
+    return;
+  }
+  if (lazy_) {
+    // Nothing left to fill in a cleared matrix.
+    lazy_ = false;
+    tileSource_ = NULL;
+  }
   std::fill(bits_, bits_+words_, 0);
 }
 
@@ -80,46 +258,193 @@ void BitMatrix::setRegion(size_t left, size_t top, size_t width, size_t height)
   if (right > width_ || bottom > height_) {
     throw IllegalArgumentException("top + height and left + width must be <= matrix dimension");
   }
+  dropColumns();
+  if (lazy_) {
+    fillAllTiles();
+  }
   for (size_t y = top; y < bottom; y++) {
-    int yOffset = width_ * y;
-    for (size_t x = left; x < right; x++) {
-      size_t offset = x + yOffset;
-      bits_[offset >> logBits] |= 1 << (offset & bitsMask);
-    }
+    fillBits(bits_, origin_ + rowStride_ * y + left, width, true);
   }
 }
 
 Ref<BitArray> BitMatrix::getRow(int y, Ref<BitArray> row) {
+  if (lazy_) {
+    fillAllTiles();
+  }
   if (row.empty() || row->getSize() < width_) {
     row = new BitArray(width_);
   } else {
     row->clear();
   }
-  size_t start = y * width_;
-  size_t end = start + width_ - 1; // end is inclusive
-  size_t firstWord = start >> logBits;
-  size_t lastWord = end >> logBits;
-  size_t bitOffset = start & bitsMask;
-  for (size_t i = firstWord; i <= lastWord; i++) {
-    size_t firstBit = i > firstWord ? 0 : start & bitsMask;
-    size_t lastBit = i < lastWord ? bitsPerWord - 1 : end & bitsMask;
-    unsigned int mask;
-    if (firstBit == 0 && lastBit == logBits) {
-      mask = std::numeric_limits<unsigned int>::max();
-    } else {
-      mask = 0;
-      for (size_t j = firstBit; j <= lastBit; j++) {
-        mask |= 1 << j;
-      }
+  std::vector<unsigned int>& rowBits = row->getBitArray();
+  size_t start = origin_ + y * rowStride_;
+  for (size_t j = 0; j << logBits < width_; j++) {
+    rowBits[j] = loadWord(bits_, start, width_, j);
+  }
+  return row;
+}
+
+void BitMatrix::setRow(int y, Ref<BitArray> row) {
+  if (row->getSize() < width_) {
+    throw IllegalArgumentException("row is narrower than the matrix");
+  }
+  dropColumns();
+  if (lazy_) {
+    fillAllTiles();
+  }
+  std::vector<unsigned int>& rowBits = row->getBitArray();
+  size_t start = origin_ + y * rowStride_;
+  for (size_t j = 0; j << logBits < width_; j++) {
+    storeWord(bits_, start, width_, j, rowBits[j]);
+  }
+}
+
+size_t BitMatrix::getRowWordCount() const {
+  return (width_ + 63) >> 6;
+}
+
+/**
+ * The words are built from the 32 bit words the matrix is kept in, low
+ * half first, so the bit order is the same on any byte order.
+ */
+void BitMatrix::getRowWords(int y, uint64_t* words) const {
+  if (lazy_) {
+    fillRowTiles(y);
+  }
+  size_t start = origin_ + y * rowStride_;
+  size_t count = getRowWordCount();
+  for (size_t k = 0; k < count; k++) {
+    words[k] = loadWord64(bits_, start, width_, k);
+  }
+}
+
+size_t BitMatrix::getRunEnd(uint64_t const* words, size_t from, size_t end) {
+  return findRunEnd(words, from, end);
+}
+
+size_t BitMatrix::getRunStart(uint64_t const* words, size_t from, size_t begin) {
+  return findRunStart(words, from, begin);
+}
+
+// Column x's words, for findRunEnd and findRunStart.
+struct BitMatrix::ColumnWords {
+  BitMatrix const& matrix_;
+  size_t x_;
+
+  ColumnWords(BitMatrix const& matrix, size_t x) : matrix_(matrix), x_(x) {
+  }
+  uint64_t operator[](size_t k) const {
+    return matrix_.getColumnWord(x_, k);
+  }
+};
+
+int BitMatrix::getColumnRunDown(size_t x, int y, int end, bool black, int limit) const {
+  return getColumnRun(x, y, 0, end, black, limit, true);
+}
+
+int BitMatrix::getColumnRunUp(size_t x, int y, bool black, int limit) const {
+  return getColumnRun(x, y, 0, height_, black, limit, false);
+}
+
+/**
+ * A view reads its parent's columns, shifted down by its top, so there is
+ * only ever one copy of a column. With the copy, the run is looked for no
+ * further than limit pixels away, so no block past that is transposed.
+ */
+int BitMatrix::getColumnRun(size_t x, int y, int begin, int end, bool black, int limit,
+                            bool down) const {
+  if (y < begin || y >= end || limit <= 0) {
+    return 0;
+  }
+  if (!parent_.empty()) {
+    return parent_->getColumnRun(left_ + x, top_ + y, top_ + begin, top_ + end, black, limit,
+                                 down);
+  }
+  if (!columnCopy_) {
+    int step = down ? 1 : -1;
+    int run = 0;
+    for (int i = y; i >= begin && i < end && run < limit && get(x, i) == black; i += step) {
+      run++;
+    }
+    return run;
+  }
+  ColumnWords words(*this, x);
+  if ((((words[y >> 6] >> (y & 63)) & 1) != 0) != black) {
+    return 0;
+  }
+  if (down) {
+    return (int)findRunEnd(words, y, std::min(end, y + limit)) - y;
+  }
+  return y + 1 - (int)findRunStart(words, y, std::max(begin, y + 1 - limit));
+}
+
+void BitMatrix::setColumnCopy(bool enabled) {
+  if (!parent_.empty()) {
+    parent_->setColumnCopy(enabled);
+    return;
+  }
+  columnCopy_ = enabled;
+  if (!enabled) {
+    dropColumns();
+  }
+}
+
+/**
+ * A block is cut out of the 64 rows it covers and turned into 64 bits of
+ * each of its 64 columns by transpose64.
+ */
+uint64_t BitMatrix::getColumnWord(size_t x, size_t k) const {
+  size_t band = x >> 6;
+  if (columnBlocks_.empty()) {
+    columnBands_.resize(getRowWordCount());
+    columnBlocks_.assign(getRowWordCount() * columnWords_, 0);
+  }
+  std::vector<uint64_t>& words = columnBands_[band];
+  if (!columnBlocks_[band * columnWords_ + k]) {
+    size_t top = k << 6;
+    size_t bottom = std::min(top + 64, height_);
+    if (lazy_) {
+      fillTilesIn(band << 6, top, std::min((band + 1) << 6, width_), bottom);
+    }
+    if (words.empty()) {
+      words.resize(64 * columnWords_);
+    }
+    uint64_t block[64];
+    for (size_t i = 0; i < 64; i++) {
+      size_t start = origin_ + (top + i) * rowStride_;
+      block[i] = top + i < bottom ? loadWord64(bits_, start, width_, band) : 0;
     }
-    row->setBulk((i - firstWord) << logBits, (bits_[i] & mask) >> bitOffset);
-    if (firstBit == 0 && bitOffset != 0) {
-      unsigned int prevBulk = row->getBitArray()[i - firstWord - 1];
-      prevBulk |= (bits_[i] & mask) << (bitsPerWord - bitOffset);
-      row->setBulk((i - firstWord - 1) << logBits, prevBulk);
+    transpose64(block);
+    for (size_t j = 0; j < 64; j++) {
+      words[j * columnWords_ + k] = block[j];
+    }
+    columnBlocks_[band * columnWords_ + k] = 1;
+  }
+  return words[(x & 63) * columnWords_ + k];
+}
+
+void BitMatrix::dropColumns() const {
+  if (!parent_.empty()) {
+    parent_->dropColumns();
+  } else {
+    columnBands_.clear();
+    columnBlocks_.clear();
+  }
+}
+
+void BitMatrix::setRowWords(int y, uint64_t const* words) {
+  dropColumns();
+  if (lazy_) {
+    fillAllTiles();
+  }
+  size_t start = origin_ + y * rowStride_;
+  size_t count = getRowWordCount();
+  for (size_t k = 0; k < count; k++) {
+    storeWord(bits_, start, width_, 2 * k, (unsigned int)words[k]);
+    if ((2 * k + 1) << logBits < width_) {
+      storeWord(bits_, start, width_, 2 * k + 1, (unsigned int)(words[k] >> 32));
     }
   }
-  return row;
 }
 
 size_t BitMatrix::getWidth() const {
@@ -134,10 +459,166 @@ size_t BitMatrix::getDimension() const {
   return width_;
 }
 
+Ref<BitMatrix> BitMatrix::crop(size_t left, size_t top, size_t width, size_t height) {
+  if (width < 1 || height < 1) {
+    throw IllegalArgumentException("height and width must be at least 1");
+  }
+  if (left + width > width_ || top + height > height_) {
+    throw IllegalArgumentException("top + height and left + width must be <= matrix dimension");
+  }
+  if (!parent_.empty()) {
+    return parent_->crop(left_ + left, top_ + top, width, height);
+  }
+  return Ref<BitMatrix>(new BitMatrix(Ref<BitMatrix>(this), left, top, width, height));
+}
+
+bool BitMatrix::isView() const {
+  return !parent_.empty();
+}
+
+/**
+ * Each band of 64 rows is read as words and cut into 64 x 64 blocks. Once
+ * transposed, block j of band k holds columns 64j to 64j + 63 as 64 bit
+ * runs of rotated rows width - 1 - 64j on down, each of which is word k of
+ * its rotated row. Bits past this matrix's width or height are read as
+ * clear, so the rotated matrix's padding stays clear.
+ */
+Ref<BitMatrix> BitMatrix::rotateCounterClockwise() const {
+  Ref<BitMatrix> rotated(new BitMatrix(height_, width_));
+  size_t rowWords = getRowWordCount();
+  size_t rotatedStride = rotated->rowStride_ >> logBits;
+  std::vector<uint64_t> band(rowWords * 64);
+  uint64_t block[64];
+  for (size_t top = 0, k = 0; top < height_; top += 64, k++) {
+    size_t rows = std::min(height_ - top, (size_t)64);
+    for (size_t i = 0; i < rows; i++) {
+      getRowWords((int)(top + i), &band[i * rowWords]);
+    }
+    for (size_t j = 0; j < rowWords; j++) {
+      for (size_t i = 0; i < 64; i++) {
+        block[i] = i < rows ? band[i * rowWords + j] : 0;
+      }
+      transpose64(block);
+      size_t columns = std::min(width_ - (j << 6), (size_t)64);
+      for (size_t i = 0; i < columns; i++) {
+        size_t y = width_ - 1 - ((j << 6) + i);
+        unsigned int* words = rotated->bits_ + y * rotatedStride + 2 * k;
+        words[0] = (unsigned int)block[i];
+        words[1] = (unsigned int)(block[i] >> 32);
+      }
+    }
+  }
+  return rotated;
+}
+
 unsigned int* BitMatrix::getBits() const {
+  dropColumns();
+  if (lazy_) {
+    fillAllTiles();
+  }
   return bits_;
 }
 
+size_t BitMatrix::getOrigin() const {
+  return origin_;
+}
+
+size_t BitMatrix::getRowStride() const {
+  return rowStride_;
+}
+
+size_t BitMatrix::getRowStride(size_t width) {
+  return (width + 63) & ~(size_t)63;
+}
+
+void BitMatrix::setTileSource(Ref<TileSource> source) {
+  if (!parent_.empty()) {
+    throw IllegalArgumentException("a view cannot be filled lazily");
+  }
+  dropColumns();
+  tilesWide_ = width_ >> TILE_SIZE_POWER;
+  if (tilesWide_ == 0) {
+    tilesWide_ = 1;
+  }
+  tilesHigh_ = height_ >> TILE_SIZE_POWER;
+  if (tilesHigh_ == 0) {
+    tilesHigh_ = 1;
+  }
+  tileFilled_.assign(tilesWide_ * tilesHigh_, 0);
+  tilesFilled_ = 0;
+  tileSource_ = source;
+  lazy_ = true;
+}
+
+size_t BitMatrix::getTileCount() const {
+  return tilesWide_ * tilesHigh_;
+}
+
+size_t BitMatrix::getTilesFilled() const {
+  return tilesFilled_;
+}
+
+void BitMatrix::fillTile(size_t tileX, size_t tileY) const {
+  size_t index = tileY * tilesWide_ + tileX;
+  if (tileFilled_[index]) {
+    return;
+  }
+  int left = tileX << TILE_SIZE_POWER;
+  int top = tileY << TILE_SIZE_POWER;
+  int right = tileX == tilesWide_ - 1 ? width_ : left + TILE_SIZE;
+  int bottom = tileY == tilesHigh_ - 1 ? height_ : top + TILE_SIZE;
+  tileSource_->fillTile(bits_, rowStride_, left, top, right, bottom);
+  tileFilled_[index] = 1;
+  if (++tilesFilled_ == tileFilled_.size()) {
+    // Let go of the binarizer's state as soon as it is no longer needed.
+    lazy_ = false;
+    tileSource_ = NULL;
+  }
+}
+
+void BitMatrix::fillAllTiles() const {
+  if (!parent_.empty()) {
+    parent_->fillTilesIn(left_, top_, left_ + width_, top_ + height_);
+    lazy_ = false;
+    return;
+  }
+  fillTilesIn(0, 0, width_, height_);
+}
+
+void BitMatrix::fillTilesIn(size_t left, size_t top, size_t right, size_t bottom) const {
+  if (!lazy_) {
+    return;
+  }
+  size_t lastX = std::min((right - 1) >> TILE_SIZE_POWER, tilesWide_ - 1);
+  size_t lastY = std::min((bottom - 1) >> TILE_SIZE_POWER, tilesHigh_ - 1);
+  for (size_t tileY = std::min(top >> TILE_SIZE_POWER, lastY); tileY <= lastY && lazy_; tileY++) {
+    for (size_t tileX = std::min(left >> TILE_SIZE_POWER, lastX); tileX <= lastX && lazy_; tileX++) {
+      fillTile(tileX, tileY);
+    }
+  }
+}
+
+void BitMatrix::fillRowTiles(size_t y) const {
+  if (!parent_.empty()) {
+    if (parent_->lazy_) {
+      parent_->fillTilesIn(left_, top_ + y, left_ + width_, top_ + y + 1);
+    } else {
+      lazy_ = false;
+    }
+    return;
+  }
+  fillTilesIn(0, y, width_, y + 1);
+}
+
+void BitMatrix::fillParentTileAt(size_t x, size_t y) const {
+  if (parent_->lazy_) {
+    parent_->fillTileAt(left_ + x, top_ + y);
+  } else {
+    // The parent is complete, so this view never needs to fill again.
+    lazy_ = false;
+  }
+}
+
 namespace zxing {
   ostream& operator<<(ostream &out, const BitMatrix &bm) {
     for (size_t y = 0; y < bm.height_; y++) {
@@ -24,16 +24,65 @@
 #include <zxing/common/Counted.h>
 #include <zxing/common/BitArray.h>
 #include <limits>
+#include <vector>
+#include <stdint.h>
 
 namespace zxing {
 
 class BitMatrix : public Counted {
+public:
+  /**
+   * Binarizes a lazily filled matrix one tile at a time. See setTileSource.
+   */
+  class TileSource : public Counted {
+  public:
+    virtual ~TileSource() {}
+    // Sets the black pixels in columns [left, right) and rows [top, bottom)
+    // of the matrix whose bits are given, leaving all other bits alone.
+    // Pixel (x, y) is bit y * rowStride + x.
+    virtual void fillTile(unsigned int* bits, size_t rowStride,
+                          int left, int top, int right, int bottom) = 0;
+  };
+
+  static const int TILE_SIZE_POWER = 6;
+  static const int TILE_SIZE = 1 << TILE_SIZE_POWER;
+
 private:
   size_t width_;
   size_t height_;
   size_t words_;
   unsigned int* bits_;
 
+  // Bit (x, y) lives at bit origin_ + y * rowStride_ + x of bits_. Rows
+  // are padded to a multiple of 64 bits, so every row of a matrix starts
+  // on a 64 bit boundary; a view made by crop() shares its parent's words
+  // and stride, and its origin need not be aligned.
+  Ref<BitMatrix> parent_;
+  size_t left_;
+  size_t top_;
+  size_t origin_;
+  size_t rowStride_;
+
+  // The transposed copy getColumnRunDown and getColumnRunUp read, in bands
+  // of 64 columns, word k of column x being word (x & 63) * columnWords_ + k
+  // of band x >> 6. A band is empty until first read, and block k of it,
+  // word k of each of its columns, is transposed the first time it is read,
+  // as columnBlocks_ records. The copy is kept by the matrix that owns the
+  // bits, and dropped when they change.
+  struct ColumnWords;
+  bool columnCopy_;
+  mutable std::vector<std::vector<uint64_t> > columnBands_;
+  mutable std::vector<unsigned char> columnBlocks_;
+  size_t columnWords_;
+
+  // Lazy filling state, only used between setTileSource and the last tile.
+  mutable bool lazy_;
+  mutable Ref<TileSource> tileSource_;
+  mutable std::vector<unsigned char> tileFilled_;
+  size_t tilesWide_;
+  size_t tilesHigh_;
+  mutable size_t tilesFilled_;
+
 #define ZX_LOG_DIGITS(digits) \
     ((digits == 8) ? 3 : \
      ((digits == 16) ? 4 : \
@@ -54,12 +103,21 @@ public:
   ~BitMatrix();
 
   bool get(size_t x, size_t y) const {
-    size_t offset = x + width_ * y;
+    if (lazy_) {
+      fillTileAt(x, y);
+    }
+    size_t offset = origin_ + x + rowStride_ * y;
     return ((bits_[offset >> logBits] >> (offset & bitsMask)) & 0x01) != 0;
   }
 
   void set(size_t x, size_t y) {
-    size_t offset = x + width_ * y;
+    if (lazy_) {
+      fillAllTiles();
+    }
+    if (!parent_.empty() || !columnBlocks_.empty()) {
+      dropColumns();
+    }
+    size_t offset = origin_ + x + rowStride_ * y;
     bits_[offset >> logBits] |= 1 << (offset & bitsMask);
   }
 
@@ -67,17 +125,115 @@ public:
   void clear();
   void setRegion(size_t left, size_t top, size_t width, size_t height);
   Ref<BitArray> getRow(int y, Ref<BitArray> row);
+  // Replaces row y with the first getWidth() bits of row.
+  void setRow(int y, Ref<BitArray> row);
+
+  // The 64 bit words a row takes: bit x of the row is bit x & 63 of word
+  // x >> 6. getRowWords writes getRowWordCount() words, with the bits past
+  // the width clear, and fills only the tiles of a lazy matrix that the
+  // row crosses; setRowWords ignores those bits.
+  size_t getRowWordCount() const;
+  void getRowWords(int y, uint64_t* words) const;
+  void setRowWords(int y, uint64_t const* words);
+  // The first x in (from, end) of a row in getRowWords form whose bit
+  // differs from bit from, or end if the run of bit from lasts that far.
+  static size_t getRunEnd(uint64_t const* words, size_t from, size_t end);
+  // The first x in [begin, from] from which every bit up to from is bit
+  // from.
+  static size_t getRunStart(uint64_t const* words, size_t from, size_t begin);
+
+  /**
+   * How many pixels of column x, from row y on down and stopping before
+   * row end, or from row y on up, are black if black is set and white if
+   * not; no more than limit are counted.
+   */
+  int getColumnRunDown(size_t x, int y, int end, bool black, int limit) const;
+  int getColumnRunUp(size_t x, int y, bool black, int limit) const;
+
+  /**
+   * Makes getColumnRunDown and getColumnRunUp read from a copy of the
+   * matrix transposed a 64 x 64 block at a time, as runs reach the blocks,
+   * so a walk down a column reads a word per 64 pixels rather than a pixel
+   * from every row. Each block costs a read of its 64 rows the first time,
+   * which only pays off where many long vertical runs are read in the same
+   * place, so the copy is off unless asked for, as the QR Code detector
+   * does with DecodeHints::setColumnCopy. A view shares its parent's copy
+   * and setting.
+   */
+  void setColumnCopy(bool enabled);
 
   size_t getDimension() const;
   size_t getWidth() const;
   size_t getHeight() const;
 
+  /**
+   * Returns a width x height view of this matrix starting at (left, top).
+   * The view shares this matrix's bits rather than copying them: changes
+   * through either show in both, and a lazy matrix is only filled as the
+   * view reads it.
+   */
+  Ref<BitMatrix> crop(size_t left, size_t top, size_t width, size_t height);
+  bool isView() const;
+
+  /**
+   * Returns a new getHeight() x getWidth() matrix holding this one rotated
+   * counter-clockwise, the way LuminanceSource::rotateCounterClockwise
+   * rotates: pixel (x, y) of the result is (getWidth() - 1 - y, x) of this
+   * matrix. The bits are moved 64 x 64 at a time by a word transpose.
+   */
+  Ref<BitMatrix> rotateCounterClockwise() const;
+
+  // The words holding the matrix, with bit (x, y) at getOrigin() +
+  // y * getRowStride() + x. For a matrix that is not a view, the origin is
+  // 0 and the stride is getRowStride(getWidth()), and the padding at the
+  // end of each row is clear. As they may be written through, the columns
+  // copied for getColumnRunDown are dropped.
   unsigned int* getBits() const;
+  size_t getOrigin() const;
+  size_t getRowStride() const;
+  // The bits per row of a matrix width pixels wide.
+  static size_t getRowStride(size_t width);
+
+  /**
+   * Makes the matrix fill itself lazily: the first get() in a tile of
+   * TILE_SIZE x TILE_SIZE pixels asks source to fill that tile. The last
+   * tile in each direction also takes the remainder, so no tile is smaller
+   * than TILE_SIZE unless the matrix is. Everything else, including
+   * getBits() and getRow(), fills all remaining tiles first. The matrix
+   * must be clear and must not be a view. Reading a lazy matrix from
+   * several threads at once is not safe.
+   */
+  void setTileSource(Ref<TileSource> source);
+  size_t getTileCount() const;
+  size_t getTilesFilled() const;
 
   friend std::ostream& operator<<(std::ostream &out, const BitMatrix &bm);
   const char *description();
 
 private:
+  void fillTileAt(size_t x, size_t y) const {
+    if (!parent_.empty()) {
+      fillParentTileAt(x, y);
+      return;
+    }
+    size_t tileX = x >> TILE_SIZE_POWER;
+    size_t tileY = y >> TILE_SIZE_POWER;
+    tileX = tileX < tilesWide_ ? tileX : tilesWide_ - 1;
+    tileY = tileY < tilesHigh_ ? tileY : tilesHigh_ - 1;
+    if (!tileFilled_[tileY * tilesWide_ + tileX]) {
+      fillTile(tileX, tileY);
+    }
+  }
+  void fillTile(size_t tileX, size_t tileY) const;
+  void fillAllTiles() const;
+  void fillParentTileAt(size_t x, size_t y) const;
+  void fillRowTiles(size_t y) const;
+  uint64_t getColumnWord(size_t x, size_t k) const;
+  int getColumnRun(size_t x, int y, int begin, int end, bool black, int limit, bool down) const;
+  void dropColumns() const;
+  void fillTilesIn(size_t left, size_t top, size_t right, size_t bottom) const;
+
+  BitMatrix(Ref<BitMatrix> parent, size_t left, size_t top, size_t width, size_t height);
   BitMatrix(const BitMatrix&);
   BitMatrix& operator =(const BitMatrix&);
 };
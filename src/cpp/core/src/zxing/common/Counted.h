@@ -20,8 +20,16 @@
 
 //#define DEBUG_COUNTING
 
+// Define ATOMIC_COUNTING to count references with atomic operations, so
+// that objects can be retained and released from several threads at once.
+//#define ATOMIC_COUNTING
+
 #include <iostream>
 
+#if defined(ATOMIC_COUNTING) && !defined(__GNUC__)
+#error "ATOMIC_COUNTING needs the GCC __atomic builtins"
+#endif
+
 #ifdef DEBUG_COUNTING
 #include <typeinfo>
 #endif
@@ -32,7 +40,20 @@ namespace zxing {
 class Counted {
 private:
   unsigned int count_;
+
+  unsigned int loadCount() const {
+#ifdef ATOMIC_COUNTING
+    return __atomic_load_n(&count_, __ATOMIC_RELAXED);
+#else
+    return count_;
+#endif
+  }
+
 public:
+  // The count of an immortal object, which retain() and release() leave
+  // alone.
+  static const unsigned int IMMORTAL = 0xFFFFFFFF;
+
   Counted() :
       count_(0) {
 #ifdef DEBUG_COUNTING
@@ -47,7 +68,14 @@ public:
     cout << "retaining " << typeid(*this).name() << " " << this <<
          " @ " << count_;
 #endif
+    if (loadCount() == IMMORTAL) {
+      return this;
+    }
+#ifdef ATOMIC_COUNTING
+    __atomic_add_fetch(&count_, 1, __ATOMIC_RELAXED);
+#else
     count_++;
+#endif
 #ifdef DEBUG_COUNTING
     cout << "->" << count_ << "\n";
 #endif
@@ -58,17 +86,27 @@ public:
     cout << "releasing " << typeid(*this).name() << " " << this <<
          " @ " << count_;
 #endif
-    if (count_ == 0 || count_ == 54321) {
+    unsigned int count = loadCount();
+    if (count == IMMORTAL) {
+      return;
+    }
+    if (count == 0 || count == 54321) {
 #ifdef DEBUG_COUNTING
       cout << "\nOverreleasing already-deleted object " << this << "!!!\n";
 #endif
       throw 4711;
     }
-    count_--;
+    // The last release must see every other thread's writes to the object
+    // before it deletes it.
+#ifdef ATOMIC_COUNTING
+    count = __atomic_sub_fetch(&count_, 1, __ATOMIC_ACQ_REL);
+#else
+    count = --count_;
+#endif
 #ifdef DEBUG_COUNTING
-    cout << "->" << count_ << "\n";
+    cout << "->" << count << "\n";
 #endif
-    if (count_ == 0) {
+    if (count == 0) {
 #ifdef DEBUG_COUNTING
       cout << "deleting " << typeid(*this).name() << " " << this << "\n";
 #endif
@@ -78,9 +116,16 @@ public:
   }
 
 
+  /* Keeps the object for good, whatever its count, and stops counting
+     references to it. For tables built once at start-up and then shared
+     by every thread, which would otherwise all write to the count. */
+  void makeImmortal() {
+    count_ = IMMORTAL;
+  }
+
   /* return the current count for denugging purposes or similar */
   int count() const {
-    return count_;
+    return loadCount();
   }
 };
 
@@ -122,6 +167,18 @@ public:
     reset(other.object_);
   }
 
+#if __cplusplus >= 201103L
+  /* takes over other's reference, leaving other empty, so that returning
+     and sorting Refs does not touch the count */
+  Ref(Ref &&other) noexcept :
+      object_(other.object_) {
+#ifdef DEBUG_COUNTING
+    cout << "instantiating Ref " << this << " by moving Ref " << &other << "\n";
+#endif
+    other.object_ = 0;
+  }
+#endif
+
   ~Ref() {
 #ifdef DEBUG_COUNTING
     cout << "destroying Ref " << this << " with " <<
@@ -150,6 +207,19 @@ public:
     reset(other.object_);
     return *this;
   }
+#if __cplusplus >= 201103L
+  Ref& operator=(Ref &&other) noexcept {
+    if (this != &other) {
+      T *o = other.object_;
+      other.object_ = 0;
+      if (object_ != 0) {
+        object_->release();
+      }
+      object_ = o;
+    }
+    return *this;
+  }
+#endif
   template<class Y>
   Ref& operator=(const Ref<Y> &other) {
     reset(other.object_);
@@ -194,9 +264,22 @@ public:
     return object_ == 0;
   }
 
+  /* exchanges the two references without touching either count; where
+     there is no moving, this is how to hand a reference on for free */
+  void swap(Ref &other) {
+    T *o = object_;
+    object_ = other.object_;
+    other.object_ = o;
+  }
+
   template<class Y>
   friend std::ostream& operator<<(std::ostream &out, Ref<Y>& ref);
 };
+
+/* found by std::sort and the like through argument dependent lookup */
+template<typename T> void swap(Ref<T> &a, Ref<T> &b) {
+  a.swap(b);
+}
 }
 
 #endif // __COUNTED_H__
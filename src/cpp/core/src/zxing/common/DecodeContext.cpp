@@ -0,0 +1,187 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  DecodeContext.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/DecodeContext.h>
+#include <zxing/common/Counted.h>
+
+namespace zxing {
+
+/**
+ * Every block, from a chunk or the heap, starts with a header holding its
+ * chunk, or null for the heap, so deallocate() knows where it came from.
+ * The header is as big as the alignment new promises, 16 bytes, and so are
+ * the steps the chunk's space is handed out in.
+ */
+struct DecodeContext::Chunk {
+  // The blocks handed out and not yet deleted, plus one while the chunk is
+  // its context's.
+  unsigned int live;
+  size_t used;
+};
+
+namespace {
+  const size_t ALIGNMENT = 16;
+  const size_t HEADER_SIZE = ALIGNMENT;
+
+  // Each thread's context, if it has a Scope open.
+#ifdef __GNUC__
+  __thread DecodeContext* current = 0;
+#else
+  DecodeContext* current = 0;
+#endif
+
+  size_t align(size_t size) {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  void* withHeader(void* block, void* chunk) {
+    *(void**)block = chunk;
+    return (char*)block + HEADER_SIZE;
+  }
+
+  // A chunk's blocks may be deleted on several threads when the objects in
+  // them are counted atomically.
+  void retainCount(unsigned int* live) {
+#ifdef ATOMIC_COUNTING
+    __atomic_add_fetch(live, 1, __ATOMIC_RELAXED);
+#else
+    ++*live;
+#endif
+  }
+
+  unsigned int releaseCount(unsigned int* live) {
+#ifdef ATOMIC_COUNTING
+    return __atomic_sub_fetch(live, 1, __ATOMIC_ACQ_REL);
+#else
+    return --*live;
+#endif
+  }
+
+  unsigned int loadCount(unsigned int const* live) {
+#ifdef ATOMIC_COUNTING
+    return __atomic_load_n(live, __ATOMIC_ACQUIRE);
+#else
+    return *live;
+#endif
+  }
+}
+
+DecodeContext::Scope::Scope(DecodeContext& context) : context_(context), previous_(current) {
+  current = &context;
+}
+
+DecodeContext::Scope::~Scope() {
+  current = previous_;
+  if (previous_ != &context_) {
+    context_.rewind();
+  }
+}
+
+DecodeContext::HeapScope::HeapScope() : previous_(current) {
+  current = 0;
+}
+
+DecodeContext::HeapScope::~HeapScope() {
+  current = previous_;
+}
+
+DecodeContext::DecodeContext() : chunk_(0), allocations_(0), chunks_(0) {
+}
+
+DecodeContext::~DecodeContext() {
+  if (chunk_ != 0) {
+    releaseChunk(chunk_);
+  }
+}
+
+size_t DecodeContext::getAllocations() const {
+  return allocations_;
+}
+
+size_t DecodeContext::getChunks() const {
+  return chunks_;
+}
+
+size_t DecodeContext::getAllocationsAvoided() const {
+  return allocations_ - chunks_;
+}
+
+void* DecodeContext::allocate(size_t size) {
+  if (current != 0 && size <= MAX_OBJECT_SIZE) {
+    return current->allocateFromChunk(size);
+  }
+  return withHeader(::operator new(HEADER_SIZE + size), 0);
+}
+
+void DecodeContext::deallocate(void* p) {
+  if (p == 0) {
+    return;
+  }
+  void* block = (char*)p - HEADER_SIZE;
+  Chunk* chunk = *(Chunk**)block;
+  if (chunk == 0) {
+    ::operator delete(block);
+  } else {
+    releaseChunk(chunk);
+  }
+}
+
+void* DecodeContext::allocateFromChunk(size_t size) {
+  size_t blockSize = HEADER_SIZE + align(size);
+  if (chunk_ == 0 || chunk_->used + blockSize > CHUNK_SIZE) {
+    if (chunk_ != 0) {
+      releaseChunk(chunk_);
+    }
+    chunk_ = (Chunk*)::operator new(CHUNK_SIZE);
+    chunk_->live = 1;
+    chunk_->used = align(sizeof(Chunk));
+    chunks_++;
+  }
+  void* block = (char*)chunk_ + chunk_->used;
+  chunk_->used += blockSize;
+  retainCount(&chunk_->live);
+  allocations_++;
+  return withHeader(block, chunk_);
+}
+
+/**
+ * Only this context adds blocks to its chunk, so once the chunk holds none,
+ * none can appear behind its back and it can be handed out again from the
+ * start. A chunk with survivors is left to them.
+ */
+void DecodeContext::rewind() {
+  if (chunk_ == 0) {
+    return;
+  }
+  if (loadCount(&chunk_->live) == 1) {
+    chunk_->used = align(sizeof(Chunk));
+  } else {
+    releaseChunk(chunk_);
+    chunk_ = 0;
+  }
+}
+
+void DecodeContext::releaseChunk(Chunk* chunk) {
+  if (releaseCount(&chunk->live) == 0) {
+    ::operator delete(chunk);
+  }
+}
+
+}
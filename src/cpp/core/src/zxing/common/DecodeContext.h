@@ -0,0 +1,125 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __DECODE_CONTEXT_H__
+#define __DECODE_CONTEXT_H__
+/*
+ *  DecodeContext.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+
+namespace zxing {
+
+/**
+ * A bump pointer arena for the small objects a decode makes and drops by
+ * the dozen: result points, finder and alignment patterns, perspective
+ * transforms, polynomials, data blocks and arrays. Those types derive from
+ * ArenaObject, and while a Scope is open on a thread, new hands them out of
+ * the scope's context instead of the heap.
+ *
+ * Deleting such an object only counts it off its chunk. When the scope
+ * closes with nothing left in the chunk, the chunk is rewound and the next
+ * decode reuses it, so a reader that decodes over and over stops asking the
+ * heap for these objects at all. Objects still referenced when the scope
+ * closes keep their chunk alive until the last of them goes, and the
+ * context moves on to a new one; so what is to outlive the decode, like
+ * its result, is better made under a HeapScope.
+ *
+ * A context belongs to one reader and is used by one thread at a time;
+ * the objects it hands out may be released anywhere, as Counted allows.
+ */
+class DecodeContext {
+public:
+  // Allocations bigger than this go to the heap.
+  static const size_t MAX_OBJECT_SIZE = 256;
+  static const size_t CHUNK_SIZE = 4096;
+
+  // Makes a context the current thread's for as long as it lives, and
+  // rewinds it when it goes.
+  class Scope {
+  public:
+    Scope(DecodeContext& context);
+    ~Scope();
+
+  private:
+    Scope(const Scope&);
+    Scope& operator =(const Scope&);
+
+    DecodeContext& context_;
+    DecodeContext* previous_;
+  };
+
+  // Sends the current thread's allocations back to the heap for as long as
+  // it lives, for objects that are to outlive the decode.
+  class HeapScope {
+  public:
+    HeapScope();
+    ~HeapScope();
+
+  private:
+    HeapScope(const HeapScope&);
+    HeapScope& operator =(const HeapScope&);
+
+    DecodeContext* previous_;
+  };
+
+  DecodeContext();
+  ~DecodeContext();
+
+  // Objects handed out of the arena, since the context was made.
+  size_t getAllocations() const;
+  // Chunks taken from the heap to hold them.
+  size_t getChunks() const;
+  // Heap allocations the arena saved.
+  size_t getAllocationsAvoided() const;
+
+  // From the current thread's context if it has one, else the heap.
+  static void* allocate(size_t size);
+  static void deallocate(void* p);
+
+private:
+  struct Chunk;
+
+  DecodeContext(const DecodeContext&);
+  DecodeContext& operator =(const DecodeContext&);
+
+  void* allocateFromChunk(size_t size);
+  void rewind();
+  static void releaseChunk(Chunk* chunk);
+
+  Chunk* chunk_;
+  size_t allocations_;
+  size_t chunks_;
+};
+
+/**
+ * Routes new and delete of a class and its subclasses through
+ * DecodeContext.
+ */
+class ArenaObject {
+public:
+  static void* operator new(size_t size) {
+    return DecodeContext::allocate(size);
+  }
+  static void operator delete(void* p) {
+    DecodeContext::deallocate(p);
+  }
+};
+
+}
+
+#endif // __DECODE_CONTEXT_H__
@@ -0,0 +1,127 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  DualBinarizer.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/DualBinarizer.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <vector>
+
+using namespace std;
+using namespace zxing;
+
+namespace {
+  const int BLOCK_SIZE = 1 << HybridBinarizer::BLOCK_SIZE_POWER;
+}
+
+DualBinarizer::DualBinarizer(Ref<LuminanceSource> source) :
+  HybridBinarizer(source), binarized_(false) {
+}
+
+DualBinarizer::~DualBinarizer() {
+}
+
+Ref<Binarizer> DualBinarizer::createBinarizer(Ref<LuminanceSource> source) {
+  return Ref<Binarizer> (new DualBinarizer(source));
+}
+
+Ref<BitMatrix> DualBinarizer::getBlackMatrix() {
+  binarize();
+  if (hybridMatrix_.empty()) {
+    // Too small for blocks, so the hybrid matrix is the global one.
+    throw IllegalArgumentException(globalError_.c_str());
+  }
+  return hybridMatrix_;
+}
+
+Ref<BitMatrix> DualBinarizer::getGlobalBlackMatrix() {
+  binarize();
+  if (globalMatrix_.empty()) {
+    throw IllegalArgumentException(globalError_.c_str());
+  }
+  return globalMatrix_;
+}
+
+void DualBinarizer::binarize() {
+  if (binarized_) {
+    return;
+  }
+  binarized_ = true;
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  int height = source.getHeight();
+  LuminanceView luminances = source.getMatrixView();
+  bool blocks = width >= MINIMUM_DIMENSION && height >= MINIMUM_DIMENSION;
+  int subWidth = blocks ? (width + BLOCK_SIZE - 1) / BLOCK_SIZE : 0;
+  int subHeight = blocks ? (height + BLOCK_SIZE - 1) / BLOCK_SIZE : 1;
+  // Without blocks, a single band of pixel rows covers the image.
+  int bandHeight = blocks ? BLOCK_SIZE : height;
+
+  vector<int> histogram;
+  vector<int> sums(subWidth * subHeight);
+  vector<int> mins(subWidth * subHeight);
+  vector<int> maxs(subWidth * subHeight);
+  for (int y = 0; y < subHeight; y++) {
+    int top = y * bandHeight;
+    int bottom = top + bandHeight < height ? top + bandHeight : height;
+    if (blocks) {
+      // The last block row is shifted up to end at the image edge.
+      int yoffset = top > height - BLOCK_SIZE ? height - BLOCK_SIZE : top;
+      LuminanceView band(luminances.getRow(yoffset), luminances.getStride(), width, BLOCK_SIZE);
+      int offset = y * subWidth;
+      calculateBlockStatistics(band, subWidth, 1, width, BLOCK_SIZE,
+                               &sums[offset], &mins[offset], &maxs[offset]);
+    }
+    for (int i = 0; i < SAMPLE_ROWS; i++) {
+      int row = getSampleRow(i, height);
+      if (row >= top && row < bottom) {
+        sampleRow(luminances.getRow(row), width, histogram);
+      }
+    }
+  }
+
+  int blackPoint = 0;
+  try {
+    blackPoint = estimate(histogram);
+    globalMatrix_ = new BitMatrix(width, height);
+  } catch (IllegalArgumentException const& iae) {
+    globalError_ = iae.what();
+  }
+  if (!blocks) {
+    if (!globalMatrix_.empty()) {
+      thresholdRows(luminances, blackPoint, *globalMatrix_, 0, height);
+    }
+    hybridMatrix_ = globalMatrix_;
+    return;
+  }
+
+  vector<int> blackPoints(subWidth * subHeight);
+  calculateBlackPoints(subWidth, subHeight, &sums[0], &mins[0], &maxs[0], &blackPoints[0]);
+  hybridMatrix_ = new BitMatrix(width, height);
+  unsigned int* bits = hybridMatrix_->getBits();
+  size_t rowStride = hybridMatrix_->getRowStride();
+  for (int y = 0; y < subHeight; y++) {
+    thresholdBlockRange(luminances, subWidth, subHeight, width, height, &blackPoints[0],
+                        bits, rowStride, 0, subWidth, y, y + 1);
+    if (!globalMatrix_.empty()) {
+      int top = y * BLOCK_SIZE;
+      int bottom = top + BLOCK_SIZE < height ? top + BLOCK_SIZE : height;
+      thresholdRows(luminances, blackPoint, *globalMatrix_, top, bottom);
+    }
+  }
+}
@@ -0,0 +1,60 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __DUAL_BINARIZER_H__
+#define __DUAL_BINARIZER_H__
+/*
+ *  DualBinarizer.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <zxing/common/HybridBinarizer.h>
+
+namespace zxing {
+
+/**
+ * A HybridBinarizer that also produces GlobalHistogramBinarizer's matrix,
+ * for callers that compare the two on the same image. Both come from one
+ * walk over the luminance: each block row's statistics are gathered
+ * together with any of the global histogram's sample rows it holds, and
+ * then each block row is thresholded both ways while its pixels are still
+ * in the cache. The matrices equal those of the two binarizers.
+ */
+class DualBinarizer : public HybridBinarizer {
+private:
+  Ref<BitMatrix> hybridMatrix_;
+  Ref<BitMatrix> globalMatrix_;
+  // Why the global matrix could not be made, if it could not.
+  std::string globalError_;
+  bool binarized_;
+
+public:
+  DualBinarizer(Ref<LuminanceSource> source);
+  virtual ~DualBinarizer();
+
+  // The hybrid matrix.
+  virtual Ref<BitMatrix> getBlackMatrix();
+  // Throws IllegalArgumentException where GlobalHistogramBinarizer would.
+  Ref<BitMatrix> getGlobalBlackMatrix();
+  Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+
+private:
+  void binarize();
+};
+
+}
+
+#endif // __DUAL_BINARIZER_H__
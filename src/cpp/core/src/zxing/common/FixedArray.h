@@ -0,0 +1,113 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __FIXED_ARRAY_H__
+#define __FIXED_ARRAY_H__
+/*
+ *  FixedArray.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <zxing/common/Array.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+namespace zxing {
+
+/**
+ * Up to N values kept inside the object itself, for buffers whose size is
+ * only known at run time but has a small bound, such as a Reed-Solomon
+ * block over GF(256), which never holds more than 255 codewords. Made on
+ * the stack, it costs no allocation at all. Asking for more than N values
+ * throws IllegalArgumentException.
+ */
+template<typename T, size_t N> class FixedArray {
+private:
+  T values_[N];
+  size_t size_;
+
+  void checkSize(size_t size) const {
+    if (size > N) {
+      throw IllegalArgumentException("Size exceeds the fixed capacity");
+    }
+  }
+
+public:
+  static const size_t CAPACITY = N;
+
+  // size values of T().
+  explicit FixedArray(size_t size = 0) : size_(size) {
+    checkSize(size);
+    for (size_t i = 0; i < size; i++) {
+      values_[i] = T();
+    }
+  }
+
+  T operator[](size_t i) const {
+    return values_[i];
+  }
+  T& operator[](size_t i) {
+    return values_[i];
+  }
+  size_t size() const {
+    return size_;
+  }
+  T* data() {
+    return values_;
+  }
+};
+
+/**
+ * A view of size values that some other object owns: an Array, a
+ * FixedArray or part of either. It is only good for as long as they are,
+ * and is passed by value.
+ */
+template<typename T> class Span {
+private:
+  T* data_;
+  size_t size_;
+
+public:
+  Span() : data_(0), size_(0) {
+  }
+  Span(T* data, size_t size) : data_(data), size_(size) {
+  }
+  Span(ArrayRef<T> const& array) : data_(0), size_(0) {
+    if (array.array_ != 0 && array.array_->size() > 0) {
+      data_ = &array.array_->values_[0];
+      size_ = array.array_->size();
+    }
+  }
+  template<size_t N> Span(FixedArray<T, N>& array) : data_(array.data()), size_(array.size()) {
+  }
+
+  T& operator[](size_t i) const {
+    return data_[i];
+  }
+  size_t size() const {
+    return size_;
+  }
+  T* data() const {
+    return data_;
+  }
+  // count values from offset on.
+  Span<T> subspan(size_t offset, size_t count) const {
+    return Span<T>(data_ + offset, count);
+  }
+};
+
+}
+
+#endif // __FIXED_ARRAY_H__
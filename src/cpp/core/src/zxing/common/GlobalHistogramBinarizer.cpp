@@ -21,6 +21,7 @@
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/IllegalArgumentException.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/BinarizerKernels.h>
 
 namespace zxing {
 using namespace std;
@@ -47,52 +48,86 @@ Ref<BitArray> GlobalHistogramBinarizer::getBlackRow(int y, Ref<BitArray> row) {
     }
   }
 
-  vector<int> histogram(LUMINANCE_BUCKETS, 0);
-  LuminanceSource& source = *getLuminanceSource();
-  int width = source.getWidth();
+  int width = getLuminanceSource()->getWidth();
   if (row == NULL || static_cast<int>(row->getSize()) < width) {
     row = new BitArray(width);
   } else {
     row->clear();
   }
 
-  //TODO(flyashi): cache this instead of allocating and deleting per row
-  unsigned char* row_pixels = NULL;
   try {
-    row_pixels = new unsigned char[width];
-    row_pixels = source.getRow(y, row_pixels);
-    for (int x = 0; x < width; x++) {
-      histogram[row_pixels[x] >> LUMINANCE_SHIFT]++;
-    }
-    int blackPoint = estimate(histogram);
-
-    BitArray& array = *row;
-    int left = row_pixels[0];
-    int center = row_pixels[1];
-    for (int x = 1; x < width - 1; x++) {
-      int right = row_pixels[x + 1];
-      // A simple -1 4 -1 box filter with a weight of 2.
-      int luminance = ((center << 2) - left - right) >> 1;
-      if (luminance < blackPoint) {
-        array.set(x);
-      }
-      left = center;
-      center = right;
-    }
-
+    binarizeRow(y, *row);
     cached_row_ = row;
     cached_row_num_ = y;
-    delete [] row_pixels;
     return row;
   } catch (IllegalArgumentException const& iae) {
     // Cache the fact that this row failed.
     cached_row_ = NULL;
     cached_row_num_ = y;
-    delete [] row_pixels;
     throw iae;
   }
 }
 
+/**
+ * Binarizes rows firstRow, firstRow + stride, ... into rows[0], rows[1], ...
+ * sharing the scratch space of getBlackRow. Entries of rows are reused where
+ * they are wide enough, like getBlackRow's row argument. A row with too
+ * little dynamic range is set to NULL instead of throwing, so that one bad
+ * row does not lose the rest of the batch. The stride may be negative.
+ */
+void GlobalHistogramBinarizer::getBlackRows(int firstRow, int count, int stride,
+                                            vector<Ref<BitArray> >& rows) {
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  int lastRow = firstRow + (count - 1) * stride;
+  if (count > 0 && (firstRow < 0 || firstRow >= source.getHeight() ||
+                    lastRow < 0 || lastRow >= source.getHeight())) {
+    throw IllegalArgumentException("Requested rows are outside the image.");
+  }
+  rows.resize(count);
+  for (int i = 0; i < count; i++) {
+    Ref<BitArray>& row = rows[i];
+    if (row == NULL || static_cast<int>(row->getSize()) < width) {
+      row = new BitArray(width);
+    } else {
+      row->clear();
+    }
+    try {
+      binarizeRow(firstRow + i * stride, *row);
+    } catch (IllegalArgumentException const&) {
+      row = NULL;
+    }
+  }
+}
+
+void GlobalHistogramBinarizer::binarizeRow(int y, BitArray& row) {
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  if (static_cast<int>(luminances_.size()) < width) {
+    luminances_.resize(width);
+  }
+  buckets_.assign(LUMINANCE_BUCKETS, 0);
+
+  unsigned char* pixels = source.getRow(y, &luminances_[0]);
+  for (int x = 0; x < width; x++) {
+    buckets_[pixels[x] >> LUMINANCE_SHIFT]++;
+  }
+  int blackPoint = estimate(buckets_);
+
+  int left = pixels[0];
+  int center = pixels[1];
+  for (int x = 1; x < width - 1; x++) {
+    int right = pixels[x + 1];
+    // A simple -1 4 -1 box filter with a weight of 2.
+    int luminance = ((center << 2) - left - right) >> 1;
+    if (luminance < blackPoint) {
+      row.set(x);
+    }
+    left = center;
+    center = right;
+  }
+}
+
 Ref<BitMatrix> GlobalHistogramBinarizer::getBlackMatrix() {
   if (cached_matrix_ != NULL) {
     return cached_matrix_;
@@ -102,39 +137,58 @@ Ref<BitMatrix> GlobalHistogramBinarizer::getBlackMatrix() {
   LuminanceSource& source = *getLuminanceSource();
   int width = source.getWidth();
   int height = source.getHeight();
-  vector<int> histogram(LUMINANCE_BUCKETS, 0);
+  vector<int> histogram;
 
   // Quickly calculates the histogram by sampling four rows from the image.
   // This proved to be more robust on the blackbox tests than sampling a
   // diagonal as we used to do.
-  ArrayRef<unsigned char> ref (width);
-  unsigned char* row = &ref[0];
-  for (int y = 1; y < 5; y++) {
-    int rownum = height * y / 5;
-    int right = (width << 2) / 5;
-    row = source.getRow(rownum, row);
-    for (int x = width / 5; x < right; x++) {
-      histogram[row[x] >> LUMINANCE_SHIFT]++;
-    }
+  LuminanceView luminances = source.getMatrixView();
+  for (int i = 0; i < SAMPLE_ROWS; i++) {
+    sampleRow(luminances.getRow(getSampleRow(i, height)), width, histogram);
   }
 
   int blackPoint = estimate(histogram);
 
   Ref<BitMatrix> matrix_ref(new BitMatrix(width, height));
-  BitMatrix& matrix = *matrix_ref;
-  for (int y = 0; y < height; y++) {
-    row = source.getRow(y, row);
-    for (int x = 0; x < width; x++) {
-      if (row[x] < blackPoint)
-        matrix.set(x, y);
-    }
-  }
+  thresholdRows(luminances, blackPoint, *matrix_ref, 0, height);
 
   cached_matrix_ = matrix_ref;
-  // delete [] row;
   return matrix_ref;
 }
 
+const int GlobalHistogramBinarizer::SAMPLE_ROWS;
+
+int GlobalHistogramBinarizer::getSampleRow(int i, int height) {
+  return height * (i + 1) / 5;
+}
+
+void GlobalHistogramBinarizer::sampleRow(unsigned char const* row,
+                                         int width,
+                                         vector<int>& histogram) {
+  if (histogram.empty()) {
+    histogram.resize(LUMINANCE_BUCKETS, 0);
+  }
+  int right = (width << 2) / 5;
+  for (int x = width / 5; x < right; x++) {
+    histogram[row[x] >> LUMINANCE_SHIFT]++;
+  }
+}
+
+void GlobalHistogramBinarizer::thresholdRows(LuminanceView const& luminances,
+                                             int blackPoint,
+                                             BitMatrix& matrix,
+                                             int yStart,
+                                             int yEnd) {
+  int width = luminances.getWidth();
+  // Black is below the black point, the kernel's black is at or below.
+  vector<unsigned char> thresholds(width, (unsigned char)(blackPoint - 1));
+  Ref<BitArray> row(new BitArray(width));
+  for (int y = yStart; y < yEnd; y++) {
+    kernels::thresholdRow(luminances.getRow(y), &thresholds[0], width, &row->getBitArray()[0]);
+    matrix.setRow(y, row);
+  }
+}
+
 int GlobalHistogramBinarizer::estimate(vector<int> &histogram) {
   int numBuckets = histogram.size();
   int maxBucketCount = 0;
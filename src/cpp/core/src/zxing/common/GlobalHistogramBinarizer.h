@@ -31,15 +31,37 @@ namespace zxing {
     Ref<BitMatrix> cached_matrix_;
 	  Ref<BitArray> cached_row_;
 	  int cached_row_num_;
+    // Scratch space reused by every row, so that scanning a whole image
+    // for 1D codes does not allocate per row.
+    std::vector<unsigned char> luminances_;
+    std::vector<int> buckets_;
 
 	public:
 		GlobalHistogramBinarizer(Ref<LuminanceSource> source);
 		virtual ~GlobalHistogramBinarizer();
 		
 		virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+		virtual void getBlackRows(int firstRow, int count, int stride,
+		                          std::vector<Ref<BitArray> >& rows);
 		virtual Ref<BitMatrix> getBlackMatrix();
 		static int estimate(std::vector<int> &histogram);
 		Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+  protected:
+    // The steps of getBlackMatrix, for binarizers that reuse some of them.
+    // The histogram samples the middle three fifths of SAMPLE_ROWS rows
+    // spread down the image, and every pixel darker than its estimated
+    // black point is black.
+    static const int SAMPLE_ROWS = 4;
+    static int getSampleRow(int i, int height);
+    static void sampleRow(unsigned char const* row, int width, std::vector<int>& histogram);
+    // Thresholds rows [yStart, yEnd) into matrix, replacing what was there.
+    static void thresholdRows(LuminanceView const& luminances,
+                              int blackPoint,
+                              BitMatrix& matrix,
+                              int yStart,
+                              int yEnd);
+	 private:
+    void binarizeRow(int y, BitArray& row);
 	};
 	
 }
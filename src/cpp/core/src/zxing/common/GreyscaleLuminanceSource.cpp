@@ -60,6 +60,19 @@ unsigned char* GreyscaleLuminanceSource::getMatrix() {
   return result;
 }
 
+// Borrows greyData directly; a crop only moves the start and keeps the stride.
+LuminanceView GreyscaleLuminanceSource::getMatrixView() {
+  return LuminanceView(greyData_ + top_ * dataWidth_ + left_, dataWidth_, width_, height_);
+}
+
+Ref<LuminanceSource> GreyscaleLuminanceSource::crop(int left, int top, int width, int height) {
+  if (left + width > width_ || top + height > height_ || top < 0 || left < 0) {
+    throw IllegalArgumentException("Crop rectangle does not fit within image data.");
+  }
+  return Ref<LuminanceSource> (new GreyscaleLuminanceSource(greyData_, dataWidth_, dataHeight_,
+      left_ + left, top_ + top, width, height));
+}
+
 Ref<LuminanceSource> GreyscaleLuminanceSource::rotateCounterClockwise() {
   // Intentionally flip the left, top, width, and height arguments as needed. dataWidth and
   // dataHeight are always kept unrotated.
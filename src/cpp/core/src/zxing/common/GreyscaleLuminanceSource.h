@@ -40,6 +40,11 @@ class GreyscaleLuminanceSource : public LuminanceSource {
 
   unsigned char* getRow(int y, unsigned char* row);
   unsigned char* getMatrix();
+  LuminanceView getMatrixView();
+
+  bool isCropSupported() const {
+    return true;
+  }
 
   bool isRotateSupported() const {
     return true;
@@ -53,6 +58,7 @@ class GreyscaleLuminanceSource : public LuminanceSource {
     return height_;
   }
 
+  Ref<LuminanceSource> crop(int left, int top, int width, int height);
   Ref<LuminanceSource> rotateCounterClockwise();
 
 };
@@ -20,6 +20,9 @@
 
 #include <zxing/common/GreyscaleRotatedLuminanceSource.h>
 #include <zxing/common/IllegalArgumentException.h>
+#include <zxing/common/LuminanceKernels.h>
+#include <string.h>
+#include <stdlib.h>
 
 namespace zxing {
 
@@ -28,7 +31,7 @@ namespace zxing {
 GreyscaleRotatedLuminanceSource::GreyscaleRotatedLuminanceSource(unsigned char* greyData,
     int dataWidth, int dataHeight, int left, int top, int width, int height) : greyData_(greyData),
     dataWidth_(dataWidth), dataHeight_(dataHeight), left_(left), top_(top), width_(width),
-    height_(height) {
+    height_(height), bandTop_(-1), lastRow_(-1) {
 
   // Intentionally comparing to the opposite dimension since we're rotated.
   if (left + width > dataHeight || top + height > dataWidth) {
@@ -36,6 +39,15 @@ GreyscaleRotatedLuminanceSource::GreyscaleRotatedLuminanceSource(unsigned char*
   }
 }
 
+const int GreyscaleRotatedLuminanceSource::BAND_HEIGHT;
+
+// Row y is column dataWidth_ - 1 - top_ - y of greyData, so rows first to
+// end are a strip of columns which, turned counter-clockwise, land in order.
+void GreyscaleRotatedLuminanceSource::rotateRows(int first, int end, unsigned char* rows) {
+  unsigned char const* strip = greyData_ + left_ * dataWidth_ + (dataWidth_ - top_ - end);
+  kernels::rotateCounterClockwise(strip, dataWidth_, end - first, width_, rows, width_);
+}
+
 // The API asks for rows, but we're rotated, so we return columns.
 unsigned char* GreyscaleRotatedLuminanceSource::getRow(int y, unsigned char* row) {
   if (y < 0 || y >= getHeight()) {
@@ -45,6 +57,26 @@ unsigned char* GreyscaleRotatedLuminanceSource::getRow(int y, unsigned char* row
   if (row == NULL) {
     row = new unsigned char[width];
   }
+  if (matrix_.array_ != 0) {
+    memcpy(row, &matrix_[y * width], width);
+    return row;
+  }
+  int first = y - y % BAND_HEIGHT;
+  bool dense = lastRow_ >= 0 && abs(y - lastRow_) < BAND_HEIGHT / 4;
+  lastRow_ = y;
+  if (first != bandTop_ && dense) {
+    int end = first + BAND_HEIGHT < height_ ? first + BAND_HEIGHT : height_;
+    if (band_.array_ == 0) {
+      band_ = new Array<unsigned char>(BAND_HEIGHT * width);
+    }
+    rotateRows(first, end, &band_[0]);
+    bandTop_ = first;
+  }
+  if (first == bandTop_) {
+    memcpy(row, &band_[(y - first) * width], width);
+    return row;
+  }
+  // A lone row: one byte from each row of greyData is cheaper than a band.
   int offset = (left_ * dataWidth_) + (dataWidth_ - 1 - (y + top_));
   for (int x = 0; x < width; x++) {
     row[x] = greyData_[offset];
@@ -55,11 +87,16 @@ unsigned char* GreyscaleRotatedLuminanceSource::getRow(int y, unsigned char* row
 
 unsigned char* GreyscaleRotatedLuminanceSource::getMatrix() {
   unsigned char* result = new unsigned char[width_ * height_];
-  // This depends on getRow() honoring its second parameter.
-  for (int y = 0; y < height_; y++) {
-    getRow(y, &result[y * width_]);
-  }
+  rotateRows(0, height_, result);
   return result;
 }
 
+LuminanceView GreyscaleRotatedLuminanceSource::getMatrixView() {
+  if (matrix_.array_ == 0) {
+    matrix_ = new Array<unsigned char>(width_ * height_);
+    rotateRows(0, height_, &matrix_[0]);
+  }
+  return LuminanceView(&matrix_[0], width_, width_, height_);
+}
+
 } // namespace
@@ -24,6 +24,14 @@
 
 namespace zxing {
 
+/**
+ * Rows of a rotated source are columns of greyData, which are slow to read
+ * one byte per cache line, so they are rotated in tiles instead. The matrix
+ * view rotates the whole image once, keeps it and lends it out. getRow()
+ * rotates the band of BAND_HEIGHT rows holding the one asked for when rows
+ * are being read close together; rows far apart, such as those a 1D scan
+ * samples, are still read as single columns, which is cheaper than a band.
+ */
 class GreyscaleRotatedLuminanceSource : public LuminanceSource {
  private:
   unsigned char* greyData_;
@@ -33,13 +41,22 @@ class GreyscaleRotatedLuminanceSource : public LuminanceSource {
   int top_;
   int width_;
   int height_;
+  ArrayRef<unsigned char> band_;
+  int bandTop_;
+  int lastRow_;
+  ArrayRef<unsigned char> matrix_;
+
+  void rotateRows(int first, int end, unsigned char* rows);
 
 public:
+  static const int BAND_HEIGHT = 16;
+
   GreyscaleRotatedLuminanceSource(unsigned char* greyData, int dataWidth, int dataHeight,
       int left, int top, int width, int height);
 
   unsigned char* getRow(int y, unsigned char* row);
   unsigned char* getMatrix();
+  LuminanceView getMatrixView();
 
   bool isRotateSupported() const {
     return false;
@@ -18,22 +18,37 @@
  * limitations under the License.
  */
 
+
 #include <zxing/common/HybridBinarizer.h>
 
 #include <zxing/common/IllegalArgumentException.h>
+#include <zxing/common/BinarizerKernels.h>
+#include <zxing/common/ThreadPool.h>
+#include <algorithm>
+#include <string.h>
 
 using namespace std;
 using namespace zxing;
 
+const int HybridBinarizer::BLOCK_SIZE_POWER;
+const int HybridBinarizer::MINIMUM_DIMENSION;
+
 namespace {
-  const int BLOCK_SIZE_POWER = 3;
+  const int BLOCK_SIZE_POWER = HybridBinarizer::BLOCK_SIZE_POWER;
   const int BLOCK_SIZE = 1 << BLOCK_SIZE_POWER; // ...0100...00
   const int BLOCK_SIZE_MASK = BLOCK_SIZE - 1;   // ...0011...11
-  const int MINIMUM_DIMENSION = BLOCK_SIZE * 5;
+  const int MINIMUM_DIMENSION = HybridBinarizer::MINIMUM_DIMENSION;
+
+  Ref<BitMatrix::TileSource> lazyThreshold(Ref<LuminanceSource> source,
+                                           LuminanceView const& luminances,
+                                           int subWidth,
+                                           int subHeight,
+                                           int* blackPoints);
 }
 
-HybridBinarizer::HybridBinarizer(Ref<LuminanceSource> source) :
-  GlobalHistogramBinarizer(source), matrix_(NULL), cached_row_(NULL), cached_row_num_(-1) {
+HybridBinarizer::HybridBinarizer(Ref<LuminanceSource> source, int threads, bool lazy) :
+  GlobalHistogramBinarizer(source), matrix_(NULL), cached_row_(NULL), cached_row_num_(-1),
+  threads_(threads < 1 ? 1 : threads), lazy_(lazy) {
 }
 
 HybridBinarizer::~HybridBinarizer() {
@@ -42,7 +57,15 @@ HybridBinarizer::~HybridBinarizer() {
 
 Ref<Binarizer>
 HybridBinarizer::createBinarizer(Ref<LuminanceSource> source) {
-  return Ref<Binarizer> (new HybridBinarizer(source));
+  return Ref<Binarizer> (new HybridBinarizer(source, threads_, lazy_));
+}
+
+int HybridBinarizer::getThreads() const {
+  return threads_;
+}
+
+bool HybridBinarizer::isLazy() const {
+  return lazy_;
 }
 
 
@@ -59,7 +82,7 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
   int width = source.getWidth();
   int height = source.getHeight();
   if (width >= MINIMUM_DIMENSION && height >= MINIMUM_DIMENSION) {
-    unsigned char* luminances = source.getMatrix();
+    LuminanceView luminances = source.getMatrixView();
     int subWidth = width >> BLOCK_SIZE_POWER;
     if ((width & BLOCK_SIZE_MASK) != 0) {
       subWidth++;
@@ -72,6 +95,15 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
       calculateBlackPoints(luminances, subWidth, subHeight, width, height);
 
     Ref<BitMatrix> newMatrix (new BitMatrix(width, height));
+    if (lazy_) {
+      // The black points are needed in full, since low contrast blocks
+      // borrow from their neighbours, but thresholding waits for the
+      // detectors to read each tile.
+      newMatrix->setTileSource(
+        lazyThreshold(getLuminanceSource(), luminances, subWidth, subHeight, blackPoints));
+      matrix_ = newMatrix;
+      return matrix_;
+    }
     calculateThresholdForBlock(luminances,
                                subWidth,
                                subHeight,
@@ -81,12 +113,11 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
                                newMatrix);
     matrix_ = newMatrix;
 
-    // N.B.: these deletes are inadequate if anything between the new
+    // N.B.: this delete is inadequate if anything between the new
     // and this point can throw.  As of this writing, it doesn't look
-    // like they do.
+    // like it does.
 
     delete [] blackPoints;
-    delete [] luminances;
   } else {
     // If the image is too small, fall back to the global histogram approach.
     matrix_ = GlobalHistogramBinarizer::getBlackMatrix();
@@ -98,124 +129,336 @@ namespace {
   inline int cap(int value, int min, int max) {
     return value < min ? min : value > max ? max : value;
   }
-}
 
-void
-HybridBinarizer::calculateThresholdForBlock(unsigned char* luminances,
-                                            int subWidth,
-                                            int subHeight,
-                                            int width,
-                                            int height,
-                                            int blackPoints[],
-                                            Ref<BitMatrix> const& matrix) {
-  for (int y = 0; y < subHeight; y++) {
+  inline int getBlackPointFromNeighbors(int* blackPoints, int subWidth, int x, int y) {
+    return (blackPoints[(y-1)*subWidth+x] +
+            2*blackPoints[y*subWidth+x-1] +
+            blackPoints[(y-1)*subWidth+x-1]) >> 2;
+  }
+
+  // Splits subHeight block rows into one band per thread. Every pixel row of
+  // the BitMatrix starts on a word boundary, so bands never share a word.
+  // The last band always holds the final two block rows, since the final one
+  // is shifted up to end at the image edge and overlaps the one before it.
+  // bands[i] is the first block row of band i; bands.back() is subHeight.
+  vector<int> splitBands(int subHeight, int threads) {
+    vector<int> bands(1, 0);
+    if (threads > 1) {
+      int step = (subHeight + threads - 1) / threads;
+      for (int start = step; start <= subHeight - 2; start += step) {
+        bands.push_back(start);
+      }
+    }
+    bands.push_back(subHeight);
+    return bands;
+  }
+
+  int blockRowOffset(int y, int height) {
     int yoffset = y << BLOCK_SIZE_POWER;
     int maxYOffset = height - BLOCK_SIZE;
-    if (yoffset > maxYOffset) {
-      yoffset = maxYOffset;
+    return yoffset > maxYOffset ? maxYOffset : yoffset;
+  }
+
+  // Blocks that fit entirely within the row are contiguous and are handed to
+  // the vectorized kernel in one go; the last block of a row whose width is
+  // not a multiple of BLOCK_SIZE is shifted left to end at the image edge.
+  void blockRowStatistics(LuminanceView const& luminances,
+                          int y,
+                          int subWidth,
+                          int width,
+                          int height,
+                          int* sums,
+                          int* mins,
+                          int* maxs) {
+    int fullBlocks = width >> BLOCK_SIZE_POWER;
+    unsigned char const* row = luminances.getRow(blockRowOffset(y, height));
+    int stride = luminances.getStride();
+    kernels::blockStatistics(row, stride, fullBlocks, sums, mins, maxs);
+    if (fullBlocks < subWidth) {
+      kernels::blockStatistics(row + width - BLOCK_SIZE, stride, 1,
+                               sums + fullBlocks, mins + fullBlocks, maxs + fullBlocks);
     }
-    for (int x = 0; x < subWidth; x++) {
-      int xoffset = x << BLOCK_SIZE_POWER;
-      int maxXOffset = width - BLOCK_SIZE;
-      if (xoffset > maxXOffset) {
-        xoffset = maxXOffset;
+  }
+
+  class BlockStatisticsTask : public ThreadPool::Task {
+  private:
+    vector<int> const& bands_;
+    LuminanceView const& luminances_;
+    int subWidth_;
+    int width_;
+    int height_;
+    int* sums_;
+    int* mins_;
+    int* maxs_;
+  public:
+    BlockStatisticsTask(vector<int> const& bands, LuminanceView const& luminances, int subWidth,
+                        int width, int height, int* sums, int* mins, int* maxs) :
+      bands_(bands), luminances_(luminances), subWidth_(subWidth), width_(width),
+      height_(height), sums_(sums), mins_(mins), maxs_(maxs) {
+    }
+    void run(int band) {
+      for (int y = bands_[band]; y < bands_[band + 1]; y++) {
+        int offset = y * subWidth_;
+        blockRowStatistics(luminances_, y, subWidth_, width_, height_,
+                           sums_ + offset, mins_ + offset, maxs_ + offset);
       }
-      int left = cap(x, 2, subWidth - 3);
-      int top = cap(y, 2, subHeight - 3);
-      int sum = 0;
-      for (int z = -2; z <= 2; z++) {
-        int *blackRow = &blackPoints[(top + z) * subWidth];
-        sum += blackRow[left - 2];
-        sum += blackRow[left - 1];
-        sum += blackRow[left];
-        sum += blackRow[left + 1];
-        sum += blackRow[left + 2];
+    }
+  };
+
+  // ORs count packed bits into the matrix's bit stream starting at bit
+  // offset. Bits are only carried into the next word when there are any, so
+  // that we never touch a word past the end of the matrix.
+  void orBits(unsigned int* bits, size_t offset, unsigned int const* row, size_t count) {
+    size_t word = offset >> 5;
+    unsigned int shift = offset & 31;
+    size_t words = (count + 31) >> 5;
+    if (shift == 0) {
+      for (size_t i = 0; i < words; i++) {
+        bits[word + i] |= row[i];
+      }
+    } else {
+      for (size_t i = 0; i < words; i++) {
+        bits[word + i] |= row[i] << shift;
+        unsigned int carry = row[i] >> (32 - shift);
+        if (carry != 0) {
+          bits[word + i + 1] |= carry;
+        }
       }
-      int average = sum / 25;
-      thresholdBlock(luminances, xoffset, yoffset, average, width, matrix);
     }
   }
-}
 
-void HybridBinarizer::thresholdBlock(unsigned char* luminances,
-                                     int xoffset,
-                                     int yoffset,
-                                     int threshold,
-                                     int stride,
-                                     Ref<BitMatrix> const& matrix) {
-  for (int y = 0, offset = yoffset * stride + xoffset;
-       y < BLOCK_SIZE;
-       y++,  offset += stride) {
-    for (int x = 0; x < BLOCK_SIZE; x++) {
-      int pixel = luminances[offset + x] & 0xff;
-      if (pixel <= threshold) {
-        matrix->set(xoffset + x, yoffset + y);
+  // Thresholds the blocks in columns [xStart, xEnd) of block rows
+  // [yStart, yEnd). Each block's threshold is the average of the 5x5 black
+  // points around it, clamped to the grid, so a band reads up to two block
+  // rows of black points on either side of itself. The thresholds are
+  // repeated across each block's BLOCK_SIZE pixels so that a whole row of
+  // the range can be compared in one pass. A last block shifted left to fit
+  // the image overlaps its neighbour and is handled on its own.
+  void thresholdBlocks(LuminanceView const& luminances,
+                       int subWidth,
+                       int subHeight,
+                       int width,
+                       int height,
+                       int blackPoints[],
+                       unsigned int* bits,
+                       size_t rowStride,
+                       int xStart,
+                       int xEnd,
+                       int yStart,
+                       int yEnd) {
+    int fullBlocks = width >> BLOCK_SIZE_POWER;
+    bool lastBlock = xEnd > fullBlocks;
+    int pixelStart = xStart << BLOCK_SIZE_POWER;
+    int fullWidth = ((lastBlock ? fullBlocks : xEnd) - xStart) << BLOCK_SIZE_POWER;
+    int count = lastBlock ? width - pixelStart : fullWidth;
+    vector<unsigned char> thresholds(fullWidth);
+    vector<unsigned int> rowBits((count + 31) >> 5);
+    for (int y = yStart; y < yEnd; y++) {
+      int yoffset = blockRowOffset(y, height);
+      int lastThreshold = 0;
+      for (int x = xStart; x < xEnd; x++) {
+        int left = cap(x, 2, subWidth - 3);
+        int top = cap(y, 2, subHeight - 3);
+        int sum = 0;
+        for (int z = -2; z <= 2; z++) {
+          int *blackRow = &blackPoints[(top + z) * subWidth];
+          sum += blackRow[left - 2];
+          sum += blackRow[left - 1];
+          sum += blackRow[left];
+          sum += blackRow[left + 1];
+          sum += blackRow[left + 2];
+        }
+        int average = sum / 25;
+        if (x < fullBlocks) {
+          memset(&thresholds[(x - xStart) << BLOCK_SIZE_POWER], average, BLOCK_SIZE);
+        } else {
+          lastThreshold = average;
+        }
+      }
+      for (int yy = yoffset; yy < yoffset + BLOCK_SIZE; yy++) {
+        unsigned char const* row = luminances.getRow(yy) + pixelStart;
+        kernels::thresholdRow(row, &thresholds[0], fullWidth, &rowBits[0]);
+        if (lastBlock) {
+          // The kernel only wrote the words covering fullWidth.
+          fill(rowBits.begin() + ((fullWidth + 31) >> 5), rowBits.end(), 0u);
+          for (int x = count - BLOCK_SIZE; x < count; x++) {
+            if (row[x] <= lastThreshold) {
+              rowBits[x >> 5] |= 1u << (x & 31);
+            }
+          }
+        }
+        orBits(bits, (size_t)yy * rowStride + pixelStart, &rowBits[0], count);
       }
     }
   }
+
+  // Thresholds a lazily filled matrix one BitMatrix tile at a time. Tiles are
+  // whole blocks, and the last tile in each direction also holds the block
+  // shifted to fit the image, so a tile never writes outside itself.
+  class LazyThreshold : public BitMatrix::TileSource {
+  private:
+    Ref<LuminanceSource> source_;
+    LuminanceView luminances_;
+    int subWidth_;
+    int subHeight_;
+    int* blackPoints_;
+  public:
+    LazyThreshold(Ref<LuminanceSource> source, LuminanceView const& luminances,
+                  int subWidth, int subHeight, int* blackPoints) :
+      source_(source), luminances_(luminances), subWidth_(subWidth),
+      subHeight_(subHeight), blackPoints_(blackPoints) {
+    }
+    ~LazyThreshold() {
+      delete [] blackPoints_;
+    }
+    void fillTile(unsigned int* bits, size_t rowStride, int left, int top, int right, int bottom) {
+      int width = luminances_.getWidth();
+      int height = luminances_.getHeight();
+      thresholdBlocks(luminances_, subWidth_, subHeight_, width, height, blackPoints_, bits, rowStride,
+                      left >> BLOCK_SIZE_POWER,
+                      right == width ? subWidth_ : right >> BLOCK_SIZE_POWER,
+                      top >> BLOCK_SIZE_POWER,
+                      bottom == height ? subHeight_ : bottom >> BLOCK_SIZE_POWER);
+    }
+  };
+
+  // Takes ownership of blackPoints.
+  Ref<BitMatrix::TileSource> lazyThreshold(Ref<LuminanceSource> source,
+                                           LuminanceView const& luminances,
+                                           int subWidth,
+                                           int subHeight,
+                                           int* blackPoints) {
+    return Ref<BitMatrix::TileSource>(
+      new LazyThreshold(source, luminances, subWidth, subHeight, blackPoints));
+  }
+
+  class ThresholdTask : public ThreadPool::Task {
+  private:
+    vector<int> const& bands_;
+    LuminanceView const& luminances_;
+    int subWidth_;
+    int subHeight_;
+    int width_;
+    int height_;
+    int* blackPoints_;
+    unsigned int* bits_;
+    size_t rowStride_;
+  public:
+    ThresholdTask(vector<int> const& bands, LuminanceView const& luminances, int subWidth,
+                  int subHeight, int width, int height, int* blackPoints, unsigned int* bits,
+                  size_t rowStride) :
+      bands_(bands), luminances_(luminances), subWidth_(subWidth), subHeight_(subHeight),
+      width_(width), height_(height), blackPoints_(blackPoints), bits_(bits),
+      rowStride_(rowStride) {
+    }
+    void run(int band) {
+      thresholdBlocks(luminances_, subWidth_, subHeight_, width_, height_, blackPoints_,
+                      bits_, rowStride_, 0, subWidth_, bands_[band], bands_[band + 1]);
+    }
+  };
 }
 
-namespace {
-  inline int getBlackPointFromNeighbors(int* blackPoints, int subWidth, int x, int y) {
-    return (blackPoints[(y-1)*subWidth+x] +
-            2*blackPoints[y*subWidth+x-1] +
-            blackPoints[(y-1)*subWidth+x-1]) >> 2;
+/**
+ * With more than one thread, bands of block rows are thresholded in
+ * parallel once all black points are known. Bands only write their own
+ * pixel rows, which start on word boundaries, so the result does not depend
+ * on the order in which they run.
+ */
+void
+HybridBinarizer::calculateThresholdForBlock(LuminanceView const& luminances,
+                                            int subWidth,
+                                            int subHeight,
+                                            int width,
+                                            int height,
+                                            int blackPoints[],
+                                            Ref<BitMatrix> const& matrix) {
+  unsigned int* bits = matrix->getBits();
+  size_t rowStride = matrix->getRowStride();
+  if (threads_ == 1) {
+    thresholdBlocks(luminances, subWidth, subHeight, width, height,
+                    blackPoints, bits, rowStride, 0, subWidth, 0, subHeight);
+    return;
   }
+  vector<int> bands = splitBands(subHeight, threads_);
+  ThresholdTask task(bands, luminances, subWidth, subHeight, width, height, blackPoints, bits,
+                     rowStride);
+  ThreadPool::shared(threads_).run(task, bands.size() - 1);
 }
 
+void HybridBinarizer::thresholdBlockRange(LuminanceView const& luminances,
+                                          int subWidth,
+                                          int subHeight,
+                                          int width,
+                                          int height,
+                                          int blackPoints[],
+                                          unsigned int* bits,
+                                          size_t rowStride,
+                                          int xStart,
+                                          int xEnd,
+                                          int yStart,
+                                          int yEnd) {
+  thresholdBlocks(luminances, subWidth, subHeight, width, height, blackPoints, bits, rowStride,
+                  xStart, xEnd, yStart, yEnd);
+}
 
-int* HybridBinarizer::calculateBlackPoints(unsigned char* luminances,
+/**
+ * The block statistics are independent and are gathered in parallel bands
+ * when more than one thread is used. Turning them into black points stays
+ * serial, since a low contrast block borrows from the black points above
+ * and to the left of it; that pass is cheap.
+ */
+int* HybridBinarizer::calculateBlackPoints(LuminanceView const& luminances,
                                            int subWidth,
                                            int subHeight,
                                            int width,
                                            int height) {
+  vector<int> sums(subWidth * subHeight);
+  vector<int> mins(subWidth * subHeight);
+  vector<int> maxs(subWidth * subHeight);
+  calculateBlockStatistics(luminances, subWidth, subHeight, width, height,
+                           &sums[0], &mins[0], &maxs[0]);
+  int *blackPoints = new int[subHeight * subWidth];
+  calculateBlackPoints(subWidth, subHeight, &sums[0], &mins[0], &maxs[0], blackPoints);
+  return blackPoints;
+}
+
+void HybridBinarizer::calculateBlockStatistics(LuminanceView const& luminances,
+                                               int subWidth,
+                                               int subHeight,
+                                               int width,
+                                               int height,
+                                               int* sums,
+                                               int* mins,
+                                               int* maxs) {
+  if (threads_ == 1) {
+    for (int y = 0; y < subHeight; y++) {
+      int offset = y * subWidth;
+      blockRowStatistics(luminances, y, subWidth, width, height,
+                         sums + offset, mins + offset, maxs + offset);
+    }
+  } else {
+    vector<int> bands = splitBands(subHeight, threads_);
+    BlockStatisticsTask task(bands, luminances, subWidth, width, height, sums, mins, maxs);
+    ThreadPool::shared(threads_).run(task, bands.size() - 1);
+  }
+}
+
+void HybridBinarizer::calculateBlackPoints(int subWidth,
+                                           int subHeight,
+                                           int const* sums,
+                                           int const* mins,
+                                           int const* maxs,
+                                           int* blackPoints) {
   const int minDynamicRange = 24;
 
-  int *blackPoints = new int[subHeight * subWidth];
   for (int y = 0; y < subHeight; y++) {
-    int yoffset = y << BLOCK_SIZE_POWER;
-    int maxYOffset = height - BLOCK_SIZE;
-    if (yoffset > maxYOffset) {
-      yoffset = maxYOffset;
-    }
     for (int x = 0; x < subWidth; x++) {
-      int xoffset = x << BLOCK_SIZE_POWER;
-      int maxXOffset = width - BLOCK_SIZE;
-      if (xoffset > maxXOffset) {
-        xoffset = maxXOffset;
-      }
-      int sum = 0;
-      int min = 0xFF;
-      int max = 0;
-      for (int yy = 0, offset = yoffset * width + xoffset;
-           yy < BLOCK_SIZE;
-           yy++, offset += width) {
-        for (int xx = 0; xx < BLOCK_SIZE; xx++) {
-          int pixel = luminances[offset + xx] & 0xFF;
-          sum += pixel;
-          // still looking for good contrast
-          if (pixel < min) {
-            min = pixel;
-          }
-          if (pixel > max) {
-            max = pixel;
-          }
-        }
-
-        // short-circuit min/max tests once dynamic range is met
-        if (max - min > minDynamicRange) {
-          // finish the rest of the rows quickly
-          for (yy++, offset += width; yy < BLOCK_SIZE; yy++, offset += width) {
-            for (int xx = 0; xx < BLOCK_SIZE; xx += 2) {
-              sum += luminances[offset + xx] & 0xFF;
-              sum += luminances[offset + xx + 1] & 0xFF;
-            }
-          }
-        }
-      }
+      int offset = y * subWidth + x;
+      int min = mins[offset];
+      int max = maxs[offset];
       // See
       // http://groups.google.com/group/zxing/browse_thread/thread/d06efa2c35a7ddc0
-      int average = sum >> (BLOCK_SIZE_POWER * 2);
+      int average = sums[offset] >> (BLOCK_SIZE_POWER * 2);
       if (max - min <= minDynamicRange) {
         average = min >> 1;
         if (y > 0 && x > 0) {
@@ -225,9 +468,7 @@ int* HybridBinarizer::calculateBlackPoints(unsigned char* luminances,
           }
         }
       }
-      blackPoints[y * subWidth + x] = average;
+      blackPoints[offset] = average;
     }
   }
-  return blackPoints;
 }
-
@@ -33,34 +33,73 @@ namespace zxing {
     Ref<BitMatrix> matrix_;
 	  Ref<BitArray> cached_row_;
 	  int __attribute__ ((unused)) cached_row_num_;
+    int threads_;
+    bool lazy_;
 
 	public:
-		HybridBinarizer(Ref<LuminanceSource> source);
+    // Thresholds are computed per block of 2^BLOCK_SIZE_POWER pixels square.
+    // Smaller images fall back to GlobalHistogramBinarizer.
+    static const int BLOCK_SIZE_POWER = 3;
+    static const int MINIMUM_DIMENSION = 5 << BLOCK_SIZE_POWER;
+
+    // With threads > 1 the matrix is computed in horizontal bands on a
+    // shared ThreadPool. The result is identical to the serial one.
+    // With lazy, getBlackMatrix only computes the block statistics and the
+    // matrix thresholds each BitMatrix tile when it is first read, in the
+    // reading thread.
+		HybridBinarizer(Ref<LuminanceSource> source, int threads = 1, bool lazy = false);
 		virtual ~HybridBinarizer();
 		
 		virtual Ref<BitMatrix> getBlackMatrix();
 		Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+    int getThreads() const;
+    bool isLazy() const;
+  protected:
+    // The steps of getBlackMatrix, for binarizers that reuse some of them.
+    // Block statistics are laid out row by row, subWidth blocks per row.
+    void calculateBlockStatistics(LuminanceView const& luminances,
+                                  int subWidth,
+                                  int subHeight,
+                                  int width,
+                                  int height,
+                                  int* sums,
+                                  int* mins,
+                                  int* maxs);
+    static void calculateBlackPoints(int subWidth,
+                                     int subHeight,
+                                     int const* sums,
+                                     int const* mins,
+                                     int const* maxs,
+                                     int* blackPoints);
+    // ORs the thresholded blocks in columns [xStart, xEnd) and rows
+    // [yStart, yEnd) into bits, rowStride bits to a row.
+    static void thresholdBlockRange(LuminanceView const& luminances,
+                                    int subWidth,
+                                    int subHeight,
+                                    int width,
+                                    int height,
+                                    int blackPoints[],
+                                    unsigned int* bits,
+                                    size_t rowStride,
+                                    int xStart,
+                                    int xEnd,
+                                    int yStart,
+                                    int yEnd);
   private:
     // We'll be using one-D arrays because C++ can't dynamically allocate 2D
     // arrays
-    int* calculateBlackPoints(unsigned char* luminances,
+    int* calculateBlackPoints(LuminanceView const& luminances,
                               int subWidth,
                               int subHeight,
                               int width,
                               int height);
-    void calculateThresholdForBlock(unsigned char* luminances,
+    void calculateThresholdForBlock(LuminanceView const& luminances,
                                     int subWidth,
                                     int subHeight,
                                     int width,
                                     int height,
                                     int blackPoints[],
                                     Ref<BitMatrix> const& matrix);
-    void thresholdBlock(unsigned char* luminances,
-                        int xoffset,
-                        int yoffset,
-                        int threshold,
-                        int stride,
-                        Ref<BitMatrix> const& matrix);
 	};
 
 }
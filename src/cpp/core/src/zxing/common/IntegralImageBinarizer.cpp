@@ -0,0 +1,161 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  IntegralImageBinarizer.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/IntegralImageBinarizer.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+using namespace std;
+using namespace zxing;
+
+const int IntegralImageBinarizer::DEFAULT_WINDOW_SIZE;
+const int IntegralImageBinarizer::DEFAULT_BIAS;
+
+IntegralImageBinarizer::IntegralImageBinarizer(Ref<LuminanceSource> source,
+                                               int windowSize,
+                                               int bias) :
+  Binarizer(source), windowSize_(windowSize), bias_(bias), matrix_(NULL), luminances_(NULL) {
+  // The upper bound keeps pixel * area * 100 within an unsigned int.
+  if (windowSize < 3 || windowSize > 255 || (windowSize & 1) == 0) {
+    throw IllegalArgumentException("window size must be odd and between 3 and 255");
+  }
+  if (bias < 0 || bias >= 100) {
+    throw IllegalArgumentException("bias must be between 0 and 99");
+  }
+}
+
+IntegralImageBinarizer::~IntegralImageBinarizer() {
+  delete luminances_;
+}
+
+Ref<Binarizer> IntegralImageBinarizer::createBinarizer(Ref<LuminanceSource> source) {
+  return Ref<Binarizer> (new IntegralImageBinarizer(source, windowSize_, bias_));
+}
+
+namespace {
+  /**
+   * Adds a row of pixels under a row of the summed-area table: current[x + 1]
+   * becomes above[x + 1] plus the row's pixels up to and including x, and
+   * current[0] is 0. current may be above. The sums are allowed to wrap
+   * around: a window sum is a difference of four entries and comes out
+   * right modulo 2^32, and the true window sum is far smaller than that.
+   */
+  void addRow(unsigned char const* pixels, int width, unsigned int const* above,
+              unsigned int* current) {
+    unsigned int rowSum = 0;
+    current[0] = 0;
+    for (int x = 0; x < width; x++) {
+      rowSum += pixels[x];
+      current[x + 1] = above[x + 1] + rowSum;
+    }
+  }
+}
+
+// The source is read once, whichever of getBlackRow and getBlackMatrix
+// comes first.
+LuminanceView const& IntegralImageBinarizer::getLuminances() {
+  if (luminances_ == NULL) {
+    luminances_ = new LuminanceView(getLuminanceSource()->getMatrixView());
+  }
+  return *luminances_;
+}
+
+/**
+ * above and below are the table rows at the top and bottom of row y's
+ * window, which is rows high.
+ */
+void IntegralImageBinarizer::thresholdRow(int y, int rows, unsigned int const* above,
+                                          unsigned int const* below, BitArray& row) {
+  LuminanceView const& luminances = getLuminances();
+  int width = luminances.getWidth();
+  int radius = windowSize_ >> 1;
+  unsigned int scale = 100 - bias_;
+
+  unsigned char const* pixels = luminances.getRow(y);
+  for (int x = 0; x < width; x++) {
+    int left = x - radius < 0 ? 0 : x - radius;
+    int right = x + radius + 1 > width ? width : x + radius + 1;
+    unsigned int sum = below[right] - below[left] - above[right] + above[left];
+    unsigned int area = rows * (right - left);
+    if (pixels[x] * area * 100 <= sum * scale) {
+      row.set(x);
+    }
+  }
+}
+
+// Only the window's rows are summed, into a table row under a row of 0s.
+Ref<BitArray> IntegralImageBinarizer::getBlackRow(int y, Ref<BitArray> row) {
+  LuminanceView const& luminances = getLuminances();
+  int width = luminances.getWidth();
+  int height = luminances.getHeight();
+  if (y < 0 || y >= height) {
+    throw IllegalArgumentException("Requested row is outside the image.");
+  }
+  if (row == NULL || static_cast<int>(row->getSize()) < width) {
+    row = new BitArray(width);
+  } else {
+    row->clear();
+  }
+  int stride = width + 1;
+  int radius = windowSize_ >> 1;
+  int top = y - radius < 0 ? 0 : y - radius;
+  int bottom = y + radius + 1 > height ? height : y + radius + 1;
+  sums_.assign(2 * stride, 0);
+  unsigned int* below = &sums_[stride];
+  for (int i = top; i < bottom; i++) {
+    addRow(luminances.getRow(i), width, below, below);
+  }
+  thresholdRow(y, bottom - top, &sums_[0], below, *row);
+  return row;
+}
+
+/**
+ * Table row t, the sums of image rows 0 to t - 1, is kept in slot t % slots
+ * of sums_. A window spans no more than slots - 1 rows, so by the time row
+ * t is added every row thresholded from it still has its top row there.
+ */
+Ref<BitMatrix> IntegralImageBinarizer::getBlackMatrix() {
+  if (matrix_) {
+    return matrix_;
+  }
+  LuminanceView const& luminances = getLuminances();
+  int width = luminances.getWidth();
+  int height = luminances.getHeight();
+  int stride = width + 1;
+  int radius = windowSize_ >> 1;
+  int slots = (windowSize_ < height ? windowSize_ : height) + 1;
+  sums_.assign(slots * stride, 0);
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  Ref<BitArray> row(new BitArray(width));
+  int y = 0;
+  for (int t = 1; t <= height; t++) {
+    addRow(luminances.getRow(t - 1), width, &sums_[((t - 1) % slots) * stride],
+           &sums_[(t % slots) * stride]);
+    // Rows whose window ends at table row t, and at the end all the rest.
+    int last = t == height ? height - 1 : t - radius - 1;
+    for (; y <= last; y++) {
+      int top = y - radius < 0 ? 0 : y - radius;
+      row->clear();
+      thresholdRow(y, t - top, &sums_[(top % slots) * stride], &sums_[(t % slots) * stride], *row);
+      matrix->setRow(y, row);
+    }
+  }
+  matrix_ = matrix;
+  return matrix_;
+}
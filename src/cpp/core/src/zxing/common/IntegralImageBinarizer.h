@@ -0,0 +1,76 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __INTEGRAL_IMAGE_BINARIZER_H__
+#define __INTEGRAL_IMAGE_BINARIZER_H__
+/*
+ *  IntegralImageBinarizer.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/Binarizer.h>
+#include <zxing/common/BitArray.h>
+#include <zxing/common/BitMatrix.h>
+
+namespace zxing {
+
+/**
+ * Thresholds every pixel against the mean of the square window centred on
+ * it: a pixel is black when it is more than bias percent darker than that
+ * mean. The window sums come from rows of a summed-area table, so the cost
+ * per pixel does not depend on the window size. getBlackMatrix builds the
+ * table in one pass down the image, keeping only the rows the windows still
+ * reach and thresholding each row once its window is complete; getBlackRow
+ * sums only the rows of its own window. Unlike
+ * HybridBinarizer's 8x8 block grid the threshold varies smoothly, which
+ * copes better with uneven lighting.
+ *
+ * Windows are clipped at the image edges.
+ */
+class IntegralImageBinarizer : public Binarizer {
+private:
+  int windowSize_;
+  int bias_;
+  std::vector<unsigned int> sums_;
+  Ref<BitMatrix> matrix_;
+  LuminanceView* luminances_;
+
+public:
+  static const int DEFAULT_WINDOW_SIZE = 41;
+  static const int DEFAULT_BIAS = 15;
+
+  // windowSize must be odd and between 3 and 255; bias is in [0, 100).
+  IntegralImageBinarizer(Ref<LuminanceSource> source,
+                         int windowSize = DEFAULT_WINDOW_SIZE,
+                         int bias = DEFAULT_BIAS);
+  virtual ~IntegralImageBinarizer();
+
+  virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+  virtual Ref<BitMatrix> getBlackMatrix();
+  Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+
+private:
+  LuminanceView const& getLuminances();
+  void thresholdRow(int y, int rows, unsigned int const* above, unsigned int const* below,
+                    BitArray& row);
+
+  IntegralImageBinarizer(const IntegralImageBinarizer&);
+  IntegralImageBinarizer& operator =(const IntegralImageBinarizer&);
+};
+
+}
+
+#endif // __INTEGRAL_IMAGE_BINARIZER_H__
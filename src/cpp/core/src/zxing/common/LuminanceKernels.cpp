@@ -0,0 +1,469 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  LuminanceKernels.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <zxing/common/LuminanceKernels.h>
+
+#ifdef ZXING_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef ZXING_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#ifdef ZXING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace zxing;
+using namespace zxing::kernels;
+using namespace zxing::simd;
+
+namespace {
+  void luminanceRowScalar(unsigned char const* pixels,
+                          int count,
+                          LuminanceWeights const& weights,
+                          unsigned char* luminances) {
+    int w0 = weights.channels[0];
+    int w1 = weights.channels[1];
+    int w2 = weights.channels[2];
+    int w3 = weights.channels[3];
+    for (int i = 0; i < count; i++, pixels += 4) {
+      luminances[i] = (unsigned char)
+        ((w0 * pixels[0] + w1 * pixels[1] + w2 * pixels[2] + w3 * pixels[3] +
+          weights.bias) >> weights.shift);
+    }
+  }
+
+#ifdef ZXING_SIMD_SSE2
+  // Widens two pixels to 16 bits per channel and lets pmaddwd weigh them,
+  // which leaves each pixel's luminance split over two 32 bit lanes.
+  // Returns pixel 0 in lane 0 and pixel 1 in lane 1.
+  inline __m128i weighPairSse2(__m128i pair, __m128i weights) {
+    __m128i halves = _mm_madd_epi16(pair, weights);
+    __m128i sums = _mm_add_epi32(halves, _mm_srli_epi64(halves, 32));
+    return _mm_shuffle_epi32(sums, _MM_SHUFFLE(3, 3, 2, 0));
+  }
+
+  // Four pixels per 16 byte load, sixteen per iteration.
+  void luminanceRowSse2(unsigned char const* pixels,
+                        int count,
+                        LuminanceWeights const& weights,
+                        unsigned char* luminances) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i channels = _mm_setr_epi16(weights.channels[0], weights.channels[1],
+                                            weights.channels[2], weights.channels[3],
+                                            weights.channels[0], weights.channels[1],
+                                            weights.channels[2], weights.channels[3]);
+    const __m128i bias = _mm_set1_epi32(weights.bias);
+    const __m128i shift = _mm_cvtsi32_si128(weights.shift);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+      __m128i quads[4];
+      for (int q = 0; q < 4; q++) {
+        __m128i p = _mm_loadu_si128((__m128i const*)(pixels + (i + q * 4) * 4));
+        __m128i lo = weighPairSse2(_mm_unpacklo_epi8(p, zero), channels);
+        __m128i hi = weighPairSse2(_mm_unpackhi_epi8(p, zero), channels);
+        quads[q] = _mm_srl_epi32(_mm_add_epi32(_mm_unpacklo_epi64(lo, hi), bias), shift);
+      }
+      __m128i words = _mm_packus_epi16(_mm_packs_epi32(quads[0], quads[1]),
+                                       _mm_packs_epi32(quads[2], quads[3]));
+      _mm_storeu_si128((__m128i*)(luminances + i), words);
+    }
+    luminanceRowScalar(pixels + i * 4, count - i, weights, luminances + i);
+  }
+#endif
+
+#ifdef ZXING_SIMD_AVX2
+  // The SSE2 kernel on both 128 bit lanes at once, eight pixels per load.
+  // Packing interleaves the lanes, so a final permute restores pixel order.
+  __attribute__ ((target("avx2")))
+  void luminanceRowAvx2(unsigned char const* pixels,
+                        int count,
+                        LuminanceWeights const& weights,
+                        unsigned char* luminances) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i channels = _mm256_setr_epi16(
+      weights.channels[0], weights.channels[1], weights.channels[2], weights.channels[3],
+      weights.channels[0], weights.channels[1], weights.channels[2], weights.channels[3],
+      weights.channels[0], weights.channels[1], weights.channels[2], weights.channels[3],
+      weights.channels[0], weights.channels[1], weights.channels[2], weights.channels[3]);
+    const __m256i bias = _mm256_set1_epi32(weights.bias);
+    const __m128i shift = _mm_cvtsi32_si128(weights.shift);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+      __m256i octs[4];
+      for (int q = 0; q < 4; q++) {
+        __m256i p = _mm256_loadu_si256((__m256i const*)(pixels + (i + q * 8) * 4));
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi8(p, zero), channels);
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi8(p, zero), channels);
+        lo = _mm256_shuffle_epi32(_mm256_add_epi32(lo, _mm256_srli_epi64(lo, 32)),
+                                  _MM_SHUFFLE(3, 3, 2, 0));
+        hi = _mm256_shuffle_epi32(_mm256_add_epi32(hi, _mm256_srli_epi64(hi, 32)),
+                                  _MM_SHUFFLE(3, 3, 2, 0));
+        octs[q] = _mm256_srl_epi32(_mm256_add_epi32(_mm256_unpacklo_epi64(lo, hi), bias), shift);
+      }
+      __m256i words = _mm256_packus_epi16(_mm256_packs_epi32(octs[0], octs[1]),
+                                          _mm256_packs_epi32(octs[2], octs[3]));
+      words = _mm256_permutevar8x32_epi32(words, order);
+      _mm256_storeu_si256((__m256i*)(luminances + i), words);
+    }
+    luminanceRowScalar(pixels + i * 4, count - i, weights, luminances + i);
+  }
+#endif
+
+#ifdef ZXING_SIMD_NEON
+  // vld4 splits sixteen pixels into their four channels, which are then
+  // widened and weighed four pixels at a time.
+  inline uint16x4_t weighQuadNeon(uint16x4_t c0, uint16x4_t c1, uint16x4_t c2, uint16x4_t c3,
+                                  LuminanceWeights const& weights, int32x4_t shift) {
+    uint32x4_t sum = vdupq_n_u32(weights.bias);
+    sum = vmlal_n_u16(sum, c0, weights.channels[0]);
+    sum = vmlal_n_u16(sum, c1, weights.channels[1]);
+    sum = vmlal_n_u16(sum, c2, weights.channels[2]);
+    sum = vmlal_n_u16(sum, c3, weights.channels[3]);
+    return vmovn_u32(vshlq_u32(sum, shift));
+  }
+
+  void luminanceRowNeon(unsigned char const* pixels,
+                        int count,
+                        LuminanceWeights const& weights,
+                        unsigned char* luminances) {
+    const int32x4_t shift = vdupq_n_s32(-weights.shift);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+      uint8x16x4_t p = vld4q_u8(pixels + i * 4);
+      uint16x8_t lo[4];
+      uint16x8_t hi[4];
+      for (int c = 0; c < 4; c++) {
+        lo[c] = vmovl_u8(vget_low_u8(p.val[c]));
+        hi[c] = vmovl_u8(vget_high_u8(p.val[c]));
+      }
+      uint16x8_t first = vcombine_u16(
+        weighQuadNeon(vget_low_u16(lo[0]), vget_low_u16(lo[1]),
+                      vget_low_u16(lo[2]), vget_low_u16(lo[3]), weights, shift),
+        weighQuadNeon(vget_high_u16(lo[0]), vget_high_u16(lo[1]),
+                      vget_high_u16(lo[2]), vget_high_u16(lo[3]), weights, shift));
+      uint16x8_t second = vcombine_u16(
+        weighQuadNeon(vget_low_u16(hi[0]), vget_low_u16(hi[1]),
+                      vget_low_u16(hi[2]), vget_low_u16(hi[3]), weights, shift),
+        weighQuadNeon(vget_high_u16(hi[0]), vget_high_u16(hi[1]),
+                      vget_high_u16(hi[2]), vget_high_u16(hi[3]), weights, shift));
+      vst1q_u8(luminances + i, vcombine_u8(vmovn_u16(first), vmovn_u16(second)));
+    }
+    luminanceRowScalar(pixels + i * 4, count - i, weights, luminances + i);
+  }
+#endif
+
+  const int TILE = 16;
+  const int BLOCK = 64;
+
+  // One tile of rotateCounterClockwise, at most TILE by TILE, byte by byte.
+  void rotateTileScalar(unsigned char const* src, int srcStride, int width,
+                        int tileX, int tileY, int tileWidth, int tileHeight,
+                        unsigned char* dst, int dstStride) {
+    for (int y = tileY; y < tileY + tileHeight; y++) {
+      unsigned char const* row = src + (size_t)y * srcStride;
+      for (int x = tileX; x < tileX + tileWidth; x++) {
+        dst[(size_t)(width - 1 - x) * dstStride + y] = row[x];
+      }
+    }
+  }
+
+#ifdef ZXING_SIMD_SSE2
+  // Interleaves rows i and i + 8 of a 16x16 byte tile.
+  inline void interleaveSse2(__m128i const* in, __m128i* out) {
+    out[0] = _mm_unpacklo_epi8(in[0], in[8]);
+    out[1] = _mm_unpackhi_epi8(in[0], in[8]);
+    out[2] = _mm_unpacklo_epi8(in[1], in[9]);
+    out[3] = _mm_unpackhi_epi8(in[1], in[9]);
+    out[4] = _mm_unpacklo_epi8(in[2], in[10]);
+    out[5] = _mm_unpackhi_epi8(in[2], in[10]);
+    out[6] = _mm_unpacklo_epi8(in[3], in[11]);
+    out[7] = _mm_unpackhi_epi8(in[3], in[11]);
+    out[8] = _mm_unpacklo_epi8(in[4], in[12]);
+    out[9] = _mm_unpackhi_epi8(in[4], in[12]);
+    out[10] = _mm_unpacklo_epi8(in[5], in[13]);
+    out[11] = _mm_unpackhi_epi8(in[5], in[13]);
+    out[12] = _mm_unpacklo_epi8(in[6], in[14]);
+    out[13] = _mm_unpackhi_epi8(in[6], in[14]);
+    out[14] = _mm_unpacklo_epi8(in[7], in[15]);
+    out[15] = _mm_unpackhi_epi8(in[7], in[15]);
+  }
+
+  // Interleaving four times over transposes the tile: each pass rotates the
+  // bits of a byte's (row, column) index by one.
+  void rotateTileSse2(unsigned char const* src, int srcStride, int width,
+                      int tileX, int tileY, unsigned char* dst, int dstStride) {
+    __m128i rows[TILE];
+    __m128i next[TILE];
+    for (int i = 0; i < TILE; i++) {
+      rows[i] = _mm_loadu_si128((__m128i const*)(src + (size_t)(tileY + i) * srcStride + tileX));
+    }
+    interleaveSse2(rows, next);
+    interleaveSse2(next, rows);
+    interleaveSse2(rows, next);
+    interleaveSse2(next, rows);
+    // rows[i] now holds column tileX + i, which is dst row width - 1 - tileX - i.
+    for (int i = 0; i < TILE; i++) {
+      _mm_storeu_si128((__m128i*)(dst + (size_t)(width - 1 - tileX - i) * dstStride + tileY),
+                       rows[i]);
+    }
+  }
+#endif
+
+#ifdef ZXING_SIMD_NEON
+  // The SSE2 transpose, with vzip doing both unpacks.
+  void rotateTileNeon(unsigned char const* src, int srcStride, int width,
+                      int tileX, int tileY, unsigned char* dst, int dstStride) {
+    uint8x16_t rows[TILE];
+    for (int i = 0; i < TILE; i++) {
+      rows[i] = vld1q_u8(src + (size_t)(tileY + i) * srcStride + tileX);
+    }
+    for (int pass = 0; pass < 4; pass++) {
+      uint8x16_t next[TILE];
+      for (int i = 0; i < TILE / 2; i++) {
+        uint8x16x2_t zipped = vzipq_u8(rows[i], rows[i + TILE / 2]);
+        next[2 * i] = zipped.val[0];
+        next[2 * i + 1] = zipped.val[1];
+      }
+      for (int i = 0; i < TILE; i++) {
+        rows[i] = next[i];
+      }
+    }
+    for (int i = 0; i < TILE; i++) {
+      vst1q_u8(dst + (size_t)(width - 1 - tileX - i) * dstStride + tileY, rows[i]);
+    }
+  }
+#endif
+
+  void downsampleRowScalar(unsigned char const* above,
+                           unsigned char const* below,
+                           int count,
+                           unsigned char* luminances) {
+    for (int i = 0; i < count; i++) {
+      luminances[i] = (unsigned char)
+        ((above[2 * i] + above[2 * i + 1] + below[2 * i] + below[2 * i + 1] + 2) >> 2);
+    }
+  }
+
+#ifdef ZXING_SIMD_SSE2
+  // Adds each byte pair of a load as 16 bit lanes: the even bytes masked,
+  // the odd ones shifted down.
+  inline __m128i pairSumsSse2(__m128i bytes) {
+    return _mm_add_epi16(_mm_and_si128(bytes, _mm_set1_epi16(0xFF)),
+                         _mm_srli_epi16(bytes, 8));
+  }
+
+  // Sixteen luminances from 32 bytes of each row per iteration.
+  void downsampleRowSse2(unsigned char const* above,
+                         unsigned char const* below,
+                         int count,
+                         unsigned char* luminances) {
+    const __m128i two = _mm_set1_epi16(2);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+      __m128i sums[2];
+      for (int h = 0; h < 2; h++) {
+        __m128i a = _mm_loadu_si128((__m128i const*)(above + 2 * i + 16 * h));
+        __m128i b = _mm_loadu_si128((__m128i const*)(below + 2 * i + 16 * h));
+        sums[h] = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(pairSumsSse2(a), pairSumsSse2(b)),
+                                               two), 2);
+      }
+      _mm_storeu_si128((__m128i*)(luminances + i), _mm_packus_epi16(sums[0], sums[1]));
+    }
+    downsampleRowScalar(above + 2 * i, below + 2 * i, count - i, luminances + i);
+  }
+#endif
+
+#ifdef ZXING_SIMD_AVX2
+  __attribute__ ((target("avx2")))
+  inline __m256i pairSumsAvx2(__m256i bytes) {
+    return _mm256_add_epi16(_mm256_and_si256(bytes, _mm256_set1_epi16(0xFF)),
+                            _mm256_srli_epi16(bytes, 8));
+  }
+
+  // The SSE2 kernel on both lanes; packing interleaves the lanes' 64 bit
+  // halves, which a final permute puts back in order.
+  __attribute__ ((target("avx2")))
+  void downsampleRowAvx2(unsigned char const* above,
+                         unsigned char const* below,
+                         int count,
+                         unsigned char* luminances) {
+    const __m256i two = _mm256_set1_epi16(2);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+      __m256i sums[2];
+      for (int h = 0; h < 2; h++) {
+        __m256i a = _mm256_loadu_si256((__m256i const*)(above + 2 * i + 32 * h));
+        __m256i b = _mm256_loadu_si256((__m256i const*)(below + 2 * i + 32 * h));
+        sums[h] = _mm256_srli_epi16(
+          _mm256_add_epi16(_mm256_add_epi16(pairSumsAvx2(a), pairSumsAvx2(b)), two), 2);
+      }
+      __m256i packed = _mm256_packus_epi16(sums[0], sums[1]);
+      _mm256_storeu_si256((__m256i*)(luminances + i),
+                          _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    downsampleRowScalar(above + 2 * i, below + 2 * i, count - i, luminances + i);
+  }
+#endif
+
+#ifdef ZXING_SIMD_NEON
+  // vpaddl adds the byte pairs; vrshrn rounds, shifts and narrows at once.
+  void downsampleRowNeon(unsigned char const* above,
+                         unsigned char const* below,
+                         int count,
+                         unsigned char* luminances) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+      uint16x8_t first = vaddq_u16(vpaddlq_u8(vld1q_u8(above + 2 * i)),
+                                   vpaddlq_u8(vld1q_u8(below + 2 * i)));
+      uint16x8_t second = vaddq_u16(vpaddlq_u8(vld1q_u8(above + 2 * i + 16)),
+                                    vpaddlq_u8(vld1q_u8(below + 2 * i + 16)));
+      vst1q_u8(luminances + i, vcombine_u8(vrshrn_n_u16(first, 2), vrshrn_n_u16(second, 2)));
+    }
+    downsampleRowScalar(above + 2 * i, below + 2 * i, count - i, luminances + i);
+  }
+#endif
+}
+
+namespace zxing {
+namespace kernels {
+
+void luminanceRow(unsigned char const* pixels,
+                  int count,
+                  LuminanceWeights const& weights,
+                  unsigned char* luminances) {
+  luminanceRow(bestLevel(), pixels, count, weights, luminances);
+}
+
+void luminanceRow(Level level,
+                  unsigned char const* pixels,
+                  int count,
+                  LuminanceWeights const& weights,
+                  unsigned char* luminances) {
+  switch (level) {
+#ifdef ZXING_SIMD_AVX2
+    case AVX2:
+      luminanceRowAvx2(pixels, count, weights, luminances);
+      return;
+#endif
+#ifdef ZXING_SIMD_SSE2
+    case SSE2:
+      luminanceRowSse2(pixels, count, weights, luminances);
+      return;
+#endif
+#ifdef ZXING_SIMD_NEON
+    case NEON:
+      luminanceRowNeon(pixels, count, weights, luminances);
+      return;
+#endif
+    default:
+      luminanceRowScalar(pixels, count, weights, luminances);
+  }
+}
+
+
+void rotateCounterClockwise(unsigned char const* src,
+                            int srcStride,
+                            int width,
+                            int height,
+                            unsigned char* dst,
+                            int dstStride) {
+  rotateCounterClockwise(bestLevel(), src, srcStride, width, height, dst, dstStride);
+}
+
+void rotateCounterClockwise(Level level,
+                            unsigned char const* src,
+                            int srcStride,
+                            int width,
+                            int height,
+                            unsigned char* dst,
+                            int dstStride) {
+  (void)level;
+  bool vector = false;
+#ifdef ZXING_SIMD_SSE2
+  vector = vector || level == SSE2 || level == AVX2;
+#endif
+#ifdef ZXING_SIMD_NEON
+  vector = vector || level == NEON;
+#endif
+  // Tiles go in blocks of BLOCK by BLOCK, so that each block reads and
+  // writes whole cache lines on few enough pages to stay in the TLB.
+  for (int blockY = 0; blockY < height; blockY += BLOCK) {
+    int blockBottom = height - blockY < BLOCK ? height : blockY + BLOCK;
+    for (int blockX = 0; blockX < width; blockX += BLOCK) {
+      int blockRight = width - blockX < BLOCK ? width : blockX + BLOCK;
+      for (int tileY = blockY; tileY < blockBottom; tileY += TILE) {
+        int tileHeight = blockBottom - tileY < TILE ? blockBottom - tileY : TILE;
+        for (int tileX = blockX; tileX < blockRight; tileX += TILE) {
+          int tileWidth = blockRight - tileX < TILE ? blockRight - tileX : TILE;
+          if (!vector || tileWidth < TILE || tileHeight < TILE) {
+            rotateTileScalar(src, srcStride, width, tileX, tileY, tileWidth, tileHeight,
+                             dst, dstStride);
+            continue;
+          }
+#if defined(ZXING_SIMD_SSE2)
+          rotateTileSse2(src, srcStride, width, tileX, tileY, dst, dstStride);
+#elif defined(ZXING_SIMD_NEON)
+          rotateTileNeon(src, srcStride, width, tileX, tileY, dst, dstStride);
+#endif
+        }
+      }
+    }
+  }
+}
+
+
+void downsampleRow(unsigned char const* above,
+                   unsigned char const* below,
+                   int count,
+                   unsigned char* luminances) {
+  downsampleRow(bestLevel(), above, below, count, luminances);
+}
+
+void downsampleRow(Level level,
+                   unsigned char const* above,
+                   unsigned char const* below,
+                   int count,
+                   unsigned char* luminances) {
+  switch (level) {
+#ifdef ZXING_SIMD_AVX2
+    case AVX2:
+      downsampleRowAvx2(above, below, count, luminances);
+      return;
+#endif
+#ifdef ZXING_SIMD_SSE2
+    case SSE2:
+      downsampleRowSse2(above, below, count, luminances);
+      return;
+#endif
+#ifdef ZXING_SIMD_NEON
+    case NEON:
+      downsampleRowNeon(above, below, count, luminances);
+      return;
+#endif
+    default:
+      downsampleRowScalar(above, below, count, luminances);
+  }
+}
+
+}
+}
@@ -0,0 +1,86 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __LUMINANCE_KERNELS_H__
+#define __LUMINANCE_KERNELS_H__
+/*
+ *  LuminanceKernels.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Simd.h>
+
+namespace zxing {
+namespace kernels {
+
+/**
+ * How luminanceRow weighs the four bytes of a 32 bit colour pixel: the
+ * luminance is (channels[0] * byte0 + ... + channels[3] * byte3 + bias) >>
+ * shift. Weights must be at most 32767, and the result must fit in a byte
+ * for every pixel.
+ */
+struct LuminanceWeights {
+  short channels[4];
+  int bias;
+  int shift;
+};
+
+// Converts count 32 bit pixels, 4 bytes each, to 8 bit luminances. Like the
+// binarizer kernels, every level gives exactly the scalar result.
+void luminanceRow(unsigned char const* pixels,
+                  int count,
+                  LuminanceWeights const& weights,
+                  unsigned char* luminances);
+void luminanceRow(simd::Level level,
+                  unsigned char const* pixels,
+                  int count,
+                  LuminanceWeights const& weights,
+                  unsigned char* luminances);
+
+// Turns a width by height block of luminances a quarter counter-clockwise
+// into dst, which is height wide and width high: dst(x, y) is
+// src(width - 1 - y, x). The block is walked in 16x16 tiles, transposed in
+// registers, so that both sides are touched a cache line at a time rather
+// than one byte per line.
+void rotateCounterClockwise(unsigned char const* src,
+                            int srcStride,
+                            int width,
+                            int height,
+                            unsigned char* dst,
+                            int dstStride);
+void rotateCounterClockwise(simd::Level level,
+                            unsigned char const* src,
+                            int srcStride,
+                            int width,
+                            int height,
+                            unsigned char* dst,
+                            int dstStride);
+
+// Halves a pair of rows with a 2x2 box filter: luminances[i] is the mean of
+// above[2i], above[2i + 1], below[2i] and below[2i + 1], rounded to nearest.
+void downsampleRow(unsigned char const* above,
+                   unsigned char const* below,
+                   int count,
+                   unsigned char* luminances);
+void downsampleRow(simd::Level level,
+                   unsigned char const* above,
+                   unsigned char const* below,
+                   int count,
+                   unsigned char* luminances);
+
+}
+}
+
+#endif // __LUMINANCE_KERNELS_H__
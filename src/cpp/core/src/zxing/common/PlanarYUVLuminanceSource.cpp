@@ -0,0 +1,96 @@
+/*
+ *  PlanarYUVLuminanceSource.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/PlanarYUVLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+namespace zxing {
+
+PlanarYUVLuminanceSource::PlanarYUVLuminanceSource(unsigned char* yPlane, int rowStride,
+    int dataWidth, int dataHeight, int left, int top, int width, int height) :
+    yPlane_(yPlane), origin_(top * rowStride + left), xStep_(1), yStep_(rowStride),
+    width_(width), height_(height) {
+
+  if (rowStride < dataWidth) {
+    throw IllegalArgumentException("Row stride is narrower than the image data.");
+  }
+  if (left + width > dataWidth || top + height > dataHeight || top < 0 || left < 0) {
+    throw IllegalArgumentException("Crop rectangle does not fit within image data.");
+  }
+}
+
+PlanarYUVLuminanceSource::PlanarYUVLuminanceSource(unsigned char* yPlane, int origin, int xStep,
+    int yStep, int width, int height) : yPlane_(yPlane), origin_(origin), xStep_(xStep),
+    yStep_(yStep), width_(width), height_(height) {
+}
+
+unsigned char* PlanarYUVLuminanceSource::getRow(int y, unsigned char* row) {
+  if (y < 0 || y >= getHeight()) {
+    throw IllegalArgumentException("Requested row is outside the image.");
+  }
+  if (row == NULL) {
+    row = new unsigned char[width_];
+  }
+  unsigned char const* pixel = yPlane_ + origin_ + y * yStep_;
+  if (xStep_ == 1) {
+    memcpy(row, pixel, width_);
+  } else {
+    // A rotated row runs down a column of the plane.
+    for (int x = 0; x < width_; x++, pixel += xStep_) {
+      row[x] = *pixel;
+    }
+  }
+  return row;
+}
+
+unsigned char* PlanarYUVLuminanceSource::getMatrix() {
+  unsigned char* result = new unsigned char[width_ * height_];
+  for (int y = 0; y < height_; y++) {
+    getRow(y, &result[y * width_]);
+  }
+  return result;
+}
+
+// Borrows the Y plane with its own stride unless rotated.
+LuminanceView PlanarYUVLuminanceSource::getMatrixView() {
+  if (xStep_ == 1 && yStep_ > 0) {
+    return LuminanceView(yPlane_ + origin_, yStep_, width_, height_);
+  }
+  ArrayRef<unsigned char> copy(width_ * height_);
+  for (int y = 0; y < height_; y++) {
+    getRow(y, &copy[y * width_]);
+  }
+  return LuminanceView(copy, width_, height_);
+}
+
+Ref<LuminanceSource> PlanarYUVLuminanceSource::crop(int left, int top, int width, int height) {
+  if (left + width > width_ || top + height > height_ || top < 0 || left < 0) {
+    throw IllegalArgumentException("Crop rectangle does not fit within image data.");
+  }
+  return Ref<LuminanceSource> (new PlanarYUVLuminanceSource(yPlane_,
+      origin_ + left * xStep_ + top * yStep_, xStep_, yStep_, width, height));
+}
+
+// The rotated pixel (x, y) is the pixel (width - 1 - y, x) of this source.
+Ref<LuminanceSource> PlanarYUVLuminanceSource::rotateCounterClockwise() {
+  return Ref<LuminanceSource> (new PlanarYUVLuminanceSource(yPlane_,
+      origin_ + (width_ - 1) * xStep_, yStep_, -xStep_, height_, width_));
+}
+
+} /* namespace */
@@ -0,0 +1,80 @@
+#ifndef __PLANAR_YUV_LUMINANCE_SOURCE__
+#define __PLANAR_YUV_LUMINANCE_SOURCE__
+/*
+ *  PlanarYUVLuminanceSource.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/LuminanceSource.h>
+
+namespace zxing {
+
+/**
+ * Wraps the Y plane of a planar YUV frame, such as NV12 or I420, in place.
+ * Rows of the plane are rowStride bytes apart, which may be more than the
+ * frame's width; the chroma planes that follow are never read. The frame
+ * must outlive the source and everything cropped or rotated from it.
+ *
+ * Crops and rotations are views of the same plane: pixel (x, y) is read
+ * from origin + x * xStep + y * yStep. Only an unrotated source can lend
+ * its rows to the binarizers directly; a rotated one copies them.
+ */
+class PlanarYUVLuminanceSource : public LuminanceSource {
+
+ private:
+  unsigned char* yPlane_;
+  int origin_;
+  int xStep_;
+  int yStep_;
+  int width_;
+  int height_;
+
+  PlanarYUVLuminanceSource(unsigned char* yPlane, int origin, int xStep, int yStep,
+      int width, int height);
+
+ public:
+  PlanarYUVLuminanceSource(unsigned char* yPlane, int rowStride, int dataWidth, int dataHeight,
+      int left, int top, int width, int height);
+
+  unsigned char* getRow(int y, unsigned char* row);
+  unsigned char* getMatrix();
+  LuminanceView getMatrixView();
+
+  bool isCropSupported() const {
+    return true;
+  }
+
+  bool isRotateSupported() const {
+    return true;
+  }
+
+  int getWidth() const {
+    return width_;
+  }
+
+  int getHeight() const {
+    return height_;
+  }
+
+  Ref<LuminanceSource> crop(int left, int top, int width, int height);
+  Ref<LuminanceSource> rotateCounterClockwise();
+
+};
+
+} /* namespace */
+
+#endif
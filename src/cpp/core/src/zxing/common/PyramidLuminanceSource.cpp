@@ -0,0 +1,142 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  PyramidLuminanceSource.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/PyramidLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <zxing/common/LuminanceKernels.h>
+
+namespace zxing {
+
+namespace {
+  // One level of the pyramid, which owns its luminances and lends them out.
+  class DownscaledLuminanceSource : public LuminanceSource {
+   private:
+    ArrayRef<unsigned char> luminances_;
+    int width_;
+    int height_;
+
+   public:
+    // Halves the view with a 2x2 box filter.
+    DownscaledLuminanceSource(LuminanceView const& view) :
+        luminances_((view.getWidth() / 2) * (view.getHeight() / 2)),
+        width_(view.getWidth() / 2), height_(view.getHeight() / 2) {
+      for (int y = 0; y < height_; y++) {
+        kernels::downsampleRow(view.getRow(2 * y), view.getRow(2 * y + 1), width_,
+                               &luminances_[y * width_]);
+      }
+    }
+
+    int getWidth() const {
+      return width_;
+    }
+
+    int getHeight() const {
+      return height_;
+    }
+
+    unsigned char* getRow(int y, unsigned char* row) {
+      if (y < 0 || y >= height_) {
+        throw IllegalArgumentException("Requested row is outside the image.");
+      }
+      if (row == NULL) {
+        row = new unsigned char[width_];
+      }
+      memcpy(row, &luminances_[y * width_], width_);
+      return row;
+    }
+
+    unsigned char* getMatrix() {
+      unsigned char* matrix = new unsigned char[width_ * height_];
+      memcpy(matrix, &luminances_[0], width_ * height_);
+      return matrix;
+    }
+
+    LuminanceView getMatrixView() {
+      return LuminanceView(luminances_, width_, height_);
+    }
+  };
+}
+
+PyramidLuminanceSource::PyramidLuminanceSource(Ref<LuminanceSource> source) :
+    source_(source), levelCount_(1) {
+  int width = source->getWidth();
+  int height = source->getHeight();
+  while (levelCount_ <= MAX_LEVEL &&
+         (width >> levelCount_) >= MINIMUM_DIMENSION &&
+         (height >> levelCount_) >= MINIMUM_DIMENSION) {
+    levelCount_++;
+  }
+  levels_.resize(levelCount_ - 1);
+}
+
+unsigned char* PyramidLuminanceSource::getRow(int y, unsigned char* row) {
+  return source_->getRow(y, row);
+}
+
+unsigned char* PyramidLuminanceSource::getMatrix() {
+  return source_->getMatrix();
+}
+
+LuminanceView PyramidLuminanceSource::getMatrixView() {
+  return source_->getMatrixView();
+}
+
+int PyramidLuminanceSource::getWidth() const {
+  return source_->getWidth();
+}
+
+int PyramidLuminanceSource::getHeight() const {
+  return source_->getHeight();
+}
+
+bool PyramidLuminanceSource::isCropSupported() const {
+  return source_->isCropSupported();
+}
+
+Ref<LuminanceSource> PyramidLuminanceSource::crop(int left, int top, int width, int height) {
+  return Ref<LuminanceSource> (new PyramidLuminanceSource(source_->crop(left, top, width,
+                                                                        height)));
+}
+
+bool PyramidLuminanceSource::isRotateSupported() const {
+  return source_->isRotateSupported();
+}
+
+Ref<LuminanceSource> PyramidLuminanceSource::rotateCounterClockwise() {
+  return Ref<LuminanceSource> (new PyramidLuminanceSource(source_->rotateCounterClockwise()));
+}
+
+int PyramidLuminanceSource::getLevelCount() const {
+  return levelCount_;
+}
+
+Ref<LuminanceSource> PyramidLuminanceSource::getLevel(int level) {
+  if (level < 1 || level >= levelCount_) {
+    throw IllegalArgumentException("Requested level is outside the pyramid.");
+  }
+  Ref<LuminanceSource>& downscaled = levels_[level - 1];
+  if (downscaled.empty()) {
+    Ref<LuminanceSource> above = level == 1 ? source_ : getLevel(level - 1);
+    downscaled = new DownscaledLuminanceSource(above->getMatrixView());
+  }
+  return downscaled;
+}
+
+} /* namespace */
@@ -0,0 +1,71 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __PYRAMID_LUMINANCE_SOURCE_H__
+#define __PYRAMID_LUMINANCE_SOURCE_H__
+/*
+ *  PyramidLuminanceSource.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/LuminanceSource.h>
+
+namespace zxing {
+
+/**
+ * Passes another source through unchanged, and adds half and quarter size
+ * levels for coarse-to-fine detection (see DecodeHints::setCoarseToFine).
+ * Each level is built the first time it is asked for, by averaging 2x2
+ * boxes of the level above it; an odd last row or column is dropped.
+ * Levels whose width or height would fall below MINIMUM_DIMENSION are left
+ * out, so small images have fewer levels or none.
+ */
+class PyramidLuminanceSource : public LuminanceSource {
+
+ public:
+  static const int MAX_LEVEL = 2;
+  static const int MINIMUM_DIMENSION = 40;
+
+ private:
+  Ref<LuminanceSource> source_;
+  int levelCount_;
+  // levels_[i] is level i + 1.
+  std::vector<Ref<LuminanceSource> > levels_;
+
+ public:
+  PyramidLuminanceSource(Ref<LuminanceSource> source);
+
+  unsigned char* getRow(int y, unsigned char* row);
+  unsigned char* getMatrix();
+  LuminanceView getMatrixView();
+
+  int getWidth() const;
+  int getHeight() const;
+
+  // Crops and rotations of the source, with pyramids of their own.
+  bool isCropSupported() const;
+  Ref<LuminanceSource> crop(int left, int top, int width, int height);
+  bool isRotateSupported() const;
+  Ref<LuminanceSource> rotateCounterClockwise();
+
+  int getLevelCount() const;
+  Ref<LuminanceSource> getLevel(int level);
+
+};
+
+} /* namespace */
+
+#endif
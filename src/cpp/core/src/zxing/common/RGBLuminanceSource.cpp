@@ -0,0 +1,114 @@
+/*
+ *  RGBLuminanceSource.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/RGBLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+namespace zxing {
+
+RGBLuminanceSource::RGBLuminanceSource(unsigned char* pixels, int stride, int dataWidth,
+    int dataHeight, int left, int top, int width, int height, Order order, Weighting weighting) :
+    pixels_(pixels + top * stride + left * 4), stride_(stride), width_(width), height_(height),
+    weights_(getWeights(order, weighting)) {
+
+  if (stride < dataWidth * 4) {
+    throw IllegalArgumentException("Row stride is narrower than the image data.");
+  }
+  if (left + width > dataWidth || top + height > dataHeight || top < 0 || left < 0) {
+    throw IllegalArgumentException("Crop rectangle does not fit within image data.");
+  }
+}
+
+RGBLuminanceSource::RGBLuminanceSource(unsigned char* pixels, int stride, int width, int height,
+    kernels::LuminanceWeights const& weights) : pixels_(pixels), stride_(stride), width_(width),
+    height_(height), weights_(weights) {
+}
+
+kernels::LuminanceWeights RGBLuminanceSource::getWeights(Order order, Weighting weighting) {
+  kernels::LuminanceWeights weights;
+  short red, green, blue;
+  if (weighting == WEIGHTED) {
+    red = 306;
+    green = 601;
+    blue = 117;
+    weights.bias = 0x200;
+    weights.shift = 10;
+  } else {
+    // 21846 / 65536 is close enough to 1 / 3 that the floor is exact up to
+    // 3 * 255.
+    red = green = blue = 21846;
+    weights.bias = 0;
+    weights.shift = 16;
+  }
+  weights.channels[0] = order == RGBA ? red : blue;
+  weights.channels[1] = green;
+  weights.channels[2] = order == RGBA ? blue : red;
+  weights.channels[3] = 0;
+  return weights;
+}
+
+unsigned char const* RGBLuminanceSource::convertedRow(int y) {
+  if (luminances_.array_ == 0) {
+    luminances_ = new Array<unsigned char>(width_ * height_);
+    converted_.assign(height_, 0);
+  }
+  unsigned char* row = &luminances_[y * width_];
+  if (!converted_[y]) {
+    kernels::luminanceRow(pixels_ + y * stride_, width_, weights_, row);
+    converted_[y] = 1;
+  }
+  return row;
+}
+
+unsigned char* RGBLuminanceSource::getRow(int y, unsigned char* row) {
+  if (y < 0 || y >= getHeight()) {
+    throw IllegalArgumentException("Requested row is outside the image.");
+  }
+  if (row == NULL) {
+    row = new unsigned char[width_];
+  }
+  memcpy(row, convertedRow(y), width_);
+  return row;
+}
+
+unsigned char* RGBLuminanceSource::getMatrix() {
+  unsigned char* result = new unsigned char[width_ * height_];
+  for (int y = 0; y < height_; y++) {
+    memcpy(result + y * width_, convertedRow(y), width_);
+  }
+  return result;
+}
+
+LuminanceView RGBLuminanceSource::getMatrixView() {
+  for (int y = 0; y < height_; y++) {
+    convertedRow(y);
+  }
+  return LuminanceView(&luminances_[0], width_, width_, height_);
+}
+
+// The crop converts its own rows; it does not see this source's.
+Ref<LuminanceSource> RGBLuminanceSource::crop(int left, int top, int width, int height) {
+  if (left + width > width_ || top + height > height_ || top < 0 || left < 0) {
+    throw IllegalArgumentException("Crop rectangle does not fit within image data.");
+  }
+  return Ref<LuminanceSource> (new RGBLuminanceSource(pixels_ + top * stride_ + left * 4,
+      stride_, width, height, weights_));
+}
+
+} /* namespace */
@@ -0,0 +1,94 @@
+#ifndef __RGB_LUMINANCE_SOURCE__
+#define __RGB_LUMINANCE_SOURCE__
+/*
+ *  RGBLuminanceSource.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/LuminanceSource.h>
+#include <zxing/common/LuminanceKernels.h>
+
+namespace zxing {
+
+/**
+ * Wraps a buffer of 32 bit colour pixels, with rows stride bytes apart. The
+ * buffer must outlive the source and its crops.
+ *
+ * Rows are converted to luminance the first time they are asked for and
+ * kept, so scanning a few rows for 1D codes only converts those rows; the
+ * matrix view converts whatever is left and then lends the result.
+ */
+class RGBLuminanceSource : public LuminanceSource {
+
+ public:
+  // The order of the channels in memory.
+  enum Order {
+    RGBA,
+    BGRA
+  };
+
+  enum Weighting {
+    // (306 R + 601 G + 117 B) / 1024, rounded, as MagickBitmapSource.
+    WEIGHTED,
+    // (R + G + B) / 3, rounded down, like the crude sum the iPhone client's
+    // filters use.
+    SUM
+  };
+
+ private:
+  unsigned char* pixels_;
+  int stride_;
+  int width_;
+  int height_;
+  kernels::LuminanceWeights weights_;
+  ArrayRef<unsigned char> luminances_;
+  std::vector<unsigned char> converted_;
+
+  RGBLuminanceSource(unsigned char* pixels, int stride, int width, int height,
+      kernels::LuminanceWeights const& weights);
+  unsigned char const* convertedRow(int y);
+
+ public:
+  RGBLuminanceSource(unsigned char* pixels, int stride, int dataWidth, int dataHeight,
+      int left, int top, int width, int height, Order order, Weighting weighting = WEIGHTED);
+
+  unsigned char* getRow(int y, unsigned char* row);
+  unsigned char* getMatrix();
+  LuminanceView getMatrixView();
+
+  bool isCropSupported() const {
+    return true;
+  }
+
+  int getWidth() const {
+    return width_;
+  }
+
+  int getHeight() const {
+    return height_;
+  }
+
+  Ref<LuminanceSource> crop(int left, int top, int width, int height);
+
+  static kernels::LuminanceWeights getWeights(Order order, Weighting weighting);
+
+};
+
+} /* namespace */
+
+#endif
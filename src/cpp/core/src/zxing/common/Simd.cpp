@@ -0,0 +1,86 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Simd.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Simd.h>
+
+namespace zxing {
+namespace simd {
+
+namespace {
+#ifdef ZXING_SIMD_AVX2
+  bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }
+#endif
+
+  Level detect() {
+    if (isSupported(AVX2)) {
+      return AVX2;
+    }
+    if (isSupported(SSE2)) {
+      return SSE2;
+    }
+    if (isSupported(NEON)) {
+      return NEON;
+    }
+    return SCALAR;
+  }
+}
+
+bool isSupported(Level level) {
+  switch (level) {
+    case SCALAR:
+      return true;
+#ifdef ZXING_SIMD_SSE2
+    case SSE2:
+      return true;
+#endif
+#ifdef ZXING_SIMD_AVX2
+    case AVX2: {
+      static const bool avx2 = cpuHasAvx2();
+      return avx2;
+    }
+#endif
+#ifdef ZXING_SIMD_NEON
+    case NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+Level bestLevel() {
+  static const Level level = detect();
+  return level;
+}
+
+const char* levelName(Level level) {
+  switch (level) {
+    case SSE2: return "SSE2";
+    case AVX2: return "AVX2";
+    case NEON: return "NEON";
+    default: return "scalar";
+  }
+}
+
+}
+}
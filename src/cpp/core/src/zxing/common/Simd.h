@@ -0,0 +1,64 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __SIMD_H__
+#define __SIMD_H__
+/*
+ *  Simd.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compile-time detection of the vector instruction sets the kernels can
+// use. Define NO_SIMD to build the portable scalar code only.
+
+#ifndef NO_SIMD
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ZXING_SIMD_SSE2 1
+#  endif
+#  if defined(ZXING_SIMD_SSE2) && (defined(__x86_64__) || defined(__i386__)) && \
+      (defined(__clang__) || (defined(__GNUC__) && \
+                              (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+     // AVX2 kernels are compiled with a function target attribute and only
+     // called after a runtime CPU check.
+#    define ZXING_SIMD_AVX2 1
+#  endif
+#  if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define ZXING_SIMD_NEON 1
+#  endif
+#endif
+
+namespace zxing {
+namespace simd {
+
+enum Level {
+  SCALAR = 0,
+  SSE2,
+  AVX2,
+  NEON
+};
+
+// True if kernels for the given level were compiled in and the CPU we are
+// running on can execute them.
+bool isSupported(Level level);
+
+// The fastest supported level. Detected once and cached.
+Level bestLevel();
+
+const char* levelName(Level level);
+
+}
+}
+
+#endif // __SIMD_H__
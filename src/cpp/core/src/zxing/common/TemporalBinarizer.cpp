@@ -0,0 +1,246 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  TemporalBinarizer.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/TemporalBinarizer.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <string.h>
+#include <stdlib.h>
+
+using namespace std;
+using namespace zxing;
+
+const int TemporalBinarizer::DEFAULT_DELTA;
+
+namespace {
+  const int BLOCK_SIZE = 1 << HybridBinarizer::BLOCK_SIZE_POWER;
+
+  // Clears count bits of the matrix's bit stream starting at bit offset.
+  void clearBits(unsigned int* bits, size_t offset, size_t count) {
+    size_t end = offset + count;
+    while (offset < end) {
+      unsigned int shift = offset & 31;
+      size_t n = end - offset < 32 - shift ? end - offset : 32 - shift;
+      unsigned int mask = n == 32 ? 0xFFFFFFFF : ((1u << n) - 1) << shift;
+      bits[offset >> 5] &= ~mask;
+      offset += n;
+    }
+  }
+
+  // Pixel rows of block row y; the last one is shifted up to fit the image.
+  int blockRowOffset(int y, int height) {
+    int yoffset = y * BLOCK_SIZE;
+    return yoffset > height - BLOCK_SIZE ? height - BLOCK_SIZE : yoffset;
+  }
+}
+
+TemporalBinarizer::History::History(int delta) :
+  delta_(delta), width_(0), height_(0), blocksRecomputed_(0), blocksThresholded_(0) {
+  if (delta < 0) {
+    throw IllegalArgumentException("delta must not be negative");
+  }
+}
+
+int TemporalBinarizer::History::getDelta() const {
+  return delta_;
+}
+
+int TemporalBinarizer::History::getBlocksRecomputed() const {
+  return blocksRecomputed_;
+}
+
+int TemporalBinarizer::History::getBlocksThresholded() const {
+  return blocksThresholded_;
+}
+
+int TemporalBinarizer::History::getBlockCount() const {
+  return sums_.size();
+}
+
+TemporalBinarizer::TemporalBinarizer(Ref<LuminanceSource> source, Ref<History> history) :
+  HybridBinarizer(source), history_(history), matrix_(NULL) {
+}
+
+TemporalBinarizer::~TemporalBinarizer() {
+}
+
+Ref<Binarizer> TemporalBinarizer::createBinarizer(Ref<LuminanceSource> source) {
+  return Ref<Binarizer> (new TemporalBinarizer(source,
+                                               Ref<History>(new History(history_->delta_))));
+}
+
+Ref<TemporalBinarizer::History> TemporalBinarizer::getHistory() const {
+  return history_;
+}
+
+Ref<BitMatrix> TemporalBinarizer::getBlackMatrix() {
+  if (matrix_) {
+    return matrix_;
+  }
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  int height = source.getHeight();
+  History& history = *history_;
+  if (width < MINIMUM_DIMENSION || height < MINIMUM_DIMENSION) {
+    history.matrix_ = NULL;
+    matrix_ = HybridBinarizer::getBlackMatrix();
+    return matrix_;
+  }
+  LuminanceView luminances = source.getMatrixView();
+  int subWidth = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  int subHeight = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  if (history.matrix_ && history.width_ == width && history.height_ == height) {
+    matrix_ = nextFrame(luminances, subWidth, subHeight);
+  } else {
+    matrix_ = firstFrame(luminances, subWidth, subHeight);
+  }
+  history.width_ = width;
+  history.height_ = height;
+  history.matrix_ = matrix_;
+  return matrix_;
+}
+
+Ref<BitMatrix> TemporalBinarizer::firstFrame(LuminanceView const& luminances,
+                                             int subWidth,
+                                             int subHeight) {
+  History& history = *history_;
+  int width = luminances.getWidth();
+  int height = luminances.getHeight();
+  int blocks = subWidth * subHeight;
+  history.sums_.resize(blocks);
+  history.mins_.resize(blocks);
+  history.maxs_.resize(blocks);
+  history.blackPoints_.resize(blocks);
+  calculateBlockStatistics(luminances, subWidth, subHeight, width, height,
+                           &history.sums_[0], &history.mins_[0], &history.maxs_[0]);
+  calculateBlackPoints(subWidth, subHeight, &history.sums_[0], &history.mins_[0],
+                       &history.maxs_[0], &history.blackPoints_[0]);
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  thresholdBlockRange(luminances, subWidth, subHeight, width, height,
+                      &history.blackPoints_[0], matrix->getBits(), matrix->getRowStride(),
+                      0, subWidth, 0, subHeight);
+  history.blocksRecomputed_ = blocks;
+  history.blocksThresholded_ = blocks;
+  return matrix;
+}
+
+/**
+ * A block's threshold averages the 5x5 black points around it, with the
+ * window clamped to the grid, so a changed black point dirties the blocks
+ * whose clamped window covers it. When the image size is not a multiple of
+ * the block size, the last block column and row overlap the ones before
+ * them; overlapping blocks are always thresholded together, since their
+ * bits are ORed.
+ */
+Ref<BitMatrix> TemporalBinarizer::nextFrame(LuminanceView const& luminances,
+                                            int subWidth,
+                                            int subHeight) {
+  History& history = *history_;
+  int width = luminances.getWidth();
+  int height = luminances.getHeight();
+  int blocks = subWidth * subHeight;
+
+  vector<int> sums(blocks);
+  vector<int> mins(blocks);
+  vector<int> maxs(blocks);
+  calculateBlockStatistics(luminances, subWidth, subHeight, width, height,
+                           &sums[0], &mins[0], &maxs[0]);
+  vector<unsigned char> dirty(blocks, 0);
+  int recomputed = 0;
+  for (int i = 0; i < blocks; i++) {
+    if (abs(sums[i] - history.sums_[i]) > history.delta_) {
+      history.sums_[i] = sums[i];
+      history.mins_[i] = mins[i];
+      history.maxs_[i] = maxs[i];
+      dirty[i] = 1;
+      recomputed++;
+    }
+  }
+
+  vector<int> blackPoints(blocks);
+  calculateBlackPoints(subWidth, subHeight, &history.sums_[0], &history.mins_[0],
+                       &history.maxs_[0], &blackPoints[0]);
+  for (int y = 0; y < subHeight; y++) {
+    for (int x = 0; x < subWidth; x++) {
+      if (blackPoints[y * subWidth + x] == history.blackPoints_[y * subWidth + x]) {
+        continue;
+      }
+      int top = y - 2 <= 2 ? 0 : y - 2;
+      int bottom = y + 2 >= subHeight - 3 ? subHeight - 1 : y + 2;
+      int left = x - 2 <= 2 ? 0 : x - 2;
+      int right = x + 2 >= subWidth - 3 ? subWidth - 1 : x + 2;
+      for (int yy = top; yy <= bottom; yy++) {
+        memset(&dirty[yy * subWidth + left], 1, right - left + 1);
+      }
+    }
+  }
+  if ((width & (BLOCK_SIZE - 1)) != 0) {
+    for (int y = 0; y < subHeight; y++) {
+      unsigned char* row = &dirty[y * subWidth];
+      row[subWidth - 2] = row[subWidth - 1] = row[subWidth - 2] | row[subWidth - 1];
+    }
+  }
+  if ((height & (BLOCK_SIZE - 1)) != 0) {
+    unsigned char* above = &dirty[(subHeight - 2) * subWidth];
+    unsigned char* below = &dirty[(subHeight - 1) * subWidth];
+    for (int x = 0; x < subWidth; x++) {
+      above[x] = below[x] = above[x] | below[x];
+    }
+  }
+
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  unsigned int* bits = matrix->getBits();
+  size_t rowStride = matrix->getRowStride();
+  memcpy(bits, history.matrix_->getBits(), (rowStride >> 5) * height * sizeof(unsigned int));
+  // Runs of dirty blocks, as (row, first, end) triples. All of them are
+  // cleared before any is thresholded, as overlapping blocks share pixels.
+  vector<int> runs;
+  int thresholded = 0;
+  for (int y = 0; y < subHeight; y++) {
+    for (int x = 0; x < subWidth; x++) {
+      if (!dirty[y * subWidth + x]) {
+        continue;
+      }
+      int end = x;
+      while (end < subWidth && dirty[y * subWidth + end]) {
+        end++;
+      }
+      runs.push_back(y);
+      runs.push_back(x);
+      runs.push_back(end);
+      thresholded += end - x;
+      int left = x * BLOCK_SIZE;
+      int right = end == subWidth ? width : end * BLOCK_SIZE;
+      int yoffset = blockRowOffset(y, height);
+      for (int yy = yoffset; yy < yoffset + BLOCK_SIZE; yy++) {
+        clearBits(bits, (size_t)yy * rowStride + left, right - left);
+      }
+      x = end;
+    }
+  }
+  for (size_t i = 0; i < runs.size(); i += 3) {
+    thresholdBlockRange(luminances, subWidth, subHeight, width, height, &blackPoints[0],
+                        bits, rowStride, runs[i + 1], runs[i + 2], runs[i], runs[i] + 1);
+  }
+
+  history.blackPoints_.swap(blackPoints);
+  history.blocksRecomputed_ = recomputed;
+  history.blocksThresholded_ = thresholded;
+  return matrix;
+}
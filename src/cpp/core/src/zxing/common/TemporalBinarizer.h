@@ -0,0 +1,89 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __TEMPORAL_BINARIZER_H__
+#define __TEMPORAL_BINARIZER_H__
+/*
+ *  TemporalBinarizer.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/common/HybridBinarizer.h>
+
+namespace zxing {
+
+/**
+ * A HybridBinarizer for video, where consecutive frames are nearly the
+ * same. Frames of one stream share a History holding the previous frame's
+ * block statistics, black points and matrix. A block whose luminance sum
+ * moved by more than the history's delta since its statistics were last
+ * taken gets new statistics; the others keep theirs. Only changed blocks,
+ * and blocks within two of one whose black point changed, are thresholded
+ * again; every other bit is copied from the previous frame.
+ *
+ * With a delta of 0 the result equals HybridBinarizer's whenever every
+ * changed pixel also changes its block's sum.
+ */
+class TemporalBinarizer : public HybridBinarizer {
+public:
+  class History : public Counted {
+  private:
+    int delta_;
+    int width_;
+    int height_;
+    std::vector<int> sums_;
+    std::vector<int> mins_;
+    std::vector<int> maxs_;
+    std::vector<int> blackPoints_;
+    Ref<BitMatrix> matrix_;
+    int blocksRecomputed_;
+    int blocksThresholded_;
+
+  public:
+    // delta is in units of a block's luminance sum, i.e. 64 times the mean.
+    History(int delta = DEFAULT_DELTA);
+
+    int getDelta() const;
+    // Blocks given new statistics and blocks thresholded for the last frame.
+    int getBlocksRecomputed() const;
+    int getBlocksThresholded() const;
+    int getBlockCount() const;
+
+    friend class TemporalBinarizer;
+  };
+
+  static const int DEFAULT_DELTA = 2 << (2 * BLOCK_SIZE_POWER);
+
+  // Each frame of a stream gets its own binarizer on the stream's history.
+  TemporalBinarizer(Ref<LuminanceSource> source, Ref<History> history);
+  virtual ~TemporalBinarizer();
+
+  virtual Ref<BitMatrix> getBlackMatrix();
+  // Crops and rotations are not the next frame, so they start a new history.
+  Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+  Ref<History> getHistory() const;
+
+private:
+  Ref<History> history_;
+  Ref<BitMatrix> matrix_;
+
+  Ref<BitMatrix> firstFrame(LuminanceView const& luminances, int subWidth, int subHeight);
+  Ref<BitMatrix> nextFrame(LuminanceView const& luminances, int subWidth, int subHeight);
+};
+
+}
+
+#endif // __TEMPORAL_BINARIZER_H__
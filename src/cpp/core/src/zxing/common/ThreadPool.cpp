@@ -0,0 +1,261 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  ThreadPool.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/ThreadPool.h>
+#include <zxing/Exception.h>
+#include <zxing/FormatException.h>
+#include <zxing/NotFoundException.h>
+#include <zxing/ReaderException.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <zxing/common/reedsolomon/ReedSolomonException.h>
+
+namespace zxing {
+
+ThreadPool::Task::~Task() {
+}
+
+#ifdef NO_THREADS
+
+ThreadPool::ThreadPool(int threads) {
+  (void)threads;
+}
+
+ThreadPool::~ThreadPool() {
+}
+
+int ThreadPool::getThreads() const {
+  return 1;
+}
+
+void ThreadPool::reserve(int threads) {
+  (void)threads;
+}
+
+void ThreadPool::run(Task& task, int count) {
+  for (int i = 0; i < count; i++) {
+    task.run(i);
+  }
+}
+
+ThreadPool& ThreadPool::shared(int threads) {
+  static ThreadPool pool(threads);
+  return pool;
+}
+
+#else
+
+namespace {
+  class MutexLock {
+  private:
+    pthread_mutex_t& mutex_;
+  public:
+    MutexLock(pthread_mutex_t& mutex) : mutex_(mutex) {
+      pthread_mutex_lock(&mutex_);
+    }
+    ~MutexLock() {
+      pthread_mutex_unlock(&mutex_);
+    }
+  };
+
+  pthread_mutex_t sharedMutex = PTHREAD_MUTEX_INITIALIZER;
+
+  template<typename E> void throwAs(std::string const& message) {
+    throw E(message.c_str());
+  }
+
+  // Exceptions cannot be carried from one thread to another before C++11,
+  // so a task's is thrown again on the calling thread as the most derived
+  // of the library's kinds it is.
+  void (*throwerFor(Exception const& e))(std::string const&) {
+    if (dynamic_cast<NotFoundException const*>(&e) != 0) {
+      return &throwAs<NotFoundException>;
+    }
+    if (dynamic_cast<FormatException const*>(&e) != 0) {
+      return &throwAs<FormatException>;
+    }
+    if (dynamic_cast<ReaderException const*>(&e) != 0) {
+      return &throwAs<ReaderException>;
+    }
+    if (dynamic_cast<IllegalArgumentException const*>(&e) != 0) {
+      return &throwAs<IllegalArgumentException>;
+    }
+    if (dynamic_cast<ReedSolomonException const*>(&e) != 0) {
+      return &throwAs<ReedSolomonException>;
+    }
+    return &throwAs<Exception>;
+  }
+}
+
+ThreadPool::ThreadPool(int threads) :
+  task_(0), count_(0), next_(0), remaining_(0), failed_(false), throwFailure_(0),
+  stopping_(false) {
+  pthread_mutex_init(&runMutex_, NULL);
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&workAvailable_, NULL);
+  pthread_cond_init(&workDone_, NULL);
+  reserve(threads);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    MutexLock lock(mutex_);
+    stopping_ = true;
+    pthread_cond_broadcast(&workAvailable_);
+  }
+  for (size_t i = 0; i < workers_.size(); i++) {
+    pthread_join(workers_[i], NULL);
+  }
+  pthread_cond_destroy(&workDone_);
+  pthread_cond_destroy(&workAvailable_);
+  pthread_mutex_destroy(&mutex_);
+  pthread_mutex_destroy(&runMutex_);
+}
+
+int ThreadPool::getThreads() const {
+  return (int)workers_.size() + 1;
+}
+
+void ThreadPool::reserve(int threads) {
+  MutexLock lock(mutex_);
+  while ((int)workers_.size() + 1 < threads) {
+    pthread_t worker;
+    if (pthread_create(&worker, NULL, &ThreadPool::work, this) != 0) {
+      // Carry on with the workers we have; the caller always helps out.
+      return;
+    }
+    workers_.push_back(worker);
+  }
+}
+
+void ThreadPool::run(Task& task, int count) {
+  if (count <= 0) {
+    return;
+  }
+  MutexLock runLock(runMutex_);
+  bool parallel;
+  {
+    MutexLock lock(mutex_);
+    parallel = !workers_.empty() && count > 1;
+    if (parallel) {
+      task_ = &task;
+      count_ = count;
+      next_ = 0;
+      remaining_ = count;
+      failed_ = false;
+      pthread_cond_broadcast(&workAvailable_);
+    }
+  }
+  if (!parallel) {
+    for (int i = 0; i < count; i++) {
+      task.run(i);
+    }
+    return;
+  }
+  drain();
+  bool failed;
+  void (*throwFailure)(std::string const&);
+  std::string failure;
+  {
+    MutexLock lock(mutex_);
+    while (remaining_ > 0) {
+      pthread_cond_wait(&workDone_, &mutex_);
+    }
+    task_ = 0;
+    failed = failed_;
+    throwFailure = throwFailure_;
+    failure.swap(failure_);
+  }
+  if (failed) {
+    throwFailure(failure);
+  }
+}
+
+void ThreadPool::drain() {
+  while (true) {
+    Task* task;
+    int index;
+    {
+      MutexLock lock(mutex_);
+      if (task_ == 0 || next_ >= count_) {
+        return;
+      }
+      task = task_;
+      index = next_++;
+    }
+    bool failed = false;
+    void (*throwFailure)(std::string const&) = 0;
+    std::string failure;
+    try {
+      task->run(index);
+    } catch (Exception const& e) {
+      failed = true;
+      throwFailure = throwerFor(e);
+      failure = e.what();
+    } catch (std::exception const& e) {
+      failed = true;
+      throwFailure = &throwAs<Exception>;
+      failure = e.what();
+    } catch (...) {
+      failed = true;
+      throwFailure = &throwAs<Exception>;
+      failure = "ThreadPool task failed";
+    }
+    MutexLock lock(mutex_);
+    if (failed && !failed_) {
+      failed_ = true;
+      throwFailure_ = throwFailure;
+      failure_ = failure;
+    }
+    if (--remaining_ == 0) {
+      pthread_cond_broadcast(&workDone_);
+    }
+  }
+}
+
+void* ThreadPool::work(void* arg) {
+  ThreadPool* pool = static_cast<ThreadPool*>(arg);
+  while (true) {
+    {
+      MutexLock lock(pool->mutex_);
+      while (!pool->stopping_ && (pool->task_ == 0 || pool->next_ >= pool->count_)) {
+        pthread_cond_wait(&pool->workAvailable_, &pool->mutex_);
+      }
+      if (pool->stopping_) {
+        return NULL;
+      }
+    }
+    pool->drain();
+  }
+}
+
+ThreadPool& ThreadPool::shared(int threads) {
+  static ThreadPool* pool = 0;
+  MutexLock lock(sharedMutex);
+  if (pool == 0) {
+    pool = new ThreadPool(threads);
+  } else {
+    pool->reserve(threads);
+  }
+  return *pool;
+}
+
+#endif
+
+}
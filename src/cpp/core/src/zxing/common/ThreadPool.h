@@ -0,0 +1,88 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+/*
+ *  ThreadPool.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#ifndef NO_THREADS
+#include <pthread.h>
+#endif
+
+namespace zxing {
+
+/**
+ * A small fixed set of worker threads that run the indices of a Task in
+ * parallel. The calling thread takes part in the work, and run() returns
+ * once every index has been processed. Jobs from different callers are run
+ * one after another. Define NO_THREADS to build a pool that runs everything
+ * on the calling thread.
+ */
+class ThreadPool {
+public:
+  class Task {
+  public:
+    virtual ~Task();
+    virtual void run(int index) = 0;
+  };
+
+  // threads counts the calling thread, so ThreadPool(1) starts no workers.
+  ThreadPool(int threads);
+  ~ThreadPool();
+
+  int getThreads() const;
+  // Starts more workers if fewer than threads are available.
+  void reserve(int threads);
+  // Calls task.run(i) for every 0 <= i < count. If any call threw, throws
+  // what the first of them did: a ReaderException, IllegalArgumentException
+  // or other zxing exception of the same kind and message.
+  void run(Task& task, int count);
+
+  // A process wide pool that is never destroyed, grown to at least threads.
+  static ThreadPool& shared(int threads);
+
+private:
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator =(const ThreadPool&);
+
+#ifndef NO_THREADS
+  static void* work(void* pool);
+  void drain();
+
+  pthread_mutex_t runMutex_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t workAvailable_;
+  pthread_cond_t workDone_;
+  std::vector<pthread_t> workers_;
+  Task* task_;
+  int count_;
+  int next_;
+  int remaining_;
+  bool failed_;
+  void (*throwFailure_)(std::string const& message);
+  std::string failure_;
+  bool stopping_;
+#endif
+};
+
+}
+
+#endif // __THREAD_POOL_H__
@@ -28,13 +28,13 @@ using zxing::GenericGF;
 using zxing::GenericGFPoly;
 using zxing::Ref;
 
-Ref<GenericGF> GenericGF::QR_CODE_FIELD_256(new GenericGF(0x011D, 256));
-Ref<GenericGF> GenericGF::DATA_MATRIX_FIELD_256(new GenericGF(0x012D, 256));
-Ref<GenericGF> GenericGF::AZTEC_PARAM(new GenericGF(0x13, 16));
-Ref<GenericGF> GenericGF::AZTEC_DATA_6(new GenericGF(0x43, 64));
+Ref<GenericGF> GenericGF::QR_CODE_FIELD_256(createShared(0x011D, 256));
+Ref<GenericGF> GenericGF::DATA_MATRIX_FIELD_256(createShared(0x012D, 256));
+Ref<GenericGF> GenericGF::AZTEC_PARAM(createShared(0x13, 16));
+Ref<GenericGF> GenericGF::AZTEC_DATA_6(createShared(0x43, 64));
 Ref<GenericGF> GenericGF::AZTEC_DATA_8(GenericGF::DATA_MATRIX_FIELD_256);
-Ref<GenericGF> GenericGF::AZTEC_DATA_10(new GenericGF(0x409, 1024));
-Ref<GenericGF> GenericGF::AZTEC_DATA_12(new GenericGF(0x1069, 4096));
+Ref<GenericGF> GenericGF::AZTEC_DATA_10(createShared(0x409, 1024));
+Ref<GenericGF> GenericGF::AZTEC_DATA_12(createShared(0x1069, 4096));
   
   
 static int INITIALIZATION_THRESHOLD = 0;
@@ -75,6 +75,22 @@ void GenericGF::initialize() {
   initialized_ = true;
 }
   
+/**
+ * The fields above have their tables built up front rather than on first
+ * use, so no decoder ever initializes one while another reads it. They
+ * and the zero and one they hand out are immortal.
+ */
+GenericGF* GenericGF::createShared(int primitive, int size) {
+  GenericGF* field = new GenericGF(primitive, size);
+  field->initialize();
+  field->makeImmortal();
+  field->zero_->makeImmortal();
+  field->zero_->getCoefficients().array_->makeImmortal();
+  field->one_->makeImmortal();
+  field->one_->getCoefficients().array_->makeImmortal();
+  return field;
+}
+
 void GenericGF::checkInit() {
   if (!initialized_) {
     initialize();
@@ -41,6 +41,7 @@ namespace zxing {
     
     void initialize();
     void checkInit();
+    static GenericGF* createShared(int primitive, int size);
     
   public:
     static Ref<GenericGF> AZTEC_DATA_12;
@@ -25,11 +25,12 @@
 #include <vector>
 #include <zxing/common/Array.h>
 #include <zxing/common/Counted.h>
+#include <zxing/common/DecodeContext.h>
 
 namespace zxing {
   class GenericGF;
   
-  class GenericGFPoly : public Counted {
+  class GenericGFPoly : public Counted, public ArenaObject {
   private:
     Ref<GenericGF> field_;
     ArrayRef<int> coefficients_;
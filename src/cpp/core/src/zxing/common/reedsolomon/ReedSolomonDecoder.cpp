@@ -36,45 +36,51 @@ ReedSolomonDecoder::ReedSolomonDecoder(Ref<GenericGF> fld) :
 ReedSolomonDecoder::~ReedSolomonDecoder() {
 }
 
-void ReedSolomonDecoder::decode(ArrayRef<int> received, int twoS) {
-
-  Ref<GenericGFPoly> poly(new GenericGFPoly(field, received));
-
-
-/*
-#ifdef DEBUG
-  cout << "decoding with poly " << *poly << endl;
-#endif
-*/
-
-  ArrayRef<int> syndromeCoefficients(new Array<int> (twoS));
-
-
-#ifdef DEBUG
-  cout << "syndromeCoefficients array = " <<
-      syndromeCoefficients.array_ << endl;
-#endif
+namespace {
+  // What GenericGFPoly::evaluateAt(a) gives for the polynomial with these
+  // coefficients, highest degree first, without making it.
+  int evaluateAt(GenericGF& field, Span<int> coefficients, int a) {
+    int result = coefficients[0];
+    for (size_t i = 1; i < coefficients.size(); i++) {
+      result = GenericGF::addOrSubtract(field.multiply(a, result), coefficients[i]);
+    }
+    return result;
+  }
+}
 
+/**
+ * The syndromes are evaluated straight from received. Those before the
+ * first non-zero one are zero, so their array is only made once a block
+ * turns out to have errors, as are the polynomials.
+ */
+void ReedSolomonDecoder::decode(Span<int> received, int twoS) {
   bool dataMatrix = (field.object_ == GenericGF::DATA_MATRIX_FIELD_256.object_);
-  bool noError = true;
+  ArrayRef<int> syndromeCoefficients;
   for (int i = 0; i < twoS; i++) {
-    int eval = poly->evaluateAt(field->exp(dataMatrix ? i + 1 : i));
-    syndromeCoefficients[syndromeCoefficients->size() - 1 - i] = eval;
+    int eval = evaluateAt(*field, received, field->exp(dataMatrix ? i + 1 : i));
     if (eval != 0) {
-      noError = false;
+      if (syndromeCoefficients.array_ == 0) {
+        syndromeCoefficients.reset(new Array<int>(twoS));
+      }
+      syndromeCoefficients[twoS - 1 - i] = eval;
     }
   }
-  if (noError) {
+  if (syndromeCoefficients.array_ == 0) {
     return;
   }
 
+#ifdef DEBUG
+  cout << "syndromeCoefficients array = " <<
+      syndromeCoefficients.array_ << endl;
+#endif
+
   Ref<GenericGFPoly> syndrome(new GenericGFPoly(field, syndromeCoefficients));
   Ref<GenericGFPoly> monomial = field->buildMonomial(twoS, 1);
   vector<Ref<GenericGFPoly> > sigmaOmega = runEuclideanAlgorithm(monomial, syndrome, twoS);
   ArrayRef<int> errorLocations = findErrorLocations(sigmaOmega[0]);
   ArrayRef<int> errorMagitudes = findErrorMagnitudes(sigmaOmega[1], errorLocations, dataMatrix);
   for (unsigned i = 0; i < errorLocations->size(); i++) {
-    int position = received->size() - 1 - field->log(errorLocations[i]);
+    int position = received.size() - 1 - field->log(errorLocations[i]);
     //TODO: check why the position would be invalid
     if (position < 0 || (size_t)position >= received.size())
       throw IllegalArgumentException("Invalid position (ReedSolomonDecoder)");
@@ -24,6 +24,7 @@
 #include <vector>
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/FixedArray.h>
 #include <zxing/common/reedsolomon/GenericGFPoly.h>
 #include <zxing/common/reedsolomon/GenericGF.h>
 
@@ -37,7 +38,9 @@ private:
 public:
   ReedSolomonDecoder(Ref<GenericGF> fld);
   ~ReedSolomonDecoder();
-  void decode(ArrayRef<int> received, int twoS);
+  // Corrects received in place. A block without errors is checked without
+  // allocating anything.
+  void decode(Span<int> received, int twoS);
 private:
   std::vector<Ref<GenericGFPoly> > runEuclideanAlgorithm(Ref<GenericGFPoly> a, Ref<GenericGFPoly> b, int R);
   ArrayRef<int> findErrorLocations(Ref<GenericGFPoly> errorLocator);
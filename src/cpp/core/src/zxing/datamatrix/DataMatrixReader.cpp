@@ -21,6 +21,7 @@
 
 #include <zxing/datamatrix/DataMatrixReader.h>
 #include <zxing/datamatrix/detector/Detector.h>
+#include <zxing/Exception.h>
 #include <iostream>
 
 namespace zxing {
@@ -33,11 +34,25 @@ DataMatrixReader::DataMatrixReader() :
 }
 
 Ref<Result> DataMatrixReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-  (void)hints;
 #ifdef DEBUG
   cout << "decoding image " << image.object_ << ":\n" << flush;
 #endif
 
+  if (hints.getCoarseToFine()) {
+    for (int level = image->getLevelCount() - 1; level > 0; level--) {
+      try {
+        Detector detector(image->getBlackMatrix());
+        Ref<DetectorResult> detectorResult(
+          detector.detect(image->getLevel(level)->getBlackMatrix(), 1 << level));
+        Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
+        return Ref<Result>(new Result(decoderResult->getText(), decoderResult->getRawBytes(),
+                                      detectorResult->getPoints(), BarcodeFormat_DATA_MATRIX));
+      } catch (zxing::Exception const&) {
+        // Too coarse for the modules, or a false find; try the next level.
+      }
+    }
+  }
+
   Detector detector(image->getBlackMatrix());
 
 
@@ -193,6 +193,9 @@ int Version::buildVersions() {
 					              new ECBlocks(24, new ECB(1, 32)))));
   VERSIONS.push_back(Ref<Version>(new Version(30, 16, 48, 14, 22,
 					              new ECBlocks(28, new ECB(1, 49)))));
+  for (size_t i = 0; i < VERSIONS.size(); i++) {
+    VERSIONS[i]->makeImmortal();
+  }
   return VERSIONS.size();
 }
 }
@@ -24,6 +24,7 @@
 #include <vector>
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/FixedArray.h>
 #include <zxing/datamatrix/Version.h>
 
 namespace zxing {
@@ -32,15 +33,17 @@ namespace datamatrix {
 class DataBlock : public Counted {
 private:
   int numDataCodewords_;
-  ArrayRef<unsigned char> codewords_;
+  // Every block of a symbol is a span of one buffer, which each holds on to.
+  ArrayRef<unsigned char> buffer_;
+  Span<unsigned char> codewords_;
 
-  DataBlock(int numDataCodewords, ArrayRef<unsigned char> codewords);
+  DataBlock(int numDataCodewords, ArrayRef<unsigned char> buffer, Span<unsigned char> codewords);
 
 public:  
   static std::vector<Ref<DataBlock> > getDataBlocks(ArrayRef<unsigned char> rawCodewords, Version *version);
 
   int getNumDataCodewords();
-  ArrayRef<unsigned char> getCodewords();
+  Span<unsigned char> getCodewords();
 };
 
 }
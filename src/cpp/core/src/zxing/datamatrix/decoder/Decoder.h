@@ -24,6 +24,7 @@
 #include <zxing/common/reedsolomon/ReedSolomonDecoder.h>
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/FixedArray.h>
 #include <zxing/common/DecoderResult.h>
 #include <zxing/common/BitMatrix.h>
 
@@ -35,7 +36,7 @@ class Decoder {
 private:
   ReedSolomonDecoder rsDecoder_;
 
-  void correctErrors(ArrayRef<unsigned char> bytes, int numDataCodewords);
+  void correctErrors(Span<unsigned char> bytes, int numDataCodewords);
 
 public:
   Decoder();
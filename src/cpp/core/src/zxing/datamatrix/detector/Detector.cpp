@@ -25,6 +25,7 @@
 #include <zxing/common/detector/math_utils.h>
 #include <sstream>
 #include <cstdlib>
+#include <algorithm>
 
 namespace math_utils = zxing::common::detector::math_utils;
 
@@ -67,7 +68,33 @@ Ref<BitMatrix> Detector::getImage() {
 
 Ref<DetectorResult> Detector::detect() {
   Ref<WhiteRectangleDetector> rectangleDetector_(new WhiteRectangleDetector(image_));
-  std::vector<Ref<ResultPoint> > ResultPoints = rectangleDetector_->detect();
+  return detect(rectangleDetector_->detect());
+}
+
+/**
+ * The white rectangle found in coarse is scaled up, and the full image's
+ * search starts from the largest square centered in it that fits inside
+ * the symbol however it is turned, so it only has a few pixels to grow.
+ */
+Ref<DetectorResult> Detector::detect(Ref<BitMatrix> coarse, int scale) {
+  std::vector<Ref<ResultPoint> > coarsePoints = WhiteRectangleDetector(coarse).detect();
+  float left = coarsePoints[0]->getX();
+  float right = left;
+  float top = coarsePoints[0]->getY();
+  float bottom = top;
+  for (int i = 1; i < 4; i++) {
+    left = std::min(left, coarsePoints[i]->getX());
+    right = std::max(right, coarsePoints[i]->getX());
+    top = std::min(top, coarsePoints[i]->getY());
+    bottom = std::max(bottom, coarsePoints[i]->getY());
+  }
+  int centerX = round((left + right) / 2 * scale);
+  int centerY = round((top + bottom) / 2 * scale);
+  int initSize = round(std::min(right - left, bottom - top) * scale / 2);
+  return detect(WhiteRectangleDetector(image_, initSize, centerX, centerY).detect());
+}
+
+Ref<DetectorResult> Detector::detect(std::vector<Ref<ResultPoint> > const& ResultPoints) {
   Ref<ResultPoint> pointA = ResultPoints[0];
   Ref<ResultPoint> pointB = ResultPoints[1];
   Ref<ResultPoint> pointC = ResultPoints[2];
@@ -63,6 +63,9 @@ class Detector: public Counted {
     bool isValid(Ref<ResultPoint> p);
     int distance(Ref<ResultPoint> a, Ref<ResultPoint> b);
     Ref<ResultPointsAndTransitions> transitionsBetween(Ref<ResultPoint> from, Ref<ResultPoint> to);
+    // The rest of detect(), from the corners of the white rectangle
+    // around the symbol.
+    Ref<DetectorResult> detect(std::vector<Ref<ResultPoint> > const& rectangle);
     int min(int a, int b) {
       return a > b ? b : a;
     }
@@ -83,6 +86,9 @@ class Detector: public Counted {
         int dimensionX, int dimensionY);
 
     Ref<DetectorResult> detect();
+    // Finds the symbol's white rectangle in coarse, this detector's image
+    // scaled down by scale, and the rest in the full image.
+    Ref<DetectorResult> detect(Ref<BitMatrix> coarse, int scale);
 
   private:
     int compare(Ref<ResultPointsAndTransitions> a, Ref<ResultPointsAndTransitions> b);
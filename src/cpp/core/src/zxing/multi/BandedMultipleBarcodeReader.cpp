@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/multi/BandedMultipleBarcodeReader.h>
+#include <algorithm>
+#include <zxing/multi/GenericMultipleBarcodeReader.h>
+#include <zxing/ReaderException.h>
+#include <zxing/ResultPoint.h>
+#include <zxing/common/BandLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+namespace zxing {
+namespace multi {
+
+namespace {
+  // The bounding box of a result's points.
+  struct Bounds {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+  };
+
+  Bounds getBounds(std::vector<Ref<ResultPoint> > const& points) {
+    Bounds bounds = { points[0]->getX(), points[0]->getY(), points[0]->getX(), points[0]->getY() };
+    for (unsigned int i = 1; i < points.size(); i++) {
+      bounds.minX = std::min(bounds.minX, points[i]->getX());
+      bounds.minY = std::min(bounds.minY, points[i]->getY());
+      bounds.maxX = std::max(bounds.maxX, points[i]->getX());
+      bounds.maxY = std::max(bounds.maxY, points[i]->getY());
+    }
+    return bounds;
+  }
+
+  Ref<Result> translateResultPoints(Ref<Result> const& result, int yOffset) {
+    std::vector<Ref<ResultPoint> > const& oldResultPoints = result->getResultPoints();
+    if (oldResultPoints.empty()) {
+      return result;
+    }
+    std::vector<Ref<ResultPoint> > newResultPoints;
+    newResultPoints.reserve(oldResultPoints.size());
+    for (unsigned int i = 0; i < oldResultPoints.size(); i++) {
+      Ref<ResultPoint> const& oldPoint = oldResultPoints[i];
+      newResultPoints.push_back(Ref<ResultPoint>(new ResultPoint(oldPoint->getX(),
+                                                                 oldPoint->getY() + yOffset)));
+    }
+    return Ref<Result>(new Result(result->getText(), result->getRawBytes(), newResultPoints,
+                                  result->getBarcodeFormat()));
+  }
+
+  /**
+   * Two sightings of one symbol have the same text and format, and their
+   * centers lie within half the symbol's size of each other, which two
+   * different symbols' cannot.
+   */
+  bool isSameSymbol(Ref<Result> const& a, Ref<Result> const& b) {
+    if (a->getBarcodeFormat() != b->getBarcodeFormat() ||
+        a->getText()->getText() != b->getText()->getText()) {
+      return false;
+    }
+    if (a->getResultPoints().empty() || b->getResultPoints().empty()) {
+      return true;
+    }
+    Bounds boundsA = getBounds(a->getResultPoints());
+    Bounds boundsB = getBounds(b->getResultPoints());
+    float dx = (boundsA.minX + boundsA.maxX - boundsB.minX - boundsB.maxX) / 2;
+    float dy = (boundsA.minY + boundsA.maxY - boundsB.minY - boundsB.maxY) / 2;
+    float size = std::max(std::max(boundsA.maxX - boundsA.minX, boundsA.maxY - boundsA.minY),
+                          1.0f);
+    return dx * dx + dy * dy < size * size / 4;
+  }
+}
+
+BandedMultipleBarcodeReader::BandedMultipleBarcodeReader(Reader& delegate, size_t maxBytes,
+                                                         int overlap) :
+  delegate_(delegate), maxBytes_(maxBytes), overlap_(overlap)
+{
+  if (overlap < 0) {
+    throw IllegalArgumentException("Band overlap must not be negative.");
+  }
+}
+
+BandedMultipleBarcodeReader::~BandedMultipleBarcodeReader(){}
+
+int BandedMultipleBarcodeReader::getBandHeight(int width, int height) const {
+  size_t rows = maxBytes_ / ((size_t)width * BYTES_PER_PIXEL);
+  if (rows >= (size_t)height) {
+    return height;
+  }
+  if (rows <= (size_t)overlap_) {
+    throw IllegalArgumentException("Memory ceiling leaves no room for bands taller than the overlap.");
+  }
+  return (int)rows;
+}
+
+/**
+ * Results whose points reach below the top of the current band may be
+ * found by it again, so each band's results are checked against those
+ * before they are kept.
+ */
+std::vector<Ref<Result> > BandedMultipleBarcodeReader::decodeMultiple(
+  Ref<BinaryBitmap> image, DecodeHints hints)
+{
+  int width = image->getWidth();
+  int height = image->getHeight();
+  int bandHeight = getBandHeight(width, height);
+  Ref<BandLuminanceSource> band(new BandLuminanceSource(image->getLuminanceSource(),
+                                                        bandHeight));
+  GenericMultipleBarcodeReader reader(delegate_);
+  std::vector<Ref<Result> > results;
+  for (int top = 0; ; top += bandHeight - overlap_) {
+    int rows = std::min(bandHeight, height - top);
+    band->moveTo(top, rows);
+    std::vector<Ref<Result> > found;
+    try {
+      Ref<BinaryBitmap> bitmap(new BinaryBitmap(image->getBinarizer()->createBinarizer(band)));
+      found = reader.decodeMultiple(bitmap, hints);
+    } catch (ReaderException const&) {
+      // Nothing in this band.
+    }
+    size_t carried = results.size();
+    for (size_t i = 0; i < found.size(); i++) {
+      Ref<Result> result = translateResultPoints(found[i], top);
+      bool alreadyFound = false;
+      for (size_t j = 0; j < carried && !alreadyFound; j++) {
+        std::vector<Ref<ResultPoint> > const& points = results[j]->getResultPoints();
+        bool reachesBand = points.empty() || getBounds(points).maxY >= top;
+        alreadyFound = reachesBand && isSameSymbol(results[j], result);
+      }
+      if (!alreadyFound) {
+        results.push_back(result);
+      }
+    }
+    if (top + rows >= height) {
+      break;
+    }
+  }
+  if (results.empty()) {
+    throw ReaderException("No code detected");
+  }
+  return results;
+}
+
+} // End zxing::multi namespace
+} // End zxing namespace
@@ -0,0 +1,69 @@
+#ifndef __BANDED_MULTIPLE_BARCODE_READER_H__
+#define __BANDED_MULTIPLE_BARCODE_READER_H__
+
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <zxing/multi/MultipleBarcodeReader.h>
+#include <zxing/Reader.h>
+
+namespace zxing {
+namespace multi {
+/**
+ * Finds every symbol on images too large to binarize whole, such as pages
+ * scanned at 600 dpi. The image's luminance source is read a row at a time
+ * into a BandLuminanceSource, and each band is binarized on its own, with
+ * the kind of binarizer the image has, and searched like
+ * GenericMultipleBarcodeReader searches a whole image. The image itself is
+ * never binarized, nor its matrix asked for.
+ *
+ * Consecutive bands share overlap rows, so a symbol no taller than that is
+ * whole in at least one band. A symbol found again by a later band, with
+ * the same text and format at the same place, is only reported once.
+ */
+class BandedMultipleBarcodeReader : public MultipleBarcodeReader {
+  private:
+    Reader& delegate_;
+    size_t maxBytes_;
+    int overlap_;
+
+  public:
+    // Rows shared by consecutive bands: an inch at 600 dpi.
+    static const int DEFAULT_OVERLAP = 600;
+    // What a band costs per pixel: a byte of luminance, an eighth of one for
+    // the binarized matrix and a quarter for HybridBinarizer's block
+    // statistics, with the rest left for the readers.
+    static const int BYTES_PER_PIXEL = 2;
+
+    // Bands are sized to keep the reader's own memory under maxBytes; the
+    // luminance source's is not counted.
+    BandedMultipleBarcodeReader(Reader& delegate, size_t maxBytes,
+                                int overlap = DEFAULT_OVERLAP);
+    virtual ~BandedMultipleBarcodeReader();
+
+    // The rows of each band for an image of this size. Throws
+    // IllegalArgumentException when the ceiling does not leave room for
+    // bands taller than the overlap.
+    int getBandHeight(int width, int height) const;
+
+    virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image,
+                                                     DecodeHints hints);
+};
+} // End zxing::multi namespace
+} // End zxing namespace
+
+#endif // __BANDED_MULTIPLE_BARCODE_READER_H__
@@ -60,7 +60,7 @@ void GenericMultipleBarcodeReader::doDecodeMultiple(Ref<BinaryBitmap> image,
   }
   
   results.push_back(translateResultPoints(result, xOffset, yOffset));
-  const std::vector<Ref<ResultPoint> > resultPoints = result->getResultPoints();
+  const std::vector<Ref<ResultPoint> >& resultPoints = result->getResultPoints();
   if (resultPoints.empty()) {
     return;
   }
@@ -72,7 +72,7 @@ void GenericMultipleBarcodeReader::doDecodeMultiple(Ref<BinaryBitmap> image,
   float maxX = 0.0f;
   float maxY = 0.0f;
   for (unsigned int i = 0; i < resultPoints.size(); i++) {
-    Ref<ResultPoint> point = resultPoints[i];
+    Ref<ResultPoint> const& point = resultPoints[i];
     float x = point->getX();
     float y = point->getY();
     if (x < minX) {
@@ -111,14 +111,15 @@ void GenericMultipleBarcodeReader::doDecodeMultiple(Ref<BinaryBitmap> image,
   }
 }
 
-Ref<Result> GenericMultipleBarcodeReader::translateResultPoints(Ref<Result> result, int xOffset, int yOffset){
-  const std::vector<Ref<ResultPoint> > oldResultPoints = result->getResultPoints();
+Ref<Result> GenericMultipleBarcodeReader::translateResultPoints(Ref<Result> const& result, int xOffset, int yOffset){
+  const std::vector<Ref<ResultPoint> >& oldResultPoints = result->getResultPoints();
   if (oldResultPoints.empty()) {
     return result;
   }
   std::vector<Ref<ResultPoint> > newResultPoints;
+  newResultPoints.reserve(oldResultPoints.size());
   for (unsigned int i = 0; i < oldResultPoints.size(); i++) {
-    Ref<ResultPoint> oldPoint = oldResultPoints[i];
+    Ref<ResultPoint> const& oldPoint = oldResultPoints[i];
     newResultPoints.push_back(Ref<ResultPoint>(new ResultPoint(oldPoint->getX() + xOffset, oldPoint->getY() + yOffset)));
   }
   return Ref<Result>(new Result(result->getText(), result->getRawBytes(), newResultPoints, result->getBarcodeFormat()));
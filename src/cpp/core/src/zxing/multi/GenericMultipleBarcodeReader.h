@@ -24,7 +24,7 @@ namespace zxing {
 namespace multi {
 class GenericMultipleBarcodeReader : public MultipleBarcodeReader {
   private:
-    static Ref<Result> translateResultPoints(Ref<Result> result, 
+    static Ref<Result> translateResultPoints(Ref<Result> const& result, 
                                              int xOffset, 
                                              int yOffset);
     void doDecodeMultiple(Ref<BinaryBitmap> image, 
@@ -29,6 +29,7 @@ QRCodeMultiReader::~QRCodeMultiReader(){}
 std::vector<Ref<Result> > QRCodeMultiReader::decodeMultiple(Ref<BinaryBitmap> image, 
   DecodeHints hints)
 {
+  DecodeContext::Scope scope(getDecodeContext());
   std::vector<Ref<Result> > results;
   MultiDetector detector(image->getBlackMatrix());
 
@@ -37,9 +38,7 @@ std::vector<Ref<Result> > QRCodeMultiReader::decodeMultiple(Ref<BinaryBitmap> im
     try {
       Ref<DecoderResult> decoderResult = getDecoder().decode(detectorResult[i]->getBits());
       std::vector<Ref<ResultPoint> > points = detectorResult[i]->getPoints();
-      Ref<Result> result = Ref<Result>(new Result(decoderResult->getText(),
-      decoderResult->getRawBytes(), 
-      points, BarcodeFormat_QR_CODE));
+      Ref<Result> result = makeResult(decoderResult, points);
       // result->putMetadata(ResultMetadataType.BYTE_SEGMENTS, decoderResult->getByteSegments());
       // result->putMetadata(ResultMetadataType.ERROR_CORRECTION_LEVEL, decoderResult->getECLevel().toString());
       results.push_back(result);
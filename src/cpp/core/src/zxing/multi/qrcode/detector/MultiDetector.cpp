@@ -28,6 +28,9 @@ MultiDetector::~MultiDetector(){}
 
 std::vector<Ref<DetectorResult> > MultiDetector::detectMulti(DecodeHints hints){
   Ref<BitMatrix> image = getImage();
+  if (hints.getColumnCopy()) {
+    image->setColumnCopy(true);
+  }
   MultiFinderPatternFinder finder = MultiFinderPatternFinder(image, hints.getResultPointCallback());
   std::vector<Ref<FinderPatternInfo> > info = finder.findMulti(hints);
   std::vector<Ref<DetectorResult> > result;
@@ -30,7 +30,7 @@ const float MultiFinderPatternFinder::MIN_MODULE_COUNT_PER_EDGE = 9;
 const float MultiFinderPatternFinder::DIFF_MODSIZE_CUTOFF_PERCENT = 0.05f;
 const float MultiFinderPatternFinder::DIFF_MODSIZE_CUTOFF = 0.5f;
 
-bool compareModuleSize(Ref<FinderPattern> a, Ref<FinderPattern> b){
+bool compareModuleSize(Ref<FinderPattern> const& a, Ref<FinderPattern> const& b){
     float value = a->getEstimatedModuleSize() - b->getEstimatedModuleSize();
     return value < 0.0;
 }
@@ -62,36 +62,36 @@ std::vector<Ref<FinderPatternInfo> > MultiFinderPatternFinder::findMulti(DecodeH
   }
 
   int stateCount[5];
+  std::vector<uint64_t> row(image->getRowWordCount());
   for (int i = iSkip - 1; i < maxI; i += iSkip) {
-    // Get a row of black/white values
+    // Get a row of black/white values, and walk it a run at a time
+    image->getRowWords(i, &row[0]);
     stateCount[0] = 0;
     stateCount[1] = 0;
     stateCount[2] = 0;
     stateCount[3] = 0;
     stateCount[4] = 0;
     int currentState = 0;
-    for (int j = 0; j < maxJ; j++) {
-      if (image->get(j, i)) {
-        // Black pixel
+    bool black = (row[0] & 1) != 0;
+    for (int j = 0, runEnd; j < maxJ; j = runEnd, black = !black) {
+      runEnd = (int)BitMatrix::getRunEnd(&row[0], j, maxJ);
+      int run = runEnd - j;
+      if (black) {
         if ((currentState & 1) == 1) { // Counting white pixels
           currentState++;
         }
-        stateCount[currentState]++;
-      } else { // White pixel
+        stateCount[currentState] += run;
+      } else { // White run
         if ((currentState & 1) == 0) { // Counting black pixels
           if (currentState == 4) { // A winner?
             if (foundPatternCross(stateCount)) { // Yes
               bool confirmed = handlePossibleCenter(stateCount, i, j);
-              if (!confirmed) {
-                do { // Advance to next black pixel
-                  j++;
-                } while (j < maxJ && !image->get(j, i));
-                  j--; // back up to that last white pixel
-              }
-              // Clear state to start looking again
-              currentState = 0;
+              // Clear state to start looking again; unless confirmed, the
+              // rest of this run is skipped up to the next black pixel
+              int rest = confirmed ? run - 1 : 0;
+              currentState = rest > 0 ? 1 : 0;
               stateCount[0] = 0;
-              stateCount[1] = 0;
+              stateCount[1] = rest;
               stateCount[2] = 0;
               stateCount[3] = 0;
               stateCount[4] = 0;
@@ -99,15 +99,15 @@ std::vector<Ref<FinderPatternInfo> > MultiFinderPatternFinder::findMulti(DecodeH
               stateCount[0] = stateCount[2];
               stateCount[1] = stateCount[3];
               stateCount[2] = stateCount[4];
-              stateCount[3] = 1;
+              stateCount[3] = run;
               stateCount[4] = 0;
               currentState = 3;
             }
           } else {
-            stateCount[++currentState]++;
+            stateCount[++currentState] += run;
           }
         } else { // Counting white pixels
-            stateCount[currentState]++;
+            stateCount[currentState] += run;
         }
       }
     } // for j=...
@@ -119,8 +119,7 @@ std::vector<Ref<FinderPatternInfo> > MultiFinderPatternFinder::findMulti(DecodeH
   std::vector<std::vector<Ref<FinderPattern> > > patternInfo = selectBestPatterns();
   std::vector<Ref<FinderPatternInfo> > result;
   for (unsigned int i = 0; i < patternInfo.size(); i++) {
-    std::vector<Ref<FinderPattern> > pattern = patternInfo[i];
-    FinderPatternFinder::orderBestPatterns(pattern);
+    std::vector<Ref<FinderPattern> > pattern = FinderPatternFinder::orderBestPatterns(patternInfo[i]);
     result.push_back(Ref<FinderPatternInfo>(new FinderPatternInfo(pattern)));
   }
   return result;
@@ -166,9 +165,9 @@ std::vector<std::vector<Ref<FinderPattern> > > MultiFinderPatternFinder::selectB
   */
 
   for (int i1 = 0; i1 < (size - 2); i1++) {
-    Ref<FinderPattern> p1 = possibleCenters[i1];
+    Ref<FinderPattern> const& p1 = possibleCenters[i1];
     for (int i2 = i1 + 1; i2 < (size - 1); i2++) {
-      Ref<FinderPattern> p2 = possibleCenters[i2];
+      Ref<FinderPattern> const& p2 = possibleCenters[i2];
       // Compare the expected module sizes; if they are really off, skip
       float vModSize12 = (p1->getEstimatedModuleSize() - p2->getEstimatedModuleSize()) / std::min(p1->getEstimatedModuleSize(), p2->getEstimatedModuleSize());
       float vModSize12A = abs(p1->getEstimatedModuleSize() - p2->getEstimatedModuleSize());
@@ -178,7 +177,7 @@ std::vector<std::vector<Ref<FinderPattern> > > MultiFinderPatternFinder::selectB
         break;
       }
       for (int i3 = i2 + 1; i3 < size; i3++) {
-        Ref<FinderPattern> p3 = possibleCenters[i3];
+        Ref<FinderPattern> const& p3 = possibleCenters[i3];
         // Compare the expected module sizes; if they are really off, skip
         float vModSize23 = (p2->getEstimatedModuleSize() - p3->getEstimatedModuleSize()) / std::min(p2->getEstimatedModuleSize(), p3->getEstimatedModuleSize());
         float vModSize23A = abs(p2->getEstimatedModuleSize() - p3->getEstimatedModuleSize());
@@ -191,12 +190,14 @@ std::vector<std::vector<Ref<FinderPattern> > > MultiFinderPatternFinder::selectB
         test.push_back(p1);
         test.push_back(p2);
         test.push_back(p3);
-        FinderPatternFinder::orderBestPatterns(test);
+        test = FinderPatternFinder::orderBestPatterns(test);
         // Calculate the distances: a = topleft-bottomleft, b=topleft-topright, c = diagonal
-        Ref<FinderPatternInfo> info = Ref<FinderPatternInfo>(new FinderPatternInfo(test));
-        float dA = FinderPatternFinder::distance(info->getTopLeft(), info->getBottomLeft());
-        float dC = FinderPatternFinder::distance(info->getTopRight(), info->getBottomLeft());
-        float dB = FinderPatternFinder::distance(info->getTopLeft(), info->getTopRight());
+        Point bottomLeft = test[0]->getPoint();
+        Point topLeft = test[1]->getPoint();
+        Point topRight = test[2]->getPoint();
+        float dA = ResultPoint::distance(topLeft, bottomLeft);
+        float dC = ResultPoint::distance(topRight, bottomLeft);
+        float dB = ResultPoint::distance(topLeft, topRight);
         // Check the sizes
         float estimatedModuleCount = (dA + dB) / (p1->getEstimatedModuleSize() * 2.0f);
         if (estimatedModuleCount > MAX_MODULE_COUNT_PER_EDGE || estimatedModuleCount < MIN_MODULE_COUNT_PER_EDGE) {
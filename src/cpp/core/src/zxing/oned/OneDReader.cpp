@@ -21,6 +21,7 @@
 #include "OneDReader.h"
 #include <zxing/ReaderException.h>
 #include <zxing/oned/OneDResultPoint.h>
+#include <algorithm>
 #include <math.h>
 #include <limits.h>
 
@@ -62,10 +63,14 @@ namespace zxing {
       return result;
     }
 
+    namespace {
+      // Scan lines are binarized this many at a time on each side of the middle.
+      const int ROW_BATCH = 4;
+    }
+
     Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
       int width = image->getWidth();
       int height = image->getHeight();
-      Ref<BitArray> row(new BitArray(width));
       int middle = height >> 1;
       bool tryHarder = hints.getTryHarder();
       int rowStep = (int)fmax(1, height >> (tryHarder ? 8 : 5));
@@ -76,6 +81,12 @@ namespace zxing {
         maxLines = 15; // 15 rows spaced 1/32 apart is roughly the middle half of the image
       }
 
+      // Rows above and below the middle are visited in turn, each side at a
+      // fixed step, so each side is binarized in batches. batches[i][j] holds
+      // the row rowStepsAboveOrBelow == firsts[i] + j on side i.
+      vector<Ref<BitArray> > batches[2];
+      int firsts[2] = { 0, 1 };
+
       for (int x = 0; x < maxLines; x++) {
         // Scanning from the middle out. Determine which row we're looking at next:
         int rowStepsAboveOrBelow = (x + 1) >> 1;
@@ -87,11 +98,17 @@ namespace zxing {
         }
 
         // Estimate black point for this row and load it:
-        try {
-          row = image->getBlackRow(rowNumber, row);
-        } catch (ReaderException const& re) {
-          continue;
-        } catch (IllegalArgumentException const& re) {
+        vector<Ref<BitArray> >& batch = batches[isAbove ? 0 : 1];
+        int& first = firsts[isAbove ? 0 : 1];
+        if (rowStepsAboveOrBelow >= first + (int)batch.size()) {
+          int inImage = (isAbove ? height - 1 - rowNumber : rowNumber) / rowStep + 1;
+          int inScan = (maxLines - 1 - x) / 2 + 1;
+          int count = min(ROW_BATCH, min(inImage, inScan));
+          image->getBlackRows(rowNumber, count, isAbove ? rowStep : -rowStep, batch);
+          first = rowStepsAboveOrBelow;
+        }
+        Ref<BitArray> row = batch[rowStepsAboveOrBelow - first];
+        if (row == NULL) {
           continue;
         }
 
@@ -178,20 +195,19 @@ namespace zxing {
       bool isWhite = !row->get(start);
       int counterPosition = 0;
       int i = start;
+      // A run at a time, up to the next pixel of the other colour.
       while (i < end) {
-        bool pixel = row->get(i);
-        if (pixel ^ isWhite) { // that is, exactly one is true
-          counters[counterPosition]++;
-        } else {
-          counterPosition++;
-          if (counterPosition == numCounters) {
-            break;
-          } else {
-            counters[counterPosition] = 1;
-            isWhite ^= true; // isWhite = !isWhite;
-          }
+        int next = isWhite ? row->getNextSet(i) : row->getNextUnset(i);
+        counters[counterPosition] = next - i;
+        i = next;
+        if (i == end) {
+          break;
+        }
+        counterPosition++;
+        if (counterPosition == numCounters) {
+          break;
         }
-        i++;
+        isWhite = !isWhite;
       }
       // If we read fully the last section of pixels and filled up our counters -- or filled
       // the last counter but ran off the side of the image, OK. Otherwise, a problem.
@@ -172,22 +172,19 @@ namespace zxing {
         counters[i] = 0;
       }
       int width = row->getSize();
-      bool isWhite = false;
-      while (rowOffset < width) {
-        isWhite = !row->get(rowOffset);
-        if (whiteFirst == isWhite) {
-          break;
-        }
-        rowOffset++;
-      }
+      rowOffset = whiteFirst ? row->getNextUnset(rowOffset) : row->getNextSet(rowOffset);
+      bool isWhite = whiteFirst;
 
+      // A run at a time; a pattern is only tried once the run after it
+      // starts, so one ending at the edge of the row is not.
       int counterPosition = 0;
       int patternStart = rowOffset;
-      for (int x = rowOffset; x < width; x++) {
-        bool pixel = row->get(x);
-        if (pixel ^ isWhite) {
-          counters[counterPosition]++;
-        } else {
+      int x = rowOffset;
+      while (x < width) {
+        int next = isWhite ? row->getNextSet(x) : row->getNextUnset(x);
+        counters[counterPosition] = next - x;
+        x = next;
+        if (x < width) {
           if (counterPosition == patternLength - 1) {
             if (patternMatchVariance(counters, countersCount, pattern,
                 MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
@@ -205,7 +202,6 @@ namespace zxing {
           } else {
             counterPosition++;
           }
-          counters[counterPosition] = 1;
           isWhite = !isWhite;
         }
       }
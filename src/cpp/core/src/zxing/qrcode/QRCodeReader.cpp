@@ -21,6 +21,7 @@
 
 #include <zxing/qrcode/QRCodeReader.h>
 #include <zxing/qrcode/detector/Detector.h>
+#include <zxing/Exception.h>
 
 #include <iostream>
 
@@ -36,6 +37,21 @@ namespace zxing {
 #ifdef DEBUG
 			cout << "decoding image " << image.object_ << ":\n" << flush;
 #endif
+			DecodeContext::Scope scope(context_);
+			
+			if (hints.getCoarseToFine()) {
+				for (int level = image->getLevelCount() - 1; level > 0; level--) {
+					try {
+						Detector detector(image->getBlackMatrix());
+						Ref<DetectorResult> detectorResult(
+							detector.detect(image->getLevel(level)->getBlackMatrix(), 1 << level, hints));
+						Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
+						return makeResult(decoderResult, detectorResult->getPoints());
+					} catch (zxing::Exception const&) {
+						// Too coarse for the modules, or a false find; try the next level.
+					}
+				}
+			}
 			
 			Detector detector(image->getBlackMatrix());
 			
@@ -67,8 +83,7 @@ namespace zxing {
 			cout << "(4) decoded, have decoderResult " << decoderResult.object_ << "\n" << flush;
 #endif
 			
-			Ref<Result> result(
-							   new Result(decoderResult->getText(), decoderResult->getRawBytes(), points, BarcodeFormat_QR_CODE));
+			Ref<Result> result(makeResult(decoderResult, points));
 #ifdef DEBUG
 			cout << "(5) created result " << result.object_ << ", returning\n" << flush;
 #endif
@@ -82,5 +97,23 @@ namespace zxing {
     Decoder& QRCodeReader::getDecoder() {
         return decoder_;
     }
+
+    DecodeContext& QRCodeReader::getDecodeContext() {
+        return context_;
+    }
+
+    Ref<Result> QRCodeReader::makeResult(Ref<DecoderResult> decoderResult,
+                                         std::vector<Ref<ResultPoint> > const& points) {
+        DecodeContext::HeapScope heap;
+        std::vector<Ref<ResultPoint> > resultPoints;
+        for (size_t i = 0; i < points.size(); i++) {
+            resultPoints.push_back(Ref<ResultPoint>(new ResultPoint(points[i]->getX(), points[i]->getY())));
+        }
+        ArrayRef<unsigned char> rawBytes = decoderResult->getRawBytes();
+        if (rawBytes.array_ != 0) {
+            rawBytes = new Array<unsigned char>(rawBytes->values());
+        }
+        return Ref<Result>(new Result(decoderResult->getText(), rawBytes, resultPoints, BarcodeFormat_QR_CODE));
+    }
 	}
 }
@@ -24,6 +24,7 @@
 #include <zxing/Reader.h>
 #include <zxing/qrcode/decoder/Decoder.h>
 #include <zxing/DecodeHints.h>
+#include <zxing/common/DecodeContext.h>
 
 namespace zxing {
 	namespace qrcode {
@@ -31,15 +32,24 @@ namespace zxing {
 		class QRCodeReader : public Reader {
 		private:
 			Decoder decoder_;
+			DecodeContext context_;
 			
     protected:
       Decoder& getDecoder();
+      // The result, with copies of the points and raw bytes made on the
+      // heap, so it does not keep the decode's arena from being reused.
+      static Ref<Result> makeResult(Ref<DecoderResult> decoderResult,
+                                    std::vector<Ref<ResultPoint> > const& points);
 
 		public:
 			QRCodeReader();
 			virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
 			virtual ~QRCodeReader();
 			
+			// Where each decode's points, transforms, polynomials and blocks
+			// come from, and how many heap allocations that saved.
+			DecodeContext& getDecodeContext();
+			
 		};
 	}
 }
@@ -551,6 +551,9 @@ int Version::buildVersions() {
                                                new ECB(34, 25)),
                                   new ECBlocks(30, new ECB(20, 15),
                                                new ECB(61, 16)))));
+  for (size_t i = 0; i < VERSIONS.size(); i++) {
+    VERSIONS[i]->makeImmortal();
+  }
   return VERSIONS.size();
 }
 }
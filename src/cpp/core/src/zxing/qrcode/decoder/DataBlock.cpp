@@ -26,15 +26,16 @@ namespace qrcode {
 
 using namespace std;
 
-DataBlock::DataBlock(int numDataCodewords, ArrayRef<unsigned char> codewords) :
-    numDataCodewords_(numDataCodewords), codewords_(codewords) {
+DataBlock::DataBlock(int numDataCodewords, ArrayRef<unsigned char> buffer,
+                     Span<unsigned char> codewords) :
+    numDataCodewords_(numDataCodewords), buffer_(buffer), codewords_(codewords) {
 }
 
 int DataBlock::getNumDataCodewords() {
   return numDataCodewords_;
 }
 
-ArrayRef<unsigned char> DataBlock::getCodewords() {
+Span<unsigned char> DataBlock::getCodewords() {
   return codewords_;
 }
 
@@ -56,16 +57,26 @@ std::vector<Ref<DataBlock> > DataBlock::getDataBlocks(ArrayRef<unsigned char> ra
   }
 
   // Now establish DataBlocks of the appropriate size and number of data codewords
+  // in spans of one buffer, as big as all of them together
+  int totalCodewords = 0;
+  for (size_t j = 0; j < ecBlockArray.size(); j++) {
+    totalCodewords += ecBlockArray[j]->getCount() *
+        (ecBlocks.getECCodewords() + ecBlockArray[j]->getDataCodewords());
+  }
+  ArrayRef<unsigned char> buffer(totalCodewords);
+  Span<unsigned char> bufferSpan(buffer);
   std::vector<Ref<DataBlock> > result(totalBlocks);
   int numResultBlocks = 0;
+  int bufferOffset = 0;
   for (size_t j = 0; j < ecBlockArray.size(); j++) {
     ECB *ecBlock = ecBlockArray[j];
     for (int i = 0; i < ecBlock->getCount(); i++) {
       int numDataCodewords = ecBlock->getDataCodewords();
       int numBlockCodewords = ecBlocks.getECCodewords() + numDataCodewords;
-      ArrayRef<unsigned char> buffer(numBlockCodewords);
-      Ref<DataBlock> blockRef(new DataBlock(numDataCodewords, buffer));
+      Span<unsigned char> codewords(bufferSpan.subspan(bufferOffset, numBlockCodewords));
+      Ref<DataBlock> blockRef(new DataBlock(numDataCodewords, buffer, codewords));
       result[numResultBlocks++] = blockRef;
+      bufferOffset += numBlockCodewords;
     }
   }
 
@@ -22,26 +22,30 @@
 
 #include <vector>
 #include <zxing/common/Counted.h>
+#include <zxing/common/DecodeContext.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/FixedArray.h>
 #include <zxing/qrcode/Version.h>
 #include <zxing/qrcode/ErrorCorrectionLevel.h>
 
 namespace zxing {
 namespace qrcode {
 
-class DataBlock : public Counted {
+class DataBlock : public Counted, public ArenaObject {
 private:
   int numDataCodewords_;
-  ArrayRef<unsigned char> codewords_;
+  // Every block of a symbol is a span of one buffer, which each holds on to.
+  ArrayRef<unsigned char> buffer_;
+  Span<unsigned char> codewords_;
 
-  DataBlock(int numDataCodewords, ArrayRef<unsigned char> codewords);
+  DataBlock(int numDataCodewords, ArrayRef<unsigned char> buffer, Span<unsigned char> codewords);
 
 public:
   static std::vector<Ref<DataBlock> >
   getDataBlocks(ArrayRef<unsigned char> rawCodewords, Version *version, ErrorCorrectionLevel &ecLevel);
 
   int getNumDataCodewords();
-  ArrayRef<unsigned char> getCodewords();
+  Span<unsigned char> getCodewords();
 };
 
 }
@@ -152,6 +152,9 @@ int DataMask::buildDataMasks() {
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask101()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask110()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask111()));
+  for (size_t i = 0; i < DATA_MASKS.size(); i++) {
+    DATA_MASKS[i]->makeImmortal();
+  }
   return DATA_MASKS.size();
 }
 
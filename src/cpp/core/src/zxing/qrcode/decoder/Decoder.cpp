@@ -36,9 +36,14 @@ Decoder::Decoder() :
     rsDecoder_(GenericGF::QR_CODE_FIELD_256) {
 }
 
-void Decoder::correctErrors(ArrayRef<unsigned char> codewordBytes, int numDataCodewords) {
-  int numCodewords = codewordBytes->size();
-  ArrayRef<int> codewordInts(numCodewords);
+namespace {
+  // No Reed-Solomon block over GF(256) is longer than this.
+  const size_t MAX_BLOCK_CODEWORDS = 255;
+}
+
+void Decoder::correctErrors(Span<unsigned char> codewordBytes, int numDataCodewords) {
+  int numCodewords = codewordBytes.size();
+  FixedArray<int, MAX_BLOCK_CODEWORDS> codewordInts(numCodewords);
   for (int i = 0; i < numCodewords; i++) {
     codewordInts[i] = codewordBytes[i] & 0xff;
   }
@@ -84,7 +89,7 @@ Ref<DecoderResult> Decoder::decode(Ref<BitMatrix> bits) {
   // Error-correct and copy data blocks together into a stream of bytes
   for (size_t j = 0; j < dataBlocks.size(); j++) {
     Ref<DataBlock> dataBlock(dataBlocks[j]);
-    ArrayRef<unsigned char> codewordBytes = dataBlock->getCodewords();
+    Span<unsigned char> codewordBytes = dataBlock->getCodewords();
     int numDataCodewords = dataBlock->getNumDataCodewords();
     correctErrors(codewordBytes, numDataCodewords);
     for (int i = 0; i < numDataCodewords; i++) {
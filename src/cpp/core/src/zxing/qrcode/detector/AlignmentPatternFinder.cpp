@@ -54,37 +54,31 @@ float AlignmentPatternFinder::crossCheckVertical(size_t startI, size_t centerJ,
   vector<int> stateCount(3, 0);
 
 
-  // Start counting up from center
+  // Start counting up from center, a run at a time, with each run cut off
+  // just past the most the loops it replaces would have counted
   int i = startI;
-  while (i >= 0 && image_->get(centerJ, i) && stateCount[1] <= maxCount) {
-    stateCount[1]++;
-    i--;
-  }
+  stateCount[1] = image_->getColumnRunUp(centerJ, i, true, maxCount + 1);
+  i -= stateCount[1];
   // If already too many modules in this state or ran off the edge:
   if (i < 0 || stateCount[1] > maxCount) {
     return NAN;
   }
-  while (i >= 0 && !image_->get(centerJ, i) && stateCount[0] <= maxCount) {
-    stateCount[0]++;
-    i--;
-  }
+  stateCount[0] = image_->getColumnRunUp(centerJ, i, false, maxCount + 1);
+  i -= stateCount[0];
   if (stateCount[0] > maxCount) {
     return NAN;
   }
 
   // Now also count down from center
   i = startI + 1;
-  while (i < maxI && image_->get(centerJ, i) && stateCount[1] <= maxCount) {
-    stateCount[1]++;
-    i++;
-  }
+  int run = image_->getColumnRunDown(centerJ, i, maxI, true, maxCount + 1 - stateCount[1]);
+  stateCount[1] += run;
+  i += run;
   if (i == maxI || stateCount[1] > maxCount) {
     return NAN;
   }
-  while (i < maxI && !image_->get(centerJ, i) && stateCount[2] <= maxCount) {
-    stateCount[2]++;
-    i++;
-  }
+  stateCount[2] = image_->getColumnRunDown(centerJ, i, maxI, false, maxCount + 1);
+  i += stateCount[2];
   if (stateCount[2] > maxCount) {
     return NAN;
   }
@@ -52,21 +52,58 @@ Ref<ResultPointCallback> Detector::getResultPointCallback() const {
 
 Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
   callback_ = hints.getResultPointCallback();
+  if (hints.getColumnCopy()) {
+    image_->setColumnCopy(true);
+  }
   FinderPatternFinder finder(image_, hints.getResultPointCallback());
   Ref<FinderPatternInfo> info(finder.find(hints));
   return processFinderPatternInfo(info);
 }
 
+Ref<DetectorResult> Detector::detect(Ref<BitMatrix> coarse, int scale, DecodeHints const& hints) {
+  callback_ = hints.getResultPointCallback();
+  if (hints.getColumnCopy()) {
+    coarse->setColumnCopy(true);
+    image_->setColumnCopy(true);
+  }
+  // Coarse points would mean nothing to the callback; the refined ones are
+  // reported instead.
+  FinderPatternFinder coarseFinder(coarse, Ref<ResultPointCallback>());
+  Ref<FinderPatternInfo> coarseInfo(coarseFinder.find(hints));
+  FinderPatternFinder finder(image_, callback_);
+  Ref<FinderPattern> coarsePatterns[] = {
+    coarseInfo->getBottomLeft(), coarseInfo->getTopLeft(), coarseInfo->getTopRight()
+  };
+  vector<Ref<FinderPattern> > patterns;
+  for (int i = 0; i < 3; i++) {
+    float x = coarsePatterns[i]->getX() * scale;
+    float y = coarsePatterns[i]->getY() * scale;
+    float moduleSize = coarsePatterns[i]->getEstimatedModuleSize() * scale;
+    Ref<FinderPattern> pattern(finder.refineCenter(x, y, moduleSize));
+    if (pattern.empty()) {
+      pattern = new FinderPattern(x, y, moduleSize);
+    }
+    if (callback_ != 0) {
+      callback_->foundPossibleResultPoint(*pattern);
+    }
+    patterns.push_back(pattern);
+  }
+  return processFinderPatternInfo(Ref<FinderPatternInfo>(new FinderPatternInfo(patterns)));
+}
+
 Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> info){
   Ref<FinderPattern> topLeft(info->getTopLeft());
   Ref<FinderPattern> topRight(info->getTopRight());
   Ref<FinderPattern> bottomLeft(info->getBottomLeft());
+  Point topLeftPoint = topLeft->getPoint();
+  Point topRightPoint = topRight->getPoint();
+  Point bottomLeftPoint = bottomLeft->getPoint();
 
-  float moduleSize = calculateModuleSize(topLeft, topRight, bottomLeft);
+  float moduleSize = calculateModuleSize(topLeftPoint, topRightPoint, bottomLeftPoint);
   if (moduleSize < 1.0f) {
     throw zxing::ReaderException("bad module size");
   }
-  int dimension = computeDimension(topLeft, topRight, bottomLeft, moduleSize);
+  int dimension = computeDimension(topLeftPoint, topRightPoint, bottomLeftPoint, moduleSize);
   Version *provisionalVersion = Version::getProvisionalVersionForDimension(dimension);
   int modulesBetweenFPCenters = provisionalVersion->getDimensionForVersion() - 7;
 
@@ -76,15 +113,15 @@ Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> in
 
 
     // Guess where a "bottom right" finder pattern would have been
-    float bottomRightX = topRight->getX() - topLeft->getX() + bottomLeft->getX();
-    float bottomRightY = topRight->getY() - topLeft->getY() + bottomLeft->getY();
+    float bottomRightX = topRightPoint.x - topLeftPoint.x + bottomLeftPoint.x;
+    float bottomRightY = topRightPoint.y - topLeftPoint.y + bottomLeftPoint.y;
 
 
     // Estimate that alignment pattern is closer by 3 modules
     // from "bottom right" to known top left location
     float correctionToTopLeft = 1.0f - 3.0f / (float)modulesBetweenFPCenters;
-    int estAlignmentX = (int)(topLeft->getX() + correctionToTopLeft * (bottomRightX - topLeft->getX()));
-    int estAlignmentY = (int)(topLeft->getY() + correctionToTopLeft * (bottomRightY - topLeft->getY()));
+    int estAlignmentX = (int)(topLeftPoint.x + correctionToTopLeft * (bottomRightX - topLeftPoint.x));
+    int estAlignmentY = (int)(topLeftPoint.y + correctionToTopLeft * (bottomRightY - topLeftPoint.y));
 
 
     // Kind of arbitrary -- expand search radius before giving up
@@ -149,7 +186,7 @@ Ref<BitMatrix> Detector::sampleGrid(Ref<BitMatrix> image, int dimension, Ref<Per
   return sampler.sampleGrid(image, dimension, transform);
 }
 
-int Detector::computeDimension(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft,
+int Detector::computeDimension(Point const& topLeft, Point const& topRight, Point const& bottomLeft,
                                float moduleSize) {
   int tltrCentersDimension =
     math_utils::round(ResultPoint::distance(topLeft, topRight) / moduleSize);
@@ -172,16 +209,16 @@ int Detector::computeDimension(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRig
   return dimension;
 }
 
-float Detector::calculateModuleSize(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft) {
+float Detector::calculateModuleSize(Point const& topLeft, Point const& topRight, Point const& bottomLeft) {
   // Take the average
   return (calculateModuleSizeOneWay(topLeft, topRight) + calculateModuleSizeOneWay(topLeft, bottomLeft)) / 2.0f;
 }
 
-float Detector::calculateModuleSizeOneWay(Ref<ResultPoint> pattern, Ref<ResultPoint> otherPattern) {
-  float moduleSizeEst1 = sizeOfBlackWhiteBlackRunBothWays((int)pattern->getX(), (int)pattern->getY(),
-                         (int)otherPattern->getX(), (int)otherPattern->getY());
-  float moduleSizeEst2 = sizeOfBlackWhiteBlackRunBothWays((int)otherPattern->getX(), (int)otherPattern->getY(),
-                         (int)pattern->getX(), (int)pattern->getY());
+float Detector::calculateModuleSizeOneWay(Point const& pattern, Point const& otherPattern) {
+  float moduleSizeEst1 = sizeOfBlackWhiteBlackRunBothWays((int)pattern.x, (int)pattern.y,
+                         (int)otherPattern.x, (int)otherPattern.y);
+  float moduleSizeEst2 = sizeOfBlackWhiteBlackRunBothWays((int)otherPattern.x, (int)otherPattern.y,
+                         (int)pattern.x, (int)pattern.y);
   if (isnan(moduleSizeEst1)) {
     return moduleSizeEst2;
   }
@@ -249,6 +286,17 @@ float Detector::sizeOfBlackWhiteBlackRun(int fromX, int fromY, int toX, int toY)
     // Loop up until x == toX, but not beyond
     int xLimit = toX + xstep;
     for (int x = fromX, y = fromY; x != xLimit; x += xstep) {
+      if (steep) {
+        // The line runs along column y until it steps to the next one, so
+        // the pixels of the color being counted before that step, or the
+        // last pixel, are skipped a run at a time.
+        int ahead = min(dy == 0 ? dx : -error / dy, abs(xLimit - x) - 1);
+        bool black = state != 1;
+        int skip = xstep > 0 ? image_->getColumnRunDown(y, x, image_->getHeight(), black, ahead)
+                             : image_->getColumnRunUp(y, x, black, ahead);
+        x += skip * xstep;
+        error += skip * dy;
+      }
       int realX = steep ? y : x;
       int realY = steep ? x : y;
 
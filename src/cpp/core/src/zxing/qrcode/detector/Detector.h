@@ -45,10 +45,10 @@ protected:
   Ref<ResultPointCallback> getResultPointCallback() const;
 
   static Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform>);
-  static int computeDimension(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft,
+  static int computeDimension(Point const& topLeft, Point const& topRight, Point const& bottomLeft,
                               float moduleSize);
-  float calculateModuleSize(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft);
-  float calculateModuleSizeOneWay(Ref<ResultPoint> pattern, Ref<ResultPoint> otherPattern);
+  float calculateModuleSize(Point const& topLeft, Point const& topRight, Point const& bottomLeft);
+  float calculateModuleSizeOneWay(Point const& pattern, Point const& otherPattern);
   float sizeOfBlackWhiteBlackRunBothWays(int fromX, int fromY, int toX, int toY);
   float sizeOfBlackWhiteBlackRun(int fromX, int fromY, int toX, int toY);
   Ref<AlignmentPattern> findAlignmentInRegion(float overallEstModuleSize, int estAlignmentX, int estAlignmentY,
@@ -60,6 +60,9 @@ public:
 
   Detector(Ref<BitMatrix> image);
   Ref<DetectorResult> detect(DecodeHints const& hints);
+  // Finds the finder patterns in coarse, this detector's image scaled down
+  // by scale, and re-centers them in the full image before sampling it.
+  Ref<DetectorResult> detect(Ref<BitMatrix> coarse, int scale, DecodeHints const& hints);
 
 
 };
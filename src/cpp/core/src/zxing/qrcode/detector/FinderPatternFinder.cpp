@@ -39,7 +39,7 @@ public:
   FurthestFromAverageComparator(float averageModuleSize) :
     averageModuleSize_(averageModuleSize) {
   }
-  bool operator()(Ref<FinderPattern> a, Ref<FinderPattern> b) {
+  bool operator()(Ref<FinderPattern> const& a, Ref<FinderPattern> const& b) const {
     float dA = abs(a->getEstimatedModuleSize() - averageModuleSize_);
     float dB = abs(b->getEstimatedModuleSize() - averageModuleSize_);
     return dA > dB;
@@ -52,7 +52,7 @@ public:
   CenterComparator(float averageModuleSize) :
     averageModuleSize_(averageModuleSize) {
   }
-  bool operator()(Ref<FinderPattern> a, Ref<FinderPattern> b) {
+  bool operator()(Ref<FinderPattern> const& a, Ref<FinderPattern> const& b) const {
     // N.B.: we want the result in descending order ...
     if (a->getCount() != b->getCount()) {
       return a->getCount() > b->getCount();
@@ -99,51 +99,41 @@ float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int
     stateCount[i] = 0;
 
 
-  // Start counting up from center
+  // Start counting up from center, a run at a time, with each run cut off
+  // just past the most the loops it replaces would have counted
   int i = startI;
-  while (i >= 0 && image_->get(centerJ, i)) {
-    stateCount[2]++;
-    i--;
-  }
+  stateCount[2] = image_->getColumnRunUp(centerJ, i, true, maxI);
+  i -= stateCount[2];
   if (i < 0) {
     return NAN;
   }
-  while (i >= 0 && !image_->get(centerJ, i) && stateCount[1] <= maxCount) {
-    stateCount[1]++;
-    i--;
-  }
+  stateCount[1] = image_->getColumnRunUp(centerJ, i, false, maxCount + 1);
+  i -= stateCount[1];
   // If already too many modules in this state or ran off the edge:
   if (i < 0 || stateCount[1] > maxCount) {
     return NAN;
   }
-  while (i >= 0 && image_->get(centerJ, i) && stateCount[0] <= maxCount) {
-    stateCount[0]++;
-    i--;
-  }
+  stateCount[0] = image_->getColumnRunUp(centerJ, i, true, maxCount + 1);
+  i -= stateCount[0];
   if (stateCount[0] > maxCount) {
     return NAN;
   }
 
   // Now also count down from center
   i = startI + 1;
-  while (i < maxI && image_->get(centerJ, i)) {
-    stateCount[2]++;
-    i++;
-  }
+  int run = image_->getColumnRunDown(centerJ, i, maxI, true, maxI);
+  stateCount[2] += run;
+  i += run;
   if (i == maxI) {
     return NAN;
   }
-  while (i < maxI && !image_->get(centerJ, i) && stateCount[3] < maxCount) {
-    stateCount[3]++;
-    i++;
-  }
+  stateCount[3] = image_->getColumnRunDown(centerJ, i, maxI, false, maxCount);
+  i += stateCount[3];
   if (i == maxI || stateCount[3] >= maxCount) {
     return NAN;
   }
-  while (i < maxI && image_->get(centerJ, i) && stateCount[4] < maxCount) {
-    stateCount[4]++;
-    i++;
-  }
+  stateCount[4] = image_->getColumnRunDown(centerJ, i, maxI, true, maxCount);
+  i += stateCount[4];
   if (stateCount[4] >= maxCount) {
     return NAN;
   }
@@ -363,49 +353,49 @@ vector<Ref<FinderPattern> > FinderPatternFinder::selectBestPatterns() {
   return result;
 }
 
-vector<Ref<FinderPattern> > FinderPatternFinder::orderBestPatterns(vector<Ref<FinderPattern> > patterns) {
+vector<Ref<FinderPattern> > FinderPatternFinder::orderBestPatterns(vector<Ref<FinderPattern> > const& patterns) {
+  Point points[] = { patterns[0]->getPoint(), patterns[1]->getPoint(), patterns[2]->getPoint() };
   // Find distances between pattern centers
-  float abDistance = distance(patterns[0], patterns[1]);
-  float bcDistance = distance(patterns[1], patterns[2]);
-  float acDistance = distance(patterns[0], patterns[2]);
+  float abDistance = ResultPoint::distance(points[0], points[1]);
+  float bcDistance = ResultPoint::distance(points[1], points[2]);
+  float acDistance = ResultPoint::distance(points[0], points[2]);
 
-  Ref<FinderPattern> topLeft;
-  Ref<FinderPattern> topRight;
-  Ref<FinderPattern> bottomLeft;
+  int topLeft;
+  int topRight;
+  int bottomLeft;
   // Assume one closest to other two is top left;
   // topRight and bottomLeft will just be guesses below at first
   if (bcDistance >= abDistance && bcDistance >= acDistance) {
-    topLeft = patterns[0];
-    topRight = patterns[1];
-    bottomLeft = patterns[2];
+    topLeft = 0;
+    topRight = 1;
+    bottomLeft = 2;
   } else if (acDistance >= bcDistance && acDistance >= abDistance) {
-    topLeft = patterns[1];
-    topRight = patterns[0];
-    bottomLeft = patterns[2];
+    topLeft = 1;
+    topRight = 0;
+    bottomLeft = 2;
   } else {
-    topLeft = patterns[2];
-    topRight = patterns[0];
-    bottomLeft = patterns[1];
+    topLeft = 2;
+    topRight = 0;
+    bottomLeft = 1;
   }
 
   // Use cross product to figure out which of other1/2 is the bottom left
   // pattern. The vector "top-left -> bottom-left" x "top-left -> top-right"
   // should yield a vector with positive z component
-  if ((bottomLeft->getY() - topLeft->getY()) * (topRight->getX() - topLeft->getX()) < (bottomLeft->getX()
-      - topLeft->getX()) * (topRight->getY() - topLeft->getY())) {
-    Ref<FinderPattern> temp = topRight;
-    topRight = bottomLeft;
-    bottomLeft = temp;
+  Point const& tl = points[topLeft];
+  if ((points[bottomLeft].y - tl.y) * (points[topRight].x - tl.x) <
+      (points[bottomLeft].x - tl.x) * (points[topRight].y - tl.y)) {
+    std::swap(topRight, bottomLeft);
   }
 
   vector<Ref<FinderPattern> > results(3);
-  results[0] = bottomLeft;
-  results[1] = topLeft;
-  results[2] = topRight;
+  results[0] = patterns[bottomLeft];
+  results[1] = patterns[topLeft];
+  results[2] = patterns[topRight];
   return results;
 }
 
-float FinderPatternFinder::distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2) {
+float FinderPatternFinder::distance(Ref<ResultPoint> const& p1, Ref<ResultPoint> const& p2) {
   float dx = p1->getX() - p2->getX();
   float dy = p1->getY() - p2->getY();
   return (float)sqrt(dx * dx + dy * dy);
@@ -443,9 +433,11 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
 
   // This is slightly faster than using the Ref. Efficiency is important here
   BitMatrix& matrix = *image_;
+  std::vector<uint64_t> row(matrix.getRowWordCount());
 
   for (size_t i = iSkip - 1; i < maxI && !done; i += iSkip) {
-    // Get a row of black/white values
+    // Get a row of black/white values, and walk it a run at a time
+    matrix.getRowWords(i, &row[0]);
 
     stateCount[0] = 0;
     stateCount[1] = 0;
@@ -453,14 +445,16 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
     stateCount[3] = 0;
     stateCount[4] = 0;
     int currentState = 0;
-    for (size_t j = 0; j < maxJ; j++) {
-      if (matrix.get(j, i)) {
-        // Black pixel
+    bool black = (row[0] & 1) != 0;
+    for (size_t j = 0, runEnd; j < maxJ; j = runEnd, black = !black) {
+      runEnd = BitMatrix::getRunEnd(&row[0], j, maxJ);
+      int run = (int)(runEnd - j);
+      if (black) {
         if ((currentState & 1) == 1) { // Counting white pixels
           currentState++;
         }
-        stateCount[currentState]++;
-      } else { // White pixel
+        stateCount[currentState] += run;
+      } else { // White run
         if ((currentState & 1) == 0) { // Counting black pixels
           if (currentState == 4) { // A winner?
             if (foundPatternCross(stateCount)) { // Yes
@@ -484,22 +478,24 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
                     // and also back off by iSkip which is about to be
                     // re-added
                     i += rowSkip - stateCount[2] - iSkip;
-                    j = maxJ - 1;
+                    runEnd = maxJ;
+                    run = 0;
                   }
                 }
               } else {
                 stateCount[0] = stateCount[2];
                 stateCount[1] = stateCount[3];
                 stateCount[2] = stateCount[4];
-                stateCount[3] = 1;
+                stateCount[3] = run;
                 stateCount[4] = 0;
                 currentState = 3;
                 continue;
               }
-              // Clear state to start looking again
-              currentState = 0;
+              // Clear state to start looking again; the rest of this run
+              // is the white ahead of the next pattern
+              currentState = run > 1 ? 1 : 0;
               stateCount[0] = 0;
-              stateCount[1] = 0;
+              stateCount[1] = run > 1 ? run - 1 : 0;
               stateCount[2] = 0;
               stateCount[3] = 0;
               stateCount[4] = 0;
@@ -507,15 +503,15 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
               stateCount[0] = stateCount[2];
               stateCount[1] = stateCount[3];
               stateCount[2] = stateCount[4];
-              stateCount[3] = 1;
+              stateCount[3] = run;
               stateCount[4] = 0;
               currentState = 3;
             }
           } else {
-            stateCount[++currentState]++;
+            stateCount[++currentState] += run;
           }
         } else { // Counting white pixels
-          stateCount[currentState]++;
+          stateCount[currentState] += run;
         }
       }
     }
@@ -538,6 +534,26 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
   return result;
 }
 
+Ref<FinderPattern> FinderPatternFinder::refineCenter(float x, float y,
+                                                    float estimatedModuleSize) {
+  if (x < 0 || y < 0 || x >= image_->getWidth() || y >= image_->getHeight()) {
+    return Ref<FinderPattern>();
+  }
+  // As for a center found in a row: the black core is about 3 modules
+  // across and the whole pattern 7.
+  int maxCount = (int)ceil(3 * estimatedModuleSize);
+  int total = (int)(7 * estimatedModuleSize + 0.5f);
+  float centerI = crossCheckVertical((size_t)y, (size_t)x, maxCount, total);
+  if (isnan(centerI)) {
+    return Ref<FinderPattern>();
+  }
+  float centerJ = crossCheckHorizontal((size_t)x, (size_t)centerI, maxCount, total);
+  if (isnan(centerJ)) {
+    return Ref<FinderPattern>();
+  }
+  return Ref<FinderPattern>(new FinderPattern(centerJ, centerI, estimatedModuleSize));
+}
+
 Ref<BitMatrix> FinderPatternFinder::getImage() {
   return image_;
 }
@@ -60,15 +60,19 @@ protected:
   int findRowSkip();
   bool haveMultiplyConfirmedCenters();
   std::vector<Ref<FinderPattern> > selectBestPatterns();
-  static std::vector<Ref<FinderPattern> > orderBestPatterns(std::vector<Ref<FinderPattern> > patterns);
+  static std::vector<Ref<FinderPattern> > orderBestPatterns(std::vector<Ref<FinderPattern> > const& patterns);
 
   Ref<BitMatrix> getImage();
   std::vector<Ref<FinderPattern> >& getPossibleCenters();
 
 public:
-  static float distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2);
+  static float distance(Ref<ResultPoint> const& p1, Ref<ResultPoint> const& p2);
   FinderPatternFinder(Ref<BitMatrix> image, Ref<ResultPointCallback>const&);
   Ref<FinderPatternInfo> find(DecodeHints const& hints);
+  // Re-centers a pattern found at a coarser scale, cross-checking it
+  // vertically and then horizontally in this finder's image. Returns an
+  // empty Ref if the pattern does not hold up there.
+  Ref<FinderPattern> refineCenter(float x, float y, float estimatedModuleSize);
 };
 }
 }
@@ -0,0 +1,86 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  LuminanceSourceTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "LuminanceSourceTest.h"
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LuminanceSourceTest);
+
+namespace {
+  // Pixel (x, y) is x + 10 * y, with only getRow and getMatrix, so views
+  // come from LuminanceSource's default.
+  class RowSource : public LuminanceSource {
+  private:
+    int width_;
+    int height_;
+
+  public:
+    RowSource(int width, int height) : width_(width), height_(height) {
+    }
+
+    int getWidth() const {
+      return width_;
+    }
+
+    int getHeight() const {
+      return height_;
+    }
+
+    unsigned char* getRow(int y, unsigned char* row) {
+      if (row == NULL) {
+        row = new unsigned char[width_];
+      }
+      for (int x = 0; x < width_; x++) {
+        row[x] = (unsigned char)(x + 10 * y);
+      }
+      return row;
+    }
+
+    unsigned char* getMatrix() {
+      CPPUNIT_FAIL("the default view reads rows");
+      return NULL;
+    }
+  };
+}
+
+void LuminanceSourceTest::testDefaultMatrixView() {
+  RowSource source(7, 5);
+  LuminanceView view = source.getMatrixView();
+  CPPUNIT_ASSERT(!view.isBorrowed());
+  CPPUNIT_ASSERT_EQUAL(7, view.getWidth());
+  CPPUNIT_ASSERT_EQUAL(5, view.getHeight());
+  CPPUNIT_ASSERT_EQUAL(7, view.getStride());
+  for (int y = 0; y < 5; y++) {
+    for (int x = 0; x < 7; x++) {
+      CPPUNIT_ASSERT_EQUAL(x + 10 * y, (int)view.getRow(y)[x]);
+    }
+  }
+}
+
+void LuminanceSourceTest::testEmptyMatrixView() {
+  RowSource wide(7, 0);
+  CPPUNIT_ASSERT_EQUAL(0, wide.getMatrixView().getHeight());
+  RowSource tall(0, 5);
+  CPPUNIT_ASSERT_EQUAL(5, tall.getMatrixView().getHeight());
+}
+
+}
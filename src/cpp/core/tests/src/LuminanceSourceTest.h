@@ -0,0 +1,40 @@
+#ifndef __LUMINANCE_SOURCE_TEST_H__
+#define __LUMINANCE_SOURCE_TEST_H__
+
+/*
+ *  LuminanceSourceTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/LuminanceSource.h>
+
+namespace zxing {
+class LuminanceSourceTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(LuminanceSourceTest);
+  CPPUNIT_TEST(testDefaultMatrixView);
+  CPPUNIT_TEST(testEmptyMatrixView);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testDefaultMatrixView();
+  void testEmptyMatrixView();
+};
+}
+
+#endif // __LUMINANCE_SOURCE_TEST_H__
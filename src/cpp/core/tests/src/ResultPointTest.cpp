@@ -0,0 +1,59 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  ResultPointTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ResultPointTest.h"
+#include <vector>
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ResultPointTest);
+
+// Whatever order three corners come in, they come out as A, B, C with B
+// the corner, and with nothing retained or released along the way.
+void ResultPointTest::testOrderBestPatterns() {
+  Ref<ResultPoint> a(new ResultPoint(10, 110));
+  Ref<ResultPoint> b(new ResultPoint(10, 10));
+  Ref<ResultPoint> c(new ResultPoint(110, 10));
+  int orders[][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+  Ref<ResultPoint> points[] = { a, b, c };
+  for (int i = 0; i < 6; i++) {
+    std::vector<Ref<ResultPoint> > patterns(3);
+    for (int j = 0; j < 3; j++) {
+      patterns[j] = points[orders[i][j]];
+    }
+    ResultPoint::orderBestPatterns(patterns);
+    CPPUNIT_ASSERT(patterns[0].object_ == a.object_);
+    CPPUNIT_ASSERT(patterns[1].object_ == b.object_);
+    CPPUNIT_ASSERT(patterns[2].object_ == c.object_);
+    CPPUNIT_ASSERT_EQUAL(3, a->count());
+    CPPUNIT_ASSERT_EQUAL(3, b->count());
+    CPPUNIT_ASSERT_EQUAL(3, c->count());
+  }
+}
+
+void ResultPointTest::testDistance() {
+  Ref<ResultPoint> a(new ResultPoint(1, 2));
+  Ref<ResultPoint> b(new ResultPoint(4, 6));
+  CPPUNIT_ASSERT_EQUAL(5.0f, ResultPoint::distance(a, b));
+  CPPUNIT_ASSERT_EQUAL(5.0f, ResultPoint::distance(a->getPoint(), b->getPoint()));
+  CPPUNIT_ASSERT_EQUAL(1, a->count());
+}
+
+}
@@ -0,0 +1,83 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  SymbolImage.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SymbolImage.h"
+#include <zxing/DecodeHints.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/PyramidLuminanceSource.h>
+#include <string.h>
+
+namespace zxing {
+
+void drawSymbolRow(unsigned char* row, int y, const char* const* symbol, int moduleSize,
+                   int left, int top) {
+  int modules = (int)strlen(symbol[0]);
+  if (y < top || y >= top + modules * moduleSize) {
+    return;
+  }
+  const char* line = symbol[(y - top) / moduleSize];
+  for (int x = 0; x < modules * moduleSize; x++) {
+    if (line[x / moduleSize] == 'X') {
+      row[left + x] = 0;
+    }
+  }
+}
+
+void drawSymbol(std::vector<unsigned char>& pixels, int width, const char* const* symbol,
+                int moduleSize, int left, int top) {
+  int height = (int)pixels.size() / width;
+  for (int y = 0; y < height; y++) {
+    drawSymbolRow(&pixels[y * width], y, symbol, moduleSize, left, top);
+  }
+}
+
+Ref<BitMatrix> symbolMatrix(const char* const* symbol) {
+  int modules = (int)strlen(symbol[0]);
+  Ref<BitMatrix> bits(new BitMatrix(modules));
+  for (int y = 0; y < modules; y++) {
+    for (int x = 0; x < modules; x++) {
+      if (symbol[y][x] == 'X') {
+        bits->set(x, y);
+      }
+    }
+  }
+  return bits;
+}
+
+Ref<BinaryBitmap> centredSymbol(std::vector<unsigned char>& pixels, const char* const* symbol,
+                                int moduleSize, int size) {
+  int offset = (size - (int)strlen(symbol[0]) * moduleSize) / 2;
+  pixels.assign(size * size, 0xFF);
+  drawSymbol(pixels, size, symbol, moduleSize, offset, offset);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&pixels[0], size, size,
+                                                           0, 0, size, size));
+  Ref<LuminanceSource> pyramid(new PyramidLuminanceSource(source));
+  return Ref<BinaryBitmap>(new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(pyramid))));
+}
+
+std::string decodeText(Reader& reader, Ref<BinaryBitmap> image, bool coarseToFine) {
+  DecodeHints hints(DecodeHints::DEFAULT_HINT);
+  hints.setCoarseToFine(coarseToFine);
+  return reader.decode(image, hints)->getText()->getText();
+}
+
+}
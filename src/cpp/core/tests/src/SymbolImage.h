@@ -0,0 +1,54 @@
+#ifndef __SYMBOL_IMAGE_H__
+#define __SYMBOL_IMAGE_H__
+
+/*
+ *  SymbolImage.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/BinaryBitmap.h>
+#include <zxing/Reader.h>
+#include <zxing/common/BitMatrix.h>
+#include <string>
+#include <vector>
+
+namespace zxing {
+
+/*
+ * Images of symbols for the reader tests. A symbol is written as square
+ * rows of 'X' for dark modules and ' ' for light ones, and drawn black on
+ * white at moduleSize pixels a module, its top left corner at (left, top).
+ */
+
+// Draws the part of symbol on image row y into row.
+void drawSymbolRow(unsigned char* row, int y, const char* const* symbol, int moduleSize,
+                   int left, int top);
+// Draws symbol into an image width pixels wide.
+void drawSymbol(std::vector<unsigned char>& pixels, int width, const char* const* symbol,
+                int moduleSize, int left, int top);
+// The symbol's modules, one pixel each.
+Ref<BitMatrix> symbolMatrix(const char* const* symbol);
+// symbol in the middle of a white size by size image, held in pixels, read
+// through a PyramidLuminanceSource and a HybridBinarizer.
+Ref<BinaryBitmap> centredSymbol(std::vector<unsigned char>& pixels, const char* const* symbol,
+                                int moduleSize, int size);
+// The text reader decodes from image, coarse to fine if asked.
+std::string decodeText(Reader& reader, Ref<BinaryBitmap> image, bool coarseToFine);
+
+}
+
+#endif // __SYMBOL_IMAGE_H__
@@ -0,0 +1,92 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  AztecReaderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AztecReaderTest.h"
+#include "../SymbolImage.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/aztec/AztecReader.h>
+#include <zxing/aztec/detector/Detector.h>
+#include <string>
+#include <vector>
+
+namespace zxing {
+namespace aztec {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(AztecReaderTest);
+
+namespace {
+  const char* const TEXT = "PYRAMID";
+
+  // A compact, one layer symbol holding TEXT in upper case mode.
+  const char* const SYMBOL[] = {
+    "  X X X XX XX X",
+    "X    XXX     XX",
+    "  XX     X  X  ",
+    "XXXXXXXXXXXXX  ",
+    "X XX       XX  ",
+    "X  X XXXXX X   ",
+    "X XX X   X X XX",
+    " X X X X X X  X",
+    "X  X X   X XXXX",
+    "  XX XXXXX X   ",
+    "X  X       XXXX",
+    " X XXXXXXXXXX X",
+    "XX  XX XXXX  X ",
+    "     XXXX  X  X",
+    " XX XXXX XX X  ",
+  };
+
+  // At 8 pixels a module in a 320 by 320 image, whose pyramid has levels
+  // at 4 and 2 pixels a module.
+  const int MODULE_SIZE = 8;
+  const int SIZE = 320;
+}
+
+void AztecReaderTest::testDecode() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  AztecReader reader;
+  CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decodeText(reader, bitmap, false));
+}
+
+// Each level finds the symbol on its own, and the grid sampled from the
+// full resolution image decodes.
+void AztecReaderTest::testDetectOnLevel() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  CPPUNIT_ASSERT_EQUAL(3, bitmap->getLevelCount());
+  Decoder decoder;
+  for (int level = 1; level < bitmap->getLevelCount(); level++) {
+    Detector detector(bitmap->getBlackMatrix());
+    Ref<BitMatrix> coarse = bitmap->getLevel(level)->getBlackMatrix();
+    Ref<AztecDetectorResult> detectorResult(detector.detect(coarse, 1 << level));
+    CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decoder.decode(detectorResult)->getText()->getText());
+  }
+}
+
+void AztecReaderTest::testCoarseToFine() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  AztecReader reader;
+  CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decodeText(reader, bitmap, true));
+}
+
+}
+}
@@ -0,0 +1,165 @@
+/*
+ *  BandLuminanceSourceTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BandLuminanceSourceTest.h"
+#include <zxing/common/BandLuminanceSource.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BandLuminanceSourceTest);
+
+namespace {
+  const int WIDTH = 37;
+  const int HEIGHT = 100;
+
+  // Row y is y + x, and each getRow() is counted; there is no matrix.
+  class RowCountingSource : public LuminanceSource {
+   public:
+    vector<int> reads;
+
+    RowCountingSource() : reads(HEIGHT) {
+    }
+
+    int getWidth() const {
+      return WIDTH;
+    }
+
+    int getHeight() const {
+      return HEIGHT;
+    }
+
+    unsigned char* getRow(int y, unsigned char* row) {
+      reads[y]++;
+      for (int x = 0; x < WIDTH; x++) {
+        row[x] = (unsigned char)(y + x);
+      }
+      return row;
+    }
+
+    unsigned char* getMatrix() {
+      CPPUNIT_FAIL("A band must not ask for the whole matrix.");
+      return 0;
+    }
+  };
+
+  void assertBand(BandLuminanceSource& band, int top, int height) {
+    CPPUNIT_ASSERT_EQUAL(top, band.getTop());
+    CPPUNIT_ASSERT_EQUAL(height, band.getHeight());
+    CPPUNIT_ASSERT_EQUAL(WIDTH, band.getWidth());
+    LuminanceView view = band.getMatrixView();
+    CPPUNIT_ASSERT(view.isBorrowed());
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        CPPUNIT_ASSERT_EQUAL((top + y + x) & 0xFF, (int)view.getRow(y)[x]);
+      }
+    }
+  }
+}
+
+void BandLuminanceSourceTest::testRows() {
+  Ref<LuminanceSource> source(new RowCountingSource());
+  BandLuminanceSource band(source, 30);
+  CPPUNIT_ASSERT_EQUAL(30, band.getCapacity());
+  band.moveTo(10, 30);
+  assertBand(band, 10, 30);
+  unsigned char row[WIDTH];
+  band.getRow(29, row);
+  CPPUNIT_ASSERT_EQUAL(39 + 5, (int)row[5]);
+  // A short last band.
+  band.moveTo(95, 5);
+  assertBand(band, 95, 5);
+}
+
+void BandLuminanceSourceTest::testMoveReadsEachRowOnce() {
+  RowCountingSource* counting = new RowCountingSource();
+  Ref<LuminanceSource> source(counting);
+  BandLuminanceSource band(source, 30);
+  for (int top = 0; top < HEIGHT; top += 20) {
+    int height = top + 30 > HEIGHT ? HEIGHT - top : 30;
+    band.moveTo(top, height);
+    assertBand(band, top, height);
+  }
+  // Staying put, and jumping past the band, still read nothing twice.
+  band.moveTo(80, 20);
+  for (int y = 0; y < HEIGHT; y++) {
+    CPPUNIT_ASSERT_EQUAL(1, counting->reads[y]);
+  }
+}
+
+void BandLuminanceSourceTest::testCropAndRotate() {
+  Ref<LuminanceSource> source(new RowCountingSource());
+  BandLuminanceSource band(source, 30);
+  band.moveTo(40, 20);
+  CPPUNIT_ASSERT(band.isCropSupported());
+  Ref<LuminanceSource> cropped = band.crop(3, 5, 10, 8);
+  CPPUNIT_ASSERT_EQUAL(10, cropped->getWidth());
+  CPPUNIT_ASSERT_EQUAL(8, cropped->getHeight());
+  CPPUNIT_ASSERT_EQUAL(45 + 3, (int)cropped->getMatrixView().getRow(0)[0]);
+  // GenericMultipleBarcodeReader crops its crops again.
+  CPPUNIT_ASSERT(cropped->isCropSupported());
+  Ref<LuminanceSource> again = cropped->crop(2, 1, 4, 4);
+  CPPUNIT_ASSERT_EQUAL(46 + 5, (int)again->getMatrixView().getRow(0)[0]);
+  CPPUNIT_ASSERT_THROW(cropped->crop(7, 0, 4, 4), IllegalArgumentException);
+
+  CPPUNIT_ASSERT(band.isRotateSupported());
+  Ref<LuminanceSource> rotated = band.rotateCounterClockwise();
+  CPPUNIT_ASSERT_EQUAL(20, rotated->getWidth());
+  CPPUNIT_ASSERT_EQUAL(WIDTH, rotated->getHeight());
+  unsigned char row[20];
+  rotated->getRow(0, row);
+  // The rotated first row is the band's last column, top to bottom.
+  for (int x = 0; x < 20; x++) {
+    CPPUNIT_ASSERT_EQUAL(40 + x + WIDTH - 1, (int)row[x]);
+  }
+}
+
+void BandLuminanceSourceTest::testCropOutlivesBand() {
+  Ref<LuminanceSource> source(new RowCountingSource());
+  Ref<BandLuminanceSource> band(new BandLuminanceSource(source, 30));
+  band->moveTo(40, 20);
+  Ref<LuminanceSource> cropped = band->crop(3, 5, 10, 8);
+  Ref<LuminanceSource> rotated = band->rotateCounterClockwise();
+  band = Ref<BandLuminanceSource>();
+  // Whatever takes the band's place must not show through.
+  vector<unsigned char> reused(WIDTH * 30, 0);
+  CPPUNIT_ASSERT_EQUAL(45 + 3, (int)cropped->getMatrixView().getRow(0)[0]);
+  Ref<LuminanceSource> again = cropped->crop(2, 1, 4, 4);
+  cropped = Ref<LuminanceSource>();
+  CPPUNIT_ASSERT_EQUAL(46 + 5, (int)again->getMatrixView().getRow(0)[0]);
+  unsigned char row[20];
+  rotated->getRow(0, row);
+  CPPUNIT_ASSERT_EQUAL(40 + WIDTH - 1, (int)row[0]);
+}
+
+void BandLuminanceSourceTest::testBadMoves() {
+  Ref<LuminanceSource> source(new RowCountingSource());
+  CPPUNIT_ASSERT_THROW(BandLuminanceSource(source, 0), IllegalArgumentException);
+  CPPUNIT_ASSERT_THROW(BandLuminanceSource(source, HEIGHT + 1), IllegalArgumentException);
+  BandLuminanceSource band(source, 30);
+  band.moveTo(50, 30);
+  CPPUNIT_ASSERT_THROW(band.moveTo(49, 30), IllegalArgumentException);
+  CPPUNIT_ASSERT_THROW(band.moveTo(60, 31), IllegalArgumentException);
+  CPPUNIT_ASSERT_THROW(band.moveTo(80, 21), IllegalArgumentException);
+  CPPUNIT_ASSERT_THROW(band.getRow(30, 0), IllegalArgumentException);
+}
+}
@@ -0,0 +1,46 @@
+#ifndef __BAND_LUMINANCE_SOURCE_TEST_H__
+#define __BAND_LUMINANCE_SOURCE_TEST_H__
+
+/*
+ *  BandLuminanceSourceTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/common/BandLuminanceSource.h>
+
+namespace zxing {
+class BandLuminanceSourceTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(BandLuminanceSourceTest);
+  CPPUNIT_TEST(testRows);
+  CPPUNIT_TEST(testMoveReadsEachRowOnce);
+  CPPUNIT_TEST(testCropAndRotate);
+  CPPUNIT_TEST(testCropOutlivesBand);
+  CPPUNIT_TEST(testBadMoves);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testRows();
+  void testMoveReadsEachRowOnce();
+  void testCropAndRotate();
+  void testCropOutlivesBand();
+  void testBadMoves();
+};
+}
+
+#endif // __BAND_LUMINANCE_SOURCE_TEST_H__
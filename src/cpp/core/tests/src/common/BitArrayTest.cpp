@@ -212,5 +212,59 @@ void BitArrayTest::testReverseReverse() {
     CPPUNIT_ASSERT_EQUAL(test.get(i), reference.get(i));
   }
 }
+void BitArrayTest::testGetNextSet() {
+  BitArray array(100);
+  CPPUNIT_ASSERT_EQUAL((size_t)100, array.getNextSet(0));
+  array.set(3);
+  array.set(31);
+  array.set(32);
+  array.set(99);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, array.getNextSet(0));
+  CPPUNIT_ASSERT_EQUAL((size_t)3, array.getNextSet(3));
+  CPPUNIT_ASSERT_EQUAL((size_t)31, array.getNextSet(4));
+  CPPUNIT_ASSERT_EQUAL((size_t)32, array.getNextSet(32));
+  CPPUNIT_ASSERT_EQUAL((size_t)99, array.getNextSet(33));
+  CPPUNIT_ASSERT_EQUAL((size_t)100, array.getNextSet(100));
 }
 
+void BitArrayTest::testGetNextUnset() {
+  BitArray array(100);
+  array.setRange(0, 100);
+  CPPUNIT_ASSERT_EQUAL((size_t)100, array.getNextUnset(0));
+  BitArray gaps(100);
+  gaps.setRange(0, 70);
+  gaps.setRange(71, 100);
+  CPPUNIT_ASSERT_EQUAL((size_t)70, gaps.getNextUnset(0));
+  CPPUNIT_ASSERT_EQUAL((size_t)70, gaps.getNextUnset(70));
+  CPPUNIT_ASSERT_EQUAL((size_t)100, gaps.getNextUnset(71));
+}
+
+void BitArrayTest::testToRunLengths() {
+  for (int trial = 0; trial < 50; trial++) {
+    size_t size = 1 + rand() % 200;
+    BitArray array(size);
+    // Runs long and short enough to span words and fill them.
+    bool set = rand() % 2 == 0;
+    for (size_t i = 0; i < size; set = !set) {
+      size_t run = 1 + rand() % (rand() % 2 == 0 ? 5 : 70);
+      for (size_t j = i; j < i + run && j < size; j++) {
+        if (set) {
+          array.set(j);
+        }
+      }
+      i += run;
+    }
+    vector<int> runs;
+    array.toRunLengths(runs);
+    size_t x = 0;
+    for (size_t r = 0; r < runs.size(); r++) {
+      CPPUNIT_ASSERT(r == 0 || runs[r] > 0);
+      for (int j = 0; j < runs[r]; j++) {
+        CPPUNIT_ASSERT_EQUAL(r % 2 == 1, array.get(x++));
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(size, x);
+  }
+}
+
+}
@@ -37,6 +37,9 @@ class BitArrayTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST(testReverseOdd);
   CPPUNIT_TEST(testReverseSweep);
   CPPUNIT_TEST(testReverseReverse);
+  CPPUNIT_TEST(testGetNextSet);
+  CPPUNIT_TEST(testGetNextUnset);
+  CPPUNIT_TEST(testToRunLengths);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -52,6 +55,9 @@ protected:
   void testReverseOdd();
   void testReverseSweep();
   void testReverseReverse();
+  void testGetNextSet();
+  void testGetNextUnset();
+  void testToRunLengths();
 
 private:
   static void fillRandom(BitArray& test, BitArray& reference);
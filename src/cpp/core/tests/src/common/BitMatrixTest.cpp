@@ -21,6 +21,7 @@
 #include "BitMatrixTest.h"
 #include <limits>
 #include <stdlib.h>
+#include <zxing/common/IllegalArgumentException.h>
 
 namespace zxing {
 using namespace std;
@@ -65,8 +66,11 @@ void BitMatrixTest::testGetBits() {
   matrix.set(0, 0);
   matrix.set(5, 5);
   unsigned int* bits = matrix.getBits();
+  // Each row is padded to 64 bits.
+  CPPUNIT_ASSERT_EQUAL((size_t)64, matrix.getRowStride());
   CPPUNIT_ASSERT_EQUAL(1u, bits[0]);
-  CPPUNIT_ASSERT_EQUAL(8u, bits[1]);
+  CPPUNIT_ASSERT_EQUAL(0u, bits[1]);
+  CPPUNIT_ASSERT_EQUAL(32u, bits[10]);
 }
 
 void BitMatrixTest::testGetRow1() {
@@ -87,6 +91,350 @@ void BitMatrixTest::testGetRow3() {
   runBitMatrixGetRowTest(width, height);
 }
 
+void BitMatrixTest::testSetRow() {
+  const int width = 45;
+  const int height = 7;
+  BitMatrix mat(width, height);
+  mat.setRegion(0, 0, width, height);
+  Ref<BitArray> row(new BitArray(width));
+  for (int x = 0; x < width; x += 3) {
+    row->set(x);
+  }
+  mat.setRow(3, row);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      CPPUNIT_ASSERT_EQUAL(y != 3 || x % 3 == 0, mat.get(x, y));
+    }
+  }
+}
+
+// On a matrix and on a view whose rows start mid-word, with bits set all
+// around the view that writing to it must leave alone.
+void BitMatrixTest::testRowWords() {
+  const int width = 150;
+  const int height = 9;
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      if ((rand() & 0x01) != 0) {
+        matrix->set(x, y);
+      }
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)3, matrix->getRowWordCount());
+  vector<uint64_t> words(3);
+  for (int y = 0; y < height; y++) {
+    matrix->getRowWords(y, &words[0]);
+    for (int x = 0; x < 192; x++) {
+      CPPUNIT_ASSERT_EQUAL(x < width && matrix->get(x, y), ((words[x >> 6] >> (x & 63)) & 1) != 0);
+    }
+  }
+
+  Ref<BitMatrix> view = matrix->crop(13, 2, 70, 5);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, view->getRowWordCount());
+  view->getRowWords(4, &words[0]);
+  for (int x = 0; x < 128; x++) {
+    CPPUNIT_ASSERT_EQUAL(x < 70 && matrix->get(x + 13, 6), ((words[x >> 6] >> (x & 63)) & 1) != 0);
+  }
+
+  matrix->setRegion(0, 0, width, height);
+  words[0] = 0x5555555555555555ULL;
+  words[1] = 0;
+  view->setRowWords(1, &words[0]);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      bool inView = y == 3 && x >= 13 && x < 83;
+      CPPUNIT_ASSERT_EQUAL(!inView || (x - 13 < 64 && (x - 13) % 2 == 0), matrix->get(x, y));
+    }
+  }
+}
+
+void BitMatrixTest::testGetRunEnd() {
+  const int width = 200;
+  vector<uint64_t> words(4);
+  for (int n = 0; n < 20; n++) {
+    // Runs from 1 to over 100 pixels long, so some cover whole words.
+    BitMatrix matrix(width, 1);
+    bool black = (rand() & 0x01) != 0;
+    for (int x = 0; x < width; black = !black) {
+      int run = 1 + rand() % (n < 10 ? 8 : 120);
+      for (; run > 0 && x < width; run--, x++) {
+        if (black) {
+          matrix.set(x, 0);
+        }
+      }
+    }
+    matrix.getRowWords(0, &words[0]);
+    for (int end = width; end > 0; end -= 37) {
+      for (int from = 0; from < end; from++) {
+        int expected = from + 1;
+        while (expected < end && matrix.get(expected, 0) == matrix.get(from, 0)) {
+          expected++;
+        }
+        CPPUNIT_ASSERT_EQUAL((size_t)expected, BitMatrix::getRunEnd(&words[0], from, end));
+      }
+    }
+    for (int begin = 0; begin < width; begin += 37) {
+      for (int from = begin; from < width; from++) {
+        int expected = from;
+        while (expected > begin && matrix.get(expected - 1, 0) == matrix.get(from, 0)) {
+          expected--;
+        }
+        CPPUNIT_ASSERT_EQUAL((size_t)expected, BitMatrix::getRunStart(&words[0], from, begin));
+      }
+    }
+  }
+}
+
+void BitMatrixTest::testColumnRuns() {
+  const int width = 70;
+  const int height = 150;
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  for (int x = 0; x < width; x++) {
+    bool black = (rand() & 0x01) != 0;
+    for (int y = 0; y < height; black = !black) {
+      for (int run = 1 + rand() % (x < 35 ? 8 : 120); run > 0 && y < height; run--, y++) {
+        if (black) {
+          matrix->set(x, y);
+        }
+      }
+    }
+  }
+  Ref<BitMatrix> view = matrix->crop(5, 70, 40, 20);
+  const int limits[] = { 0, 1, 5, 64, height };
+  // The same runs with and without the transposed copy.
+  for (int copy = 0; copy < 2; copy++) {
+    matrix->setColumnCopy(copy != 0);
+    for (int x = 0; x < width; x += 3) {
+      for (int y = 0; y < height; y++) {
+        for (size_t n = 0; n < sizeof(limits) / sizeof(limits[0]); n++) {
+          int limit = limits[n];
+          bool black = matrix->get(x, y) == ((x + y + n) % 4 != 0);
+          int down = 0;
+          while (y + down < height - 1 && matrix->get(x, y + down) == black && down < limit) {
+            down++;
+          }
+          CPPUNIT_ASSERT_EQUAL(down, matrix->getColumnRunDown(x, y, height - 1, black, limit));
+          int up = 0;
+          while (y - up >= 0 && matrix->get(x, y - up) == black && up < limit) {
+            up++;
+          }
+          CPPUNIT_ASSERT_EQUAL(up, matrix->getColumnRunUp(x, y, black, limit));
+        }
+      }
+    }
+
+    // A view's runs stop at its own edges.
+    for (int x = 0; x < 40; x++) {
+      for (int y = 0; y < 20; y++) {
+        bool black = view->get(x, y);
+        int down = 0;
+        while (y + down < 20 && view->get(x, y + down) == black) {
+          down++;
+        }
+        CPPUNIT_ASSERT_EQUAL(down, view->getColumnRunDown(x, y, 20, black, height));
+        int up = 0;
+        while (y - up >= 0 && view->get(x, y - up) == black) {
+          up++;
+        }
+        CPPUNIT_ASSERT_EQUAL(up, view->getColumnRunUp(x, y, black, height));
+      }
+    }
+  }
+
+  // Changes, through the matrix or a view, are seen by the next run. A
+  // view sets its parent's copy.
+  matrix->setColumnCopy(false);
+  view->setColumnCopy(true);
+  CPPUNIT_ASSERT_EQUAL(0, matrix->getColumnRunDown(10, 0, height, !matrix->get(10, 0), height));
+  matrix->setRegion(10, 0, 1, height);
+  CPPUNIT_ASSERT_EQUAL(height, matrix->getColumnRunDown(10, 0, height, true, height));
+  view->flip(5, 10);
+  CPPUNIT_ASSERT_EQUAL(80, matrix->getColumnRunUp(10, 79, true, height));
+}
+
+void BitMatrixTest::testRotateCounterClockwise() {
+  // Sizes on, under and over the 64 bit blocks, in both directions.
+  const int sizes[][2] = { { 1, 1 }, { 64, 64 }, { 63, 130 }, { 150, 9 }, { 129, 200 } };
+  for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+    int width = sizes[n][0];
+    int height = sizes[n][1];
+    Ref<BitMatrix> matrix(new BitMatrix(width, height));
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        if ((rand() & 0x01) != 0) {
+          matrix->set(x, y);
+        }
+      }
+    }
+    Ref<BitMatrix> rotated = matrix->rotateCounterClockwise();
+    CPPUNIT_ASSERT_EQUAL((size_t)height, rotated->getWidth());
+    CPPUNIT_ASSERT_EQUAL((size_t)width, rotated->getHeight());
+    for (int y = 0; y < width; y++) {
+      for (int x = 0; x < height; x++) {
+        CPPUNIT_ASSERT_EQUAL(matrix->get(width - 1 - y, x), rotated->get(x, y));
+      }
+    }
+    // The padding past each rotated row is left clear.
+    unsigned int* bits = rotated->getBits();
+    size_t stride = rotated->getRowStride();
+    for (int y = 0; y < width; y++) {
+      for (size_t x = height; x < stride; x++) {
+        size_t offset = y * stride + x;
+        CPPUNIT_ASSERT_EQUAL(0u, (bits[offset >> 5] >> (offset & 31)) & 1);
+      }
+    }
+  }
+
+  Ref<BitMatrix> matrix(new BitMatrix(150, 100));
+  for (int y = 0; y < 100; y++) {
+    for (int x = 0; x < 150; x++) {
+      if ((rand() & 0x01) != 0) {
+        matrix->set(x, y);
+      }
+    }
+  }
+  Ref<BitMatrix> view = matrix->crop(13, 7, 90, 70);
+  Ref<BitMatrix> rotated = view->rotateCounterClockwise();
+  CPPUNIT_ASSERT(!rotated->isView());
+  for (int y = 0; y < 90; y++) {
+    for (int x = 0; x < 70; x++) {
+      CPPUNIT_ASSERT_EQUAL(matrix->get(13 + 89 - y, 7 + x), rotated->get(x, y));
+    }
+  }
+}
+
+namespace {
+  // Fills tiles with a diagonal pattern and remembers the tiles it was asked for.
+  class PatternTiles : public BitMatrix::TileSource {
+  public:
+    size_t width_;
+    vector<int> calls_;
+    PatternTiles(size_t width) : width_(width) {
+    }
+    void fillTile(unsigned int* bits, size_t rowStride, int left, int top, int right, int bottom) {
+      calls_.push_back(left);
+      calls_.push_back(top);
+      calls_.push_back(right);
+      calls_.push_back(bottom);
+      for (int y = top; y < bottom; y++) {
+        for (int x = left; x < right; x++) {
+          if ((x + y) % 3 == 0) {
+            size_t offset = y * rowStride + x;
+            bits[offset >> 5] |= 1u << (offset & 31);
+          }
+        }
+      }
+    }
+  };
+}
+
+void BitMatrixTest::testTileSource() {
+  const int width = 150;
+  const int height = 70;
+  BitMatrix matrix(width, height);
+  Ref<PatternTiles> tiles(new PatternTiles(width));
+  matrix.setTileSource(tiles);
+  // 150 pixels are two tiles across, the second one 86 wide; 70 are one down.
+  CPPUNIT_ASSERT_EQUAL((size_t)2, matrix.getTileCount());
+  CPPUNIT_ASSERT_EQUAL(false, matrix.get(140, 69));
+  CPPUNIT_ASSERT_EQUAL(true, matrix.get(141, 69));
+  CPPUNIT_ASSERT_EQUAL((size_t)1, matrix.getTilesFilled());
+  int second[] = { 64, 0, width, height };
+  CPPUNIT_ASSERT(tiles->calls_ == vector<int>(second, second + 4));
+
+  Ref<BitArray> row = matrix.getRow(5, Ref<BitArray>());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, matrix.getTilesFilled());
+  CPPUNIT_ASSERT_EQUAL((size_t)8, tiles->calls_.size());
+  for (int x = 0; x < width; x++) {
+    CPPUNIT_ASSERT_EQUAL((x + 5) % 3 == 0, row->get(x));
+  }
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      CPPUNIT_ASSERT_EQUAL((x + y) % 3 == 0, matrix.get(x, y));
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)8, tiles->calls_.size());
+
+  // getRowWords only fills the tiles the row crosses.
+  BitMatrix tall(width, 130);
+  tall.setTileSource(Ref<BitMatrix::TileSource>(new PatternTiles(width)));
+  vector<uint64_t> words(tall.getRowWordCount());
+  tall.getRowWords(100, &words[0]);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, tall.getTilesFilled());
+  for (int x = 0; x < width; x++) {
+    CPPUNIT_ASSERT_EQUAL((x + 100) % 3 == 0, ((words[x >> 6] >> (x & 63)) & 1) != 0);
+  }
+}
+
+void BitMatrixTest::testCrop() {
+  const int width = 101;
+  const int height = 53;
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      if ((rand() & 0x01) != 0) {
+        matrix->set(x, y);
+      }
+    }
+  }
+  Ref<BitMatrix> view = matrix->crop(13, 7, 70, 40);
+  CPPUNIT_ASSERT(view->isView());
+  CPPUNIT_ASSERT_EQUAL((size_t)70, view->getWidth());
+  CPPUNIT_ASSERT_EQUAL((size_t)40, view->getHeight());
+  Ref<BitArray> row;
+  for (int y = 0; y < 40; y++) {
+    row = view->getRow(y, row);
+    for (int x = 0; x < 70; x++) {
+      CPPUNIT_ASSERT_EQUAL(matrix->get(x + 13, y + 7), view->get(x, y));
+      CPPUNIT_ASSERT_EQUAL(matrix->get(x + 13, y + 7), row->get(x));
+    }
+  }
+
+  // A view of a view still refers to the original bits.
+  Ref<BitMatrix> inner = view->crop(5, 3, 20, 10);
+  size_t offset = inner->getOrigin() + 2 * inner->getRowStride() + 4;
+  CPPUNIT_ASSERT_EQUAL(matrix->get(22, 12),
+                       ((inner->getBits()[offset >> 5] >> (offset & 31)) & 1) != 0);
+  matrix->flip(22, 12);
+  CPPUNIT_ASSERT_EQUAL(matrix->get(22, 12), inner->get(4, 2));
+  inner->clear();
+  CPPUNIT_ASSERT_EQUAL(false, matrix->get(22, 12));
+  inner->setRegion(0, 0, 20, 10);
+  CPPUNIT_ASSERT_EQUAL(true, matrix->get(18, 10));
+  CPPUNIT_ASSERT_EQUAL(true, matrix->get(37, 19));
+
+  try {
+    view->crop(60, 0, 11, 40);
+    CPPUNIT_FAIL("expected IllegalArgumentException");
+  } catch (IllegalArgumentException const&) {
+    // expected
+  }
+}
+
+void BitMatrixTest::testLazyCrop() {
+  const int width = 200;
+  const int height = 70;
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  Ref<PatternTiles> tiles(new PatternTiles(width));
+  matrix->setTileSource(tiles);
+  // Three tiles across: [0, 64), [64, 128) and [128, 200).
+  Ref<BitMatrix> view = matrix->crop(70, 10, 50, 50);
+  CPPUNIT_ASSERT_EQUAL((size_t)0, matrix->getTilesFilled());
+  for (int y = 0; y < 50; y++) {
+    for (int x = 0; x < 50; x++) {
+      CPPUNIT_ASSERT_EQUAL((x + 70 + y + 10) % 3 == 0, view->get(x, y));
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t)1, matrix->getTilesFilled());
+  view->crop(0, 0, 5, 5)->getBits();
+  CPPUNIT_ASSERT_EQUAL((size_t)1, matrix->getTilesFilled());
+  // Straddles the filled middle tile and the last one.
+  matrix->crop(120, 0, 20, 5)->getRow(0, Ref<BitArray>());
+  CPPUNIT_ASSERT_EQUAL((size_t)2, matrix->getTilesFilled());
+  CPPUNIT_ASSERT_EQUAL((size_t)8, tiles->calls_.size());
+}
+
 void BitMatrixTest::runBitMatrixGetRowTest(int width, int height) {
   BitMatrix mat(width, height);
   for (int y = 0; y < height; y++) {
@@ -33,6 +33,14 @@ class BitMatrixTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST(testGetRow1);
   CPPUNIT_TEST(testGetRow2);
   CPPUNIT_TEST(testGetRow3);
+  CPPUNIT_TEST(testSetRow);
+  CPPUNIT_TEST(testRowWords);
+  CPPUNIT_TEST(testGetRunEnd);
+  CPPUNIT_TEST(testColumnRuns);
+  CPPUNIT_TEST(testRotateCounterClockwise);
+  CPPUNIT_TEST(testTileSource);
+  CPPUNIT_TEST(testCrop);
+  CPPUNIT_TEST(testLazyCrop);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -45,6 +53,14 @@ protected:
   void testGetRow1();
   void testGetRow2();
   void testGetRow3();
+  void testSetRow();
+  void testRowWords();
+  void testGetRunEnd();
+  void testColumnRuns();
+  void testRotateCounterClockwise();
+  void testTileSource();
+  void testCrop();
+  void testLazyCrop();
 
 private:
   void runBitMatrixGetRowTest(int width, int height);
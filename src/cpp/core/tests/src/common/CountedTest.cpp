@@ -21,6 +21,7 @@
 #include "CountedTest.h"
 #include <zxing/common/Counted.h>
 #include <iostream>
+#include <utility>
 
 using namespace std;
 using namespace CPPUNIT_NS;
@@ -34,7 +35,7 @@ public:
   }
 };
 
-//CPPUNIT_TEST_SUITE_REGISTRATION(CountedTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(CountedTest);
 
 void CountedTest::setUp() {}
 void CountedTest::tearDown() {}
@@ -51,4 +52,37 @@ void CountedTest::test() {
   CPPUNIT_ASSERT_EQUAL(1, foo.count());
 }
 
+void CountedTest::testSwap() {
+  Ref<Foo> a(new Foo());
+  Ref<Foo> b(new Foo());
+  Foo* fooA = a;
+  Foo* fooB = b;
+  swap(a, b);
+  CPPUNIT_ASSERT(a.object_ == fooB);
+  CPPUNIT_ASSERT(b.object_ == fooA);
+  CPPUNIT_ASSERT_EQUAL(1, fooA->count());
+  CPPUNIT_ASSERT_EQUAL(1, fooB->count());
+  Ref<Foo> empty;
+  empty.swap(a);
+  CPPUNIT_ASSERT(a.empty());
+  CPPUNIT_ASSERT(empty.object_ == fooB);
+  CPPUNIT_ASSERT_EQUAL(1, fooB->count());
+}
+
+void CountedTest::testMove() {
+#if __cplusplus >= 201103L
+  Ref<Foo> a(new Foo());
+  Foo* foo = a;
+  Ref<Foo> b(std::move(a));
+  CPPUNIT_ASSERT(a.empty());
+  CPPUNIT_ASSERT(b.object_ == foo);
+  CPPUNIT_ASSERT_EQUAL(1, foo->count());
+  Ref<Foo> c(new Foo());
+  c = std::move(b);
+  CPPUNIT_ASSERT(b.empty());
+  CPPUNIT_ASSERT(c.object_ == foo);
+  CPPUNIT_ASSERT_EQUAL(1, foo->count());
+#endif
+}
+
 }
@@ -0,0 +1,94 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  DecodeContextTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DecodeContextTest.h"
+#include <zxing/ResultPoint.h>
+#include <zxing/common/reedsolomon/GenericGF.h>
+#include <zxing/common/reedsolomon/GenericGFPoly.h>
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DecodeContextTest);
+
+void DecodeContextTest::testHeapOutsideScope() {
+  DecodeContext context;
+  {
+    DecodeContext::Scope scope(context);
+  }
+  Ref<ResultPoint> point(new ResultPoint(1, 2));
+  CPPUNIT_ASSERT_EQUAL(2.0f, point->getY());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, context.getAllocations());
+  CPPUNIT_ASSERT_EQUAL((size_t)0, context.getChunks());
+}
+
+void DecodeContextTest::testChunkReused() {
+  DecodeContext context;
+  for (int decode = 0; decode < 10; decode++) {
+    DecodeContext::Scope scope(context);
+    Ref<GenericGFPoly> poly = GenericGF::QR_CODE_FIELD_256->buildMonomial(3, 7);
+    CPPUNIT_ASSERT_EQUAL(7, poly->multiply(1)->getCoefficient(3));
+    for (int i = 0; i < 20; i++) {
+      Ref<ResultPoint> point(new ResultPoint((float)i, (float)decode));
+      CPPUNIT_ASSERT_EQUAL((float)i, point->getX());
+    }
+  }
+  // A monomial and its coefficients, which multiplying by one returns, and
+  // the points, each decode; all of it out of one chunk.
+  CPPUNIT_ASSERT_EQUAL((size_t)(10 * 22), context.getAllocations());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, context.getChunks());
+  CPPUNIT_ASSERT_EQUAL((size_t)(10 * 22 - 1), context.getAllocationsAvoided());
+}
+
+void DecodeContextTest::testSurvivorKeepsChunk() {
+  Ref<ResultPoint> survivor;
+  {
+    DecodeContext context;
+    {
+      DecodeContext::Scope scope(context);
+      survivor.reset(new ResultPoint(3, 4));
+      Ref<ResultPoint> other(new ResultPoint(5, 6));
+    }
+    {
+      DecodeContext::Scope scope(context);
+      Ref<ResultPoint> point(new ResultPoint(7, 8));
+      CPPUNIT_ASSERT_EQUAL(8.0f, point->getY());
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)2, context.getChunks());
+  }
+  CPPUNIT_ASSERT_EQUAL(3.0f, survivor->getX());
+  CPPUNIT_ASSERT_EQUAL(4.0f, survivor->getY());
+}
+
+void DecodeContextTest::testNestedScopes() {
+  DecodeContext outer;
+  DecodeContext inner;
+  DecodeContext::Scope outerScope(outer);
+  Ref<ResultPoint> a(new ResultPoint(1, 1));
+  {
+    DecodeContext::Scope innerScope(inner);
+    Ref<ResultPoint> b(new ResultPoint(2, 2));
+  }
+  Ref<ResultPoint> c(new ResultPoint(3, 3));
+  CPPUNIT_ASSERT_EQUAL((size_t)2, outer.getAllocations());
+  CPPUNIT_ASSERT_EQUAL((size_t)1, inner.getAllocations());
+  CPPUNIT_ASSERT_EQUAL(1.0f, a->getX());
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+ *  DualBinarizerTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DualBinarizerTest.h"
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DualBinarizerTest);
+
+namespace {
+  void assertSameBits(Ref<BitMatrix> expected, Ref<BitMatrix> actual) {
+    int words = (expected->getRowStride() >> 5) * expected->getHeight();
+    for (int w = 0; w < words; w++) {
+      CPPUNIT_ASSERT_EQUAL(expected->getBits()[w], actual->getBits()[w]);
+    }
+  }
+}
+
+DualBinarizerTest::DualBinarizerTest() {
+  srand(getpid());
+}
+
+void DualBinarizerTest::testMatrices() {
+  runMatricesTest(40, 40);
+  runMatricesTest(320, 240);
+  runMatricesTest(101, 67);
+  runMatricesTest(333, 45);
+  // Too small for blocks, where both matrices are the global one.
+  runMatricesTest(39, 120);
+  runMatricesTest(60, 7);
+}
+
+// Dark and light halves with noise, so the global histogram has two peaks.
+void DualBinarizerTest::runMatricesTest(int width, int height) {
+  vector<unsigned char> image(width * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int base = (x * 2 < width) != (y % 16 < 8) ? 40 : 200;
+      image[y * width + x] = (unsigned char)(base + rand() % 41 - 20);
+    }
+  }
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], width, height,
+                                                           0, 0, width, height));
+  DualBinarizer dual(source);
+  assertSameBits(HybridBinarizer(source).getBlackMatrix(), dual.getBlackMatrix());
+  assertSameBits(GlobalHistogramBinarizer(source).getBlackMatrix(), dual.getGlobalBlackMatrix());
+}
+
+void DualBinarizerTest::testFlatImage() {
+  vector<unsigned char> image(64 * 48, 0);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], 64, 48, 0, 0, 64, 48));
+  DualBinarizer dual(source);
+  assertSameBits(HybridBinarizer(source).getBlackMatrix(), dual.getBlackMatrix());
+  try {
+    dual.getGlobalBlackMatrix();
+    CPPUNIT_FAIL("expected IllegalArgumentException");
+  } catch (IllegalArgumentException const&) {
+    // expected
+  }
+
+  Ref<LuminanceSource> small(new GreyscaleLuminanceSource(&image[0], 32, 32, 0, 0, 32, 32));
+  try {
+    DualBinarizer(small).getBlackMatrix();
+    CPPUNIT_FAIL("expected IllegalArgumentException");
+  } catch (IllegalArgumentException const&) {
+    // expected
+  }
+}
+}
@@ -0,0 +1,71 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  FixedArrayTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FixedArrayTest.h"
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FixedArrayTest);
+
+void FixedArrayTest::testFixedArray() {
+  typedef FixedArray<int, 8> SmallArray;
+  SmallArray array(5);
+  CPPUNIT_ASSERT_EQUAL((size_t)8, (size_t)SmallArray::CAPACITY);
+  CPPUNIT_ASSERT_EQUAL((size_t)5, array.size());
+  for (size_t i = 0; i < array.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(0, array[i]);
+    array[i] = (int)i * 3;
+  }
+  CPPUNIT_ASSERT_EQUAL(12, array[4]);
+  CPPUNIT_ASSERT_EQUAL((size_t)0, SmallArray().size());
+}
+
+void FixedArrayTest::testCapacity() {
+  FixedArray<unsigned char, 255> full(255);
+  CPPUNIT_ASSERT_EQUAL((size_t)255, full.size());
+  try {
+    FixedArray<unsigned char, 255> tooBig(256);
+    CPPUNIT_FAIL("expected IllegalArgumentException");
+  } catch (IllegalArgumentException const&) {
+    // expected
+  }
+}
+
+void FixedArrayTest::testSpan() {
+  ArrayRef<int> array(new Array<int>(6));
+  Span<int> span(array);
+  CPPUNIT_ASSERT_EQUAL((size_t)6, span.size());
+  Span<int> part = span.subspan(2, 3);
+  CPPUNIT_ASSERT_EQUAL((size_t)3, part.size());
+  part[0] = 7;
+  part[2] = 9;
+  CPPUNIT_ASSERT_EQUAL(7, array[2]);
+  CPPUNIT_ASSERT_EQUAL(9, array[4]);
+
+  FixedArray<int, 4> fixed(2);
+  Span<int> fixedSpan(fixed);
+  fixedSpan[1] = 5;
+  CPPUNIT_ASSERT_EQUAL(5, fixed[1]);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, fixedSpan.size());
+
+  CPPUNIT_ASSERT_EQUAL((size_t)0, Span<int>(ArrayRef<int>()).size());
+}
+
+}
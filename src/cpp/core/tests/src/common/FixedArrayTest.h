@@ -0,0 +1,42 @@
+#ifndef __FIXED_ARRAY_TEST_H__
+#define __FIXED_ARRAY_TEST_H__
+
+/*
+ *  FixedArrayTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/common/FixedArray.h>
+
+namespace zxing {
+class FixedArrayTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(FixedArrayTest);
+  CPPUNIT_TEST(testFixedArray);
+  CPPUNIT_TEST(testCapacity);
+  CPPUNIT_TEST(testSpan);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testFixedArray();
+  void testCapacity();
+  void testSpan();
+};
+}
+
+#endif // __FIXED_ARRAY_TEST_H__
@@ -0,0 +1,105 @@
+/*
+ *  GlobalHistogramBinarizerTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlobalHistogramBinarizerTest.h"
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GlobalHistogramBinarizerTest);
+
+namespace {
+  const int WIDTH = 83;
+  const int HEIGHT = 41;
+
+  // Alternating dark and light bars of random widths, like a 1D code.
+  vector<unsigned char> barsImage() {
+    vector<unsigned char> image(WIDTH * HEIGHT);
+    for (int y = 0; y < HEIGHT; y++) {
+      bool dark = false;
+      int x = 0;
+      while (x < WIDTH) {
+        int bar = 1 + rand() % 4;
+        for (int i = 0; i < bar && x < WIDTH; i++, x++) {
+          image[y * WIDTH + x] = (unsigned char)((dark ? 30 : 200) + rand() % 20);
+        }
+        dark = !dark;
+      }
+    }
+    return image;
+  }
+
+  void assertRowsEqual(Ref<BitArray> expected, Ref<BitArray> actual) {
+    for (int x = 0; x < WIDTH; x++) {
+      CPPUNIT_ASSERT_EQUAL(expected->get(x), actual->get(x));
+    }
+  }
+}
+
+GlobalHistogramBinarizerTest::GlobalHistogramBinarizerTest() {
+  srand(getpid());
+}
+
+void GlobalHistogramBinarizerTest::testBlackRows() {
+  vector<unsigned char> image = barsImage();
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], WIDTH, HEIGHT,
+                                                           0, 0, WIDTH, HEIGHT));
+  Ref<Binarizer> binarizer(new GlobalHistogramBinarizer(source));
+  Ref<Binarizer> reference(new GlobalHistogramBinarizer(source));
+  vector<Ref<BitArray> > rows;
+  int strides[] = { 1, 3, -2, -5 };
+  for (int i = 0; i < 4; i++) {
+    int stride = strides[i];
+    int first = stride > 0 ? 2 : HEIGHT - 3;
+    int count = 7;
+    // Reuses the arrays of the previous batch.
+    binarizer->getBlackRows(first, count, stride, rows);
+    CPPUNIT_ASSERT_EQUAL(count, (int)rows.size());
+    for (int j = 0; j < count; j++) {
+      Ref<BitArray> expected = reference->getBlackRow(first + j * stride, Ref<BitArray>());
+      assertRowsEqual(expected, rows[j]);
+    }
+  }
+  try {
+    binarizer->getBlackRows(HEIGHT - 3, 4, 1, rows);
+    CPPUNIT_FAIL("Should have thrown an exception");
+  } catch (IllegalArgumentException const&) {
+    // good
+  }
+}
+
+void GlobalHistogramBinarizerTest::testBlackRowsFlatRow() {
+  vector<unsigned char> image = barsImage();
+  for (int x = 0; x < WIDTH; x++) {
+    image[5 * WIDTH + x] = 0;
+  }
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], WIDTH, HEIGHT,
+                                                           0, 0, WIDTH, HEIGHT));
+  Ref<Binarizer> binarizer(new GlobalHistogramBinarizer(source));
+  vector<Ref<BitArray> > rows;
+  binarizer->getBlackRows(3, 5, 1, rows);
+  for (int j = 0; j < 5; j++) {
+    CPPUNIT_ASSERT_EQUAL(j == 2, rows[j] == NULL);
+  }
+}
+}
@@ -0,0 +1,145 @@
+/*
+ *  GreyscaleLuminanceSourceTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GreyscaleLuminanceSourceTest.h"
+#include <zxing/common/GreyscaleRotatedLuminanceSource.h>
+#include <zxing/common/LuminanceKernels.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GreyscaleLuminanceSourceTest);
+
+namespace {
+  const int WIDTH = 37;
+  const int HEIGHT = 23;
+
+  vector<unsigned char> testImage() {
+    vector<unsigned char> image(WIDTH * HEIGHT);
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+      image[i] = (unsigned char)(i * 7);
+    }
+    return image;
+  }
+}
+
+void GreyscaleLuminanceSourceTest::assertViewMatchesRows(LuminanceSource& source) {
+  LuminanceView view = source.getMatrixView();
+  CPPUNIT_ASSERT_EQUAL(source.getWidth(), view.getWidth());
+  CPPUNIT_ASSERT_EQUAL(source.getHeight(), view.getHeight());
+  vector<unsigned char> row(source.getWidth());
+  for (int y = 0; y < source.getHeight(); y++) {
+    source.getRow(y, &row[0]);
+    for (int x = 0; x < source.getWidth(); x++) {
+      CPPUNIT_ASSERT_EQUAL((int)row[x], (int)view.getRow(y)[x]);
+    }
+  }
+}
+
+void GreyscaleLuminanceSourceTest::testMatrixView() {
+  vector<unsigned char> image = testImage();
+  GreyscaleLuminanceSource source(&image[0], WIDTH, HEIGHT, 0, 0, WIDTH, HEIGHT);
+  LuminanceView view = source.getMatrixView();
+  CPPUNIT_ASSERT(view.isBorrowed());
+  CPPUNIT_ASSERT(view.getRow(0) == &image[0]);
+  CPPUNIT_ASSERT_EQUAL(WIDTH, view.getStride());
+  assertViewMatchesRows(source);
+}
+
+void GreyscaleLuminanceSourceTest::testCroppedMatrixView() {
+  vector<unsigned char> image = testImage();
+  GreyscaleLuminanceSource source(&image[0], WIDTH, HEIGHT, 5, 3, 20, 11);
+  LuminanceView view = source.getMatrixView();
+  CPPUNIT_ASSERT(view.isBorrowed());
+  CPPUNIT_ASSERT(view.getRow(2) == &image[5 * WIDTH + 5]);
+  CPPUNIT_ASSERT_EQUAL(WIDTH, view.getStride());
+  assertViewMatchesRows(source);
+}
+
+void GreyscaleLuminanceSourceTest::testRotatedMatrixView() {
+  vector<unsigned char> image = testImage();
+  GreyscaleLuminanceSource source(&image[0], WIDTH, HEIGHT, 5, 3, 20, 11);
+  Ref<LuminanceSource> rotated = source.rotateCounterClockwise();
+  // The view lends the source's own rotated copy.
+  CPPUNIT_ASSERT(rotated->getMatrixView().isBorrowed());
+  assertViewMatchesRows(*rotated);
+}
+
+void GreyscaleLuminanceSourceTest::testRotatedPixels() {
+  vector<unsigned char> image = testImage();
+  // 20 rotated rows: one whole band and a partial one. The rotated top
+  // counts from the right edge of the data.
+  GreyscaleLuminanceSource source(&image[0], WIDTH, HEIGHT, 5, 3, 20, 11);
+  Ref<LuminanceSource> rotated = source.rotateCounterClockwise();
+  CPPUNIT_ASSERT_EQUAL(11, rotated->getWidth());
+  CPPUNIT_ASSERT_EQUAL(20, rotated->getHeight());
+  vector<unsigned char> row(11);
+  // Rows of the partial band first, so that bands are filled out of order.
+  for (int y = 19; y >= 0; y--) {
+    rotated->getRow(y, &row[0]);
+    for (int x = 0; x < 11; x++) {
+      CPPUNIT_ASSERT_EQUAL((int)image[(3 + x) * WIDTH + WIDTH - 1 - 5 - y], (int)row[x]);
+    }
+  }
+  unsigned char* matrix = rotated->getMatrix();
+  for (int y = 0; y < 20; y++) {
+    for (int x = 0; x < 11; x++) {
+      CPPUNIT_ASSERT_EQUAL((int)image[(3 + x) * WIDTH + WIDTH - 1 - 5 - y], (int)matrix[y * 11 + x]);
+    }
+  }
+  delete[] matrix;
+}
+
+void GreyscaleLuminanceSourceTest::testRotateKernel() {
+  const int size = 50;
+  vector<unsigned char> src(size * size);
+  for (int i = 0; i < size * size; i++) {
+    src[i] = (unsigned char)rand();
+  }
+  simd::Level levels[] = { simd::SCALAR, simd::SSE2, simd::AVX2, simd::NEON };
+  // Sizes on both sides of whole tiles, so that partial tiles take the
+  // scalar path next to vector ones.
+  int sizes[] = { 1, 15, 16, 17, 32, 47 };
+  for (int l = 0; l < 4; l++) {
+    if (!simd::isSupported(levels[l])) {
+      continue;
+    }
+    for (int w = 0; w < 6; w++) {
+      for (int h = 0; h < 6; h++) {
+        int width = sizes[w];
+        int height = sizes[h];
+        // dst rows are padded by 2, which must be left alone.
+        int dstStride = height + 2;
+        vector<unsigned char> dst(width * dstStride, 0xAB);
+        kernels::rotateCounterClockwise(levels[l], &src[0], size, width, height,
+                                        &dst[0], dstStride);
+        for (int y = 0; y < width; y++) {
+          for (int x = 0; x < height; x++) {
+            CPPUNIT_ASSERT_EQUAL((int)src[x * size + width - 1 - y], (int)dst[y * dstStride + x]);
+          }
+          CPPUNIT_ASSERT_EQUAL(0xAB, (int)dst[y * dstStride + height]);
+          CPPUNIT_ASSERT_EQUAL(0xAB, (int)dst[y * dstStride + height + 1]);
+        }
+      }
+    }
+  }
+}
+}
@@ -0,0 +1,49 @@
+#ifndef __GREYSCALE_LUMINANCE_SOURCE_TEST_H__
+#define __GREYSCALE_LUMINANCE_SOURCE_TEST_H__
+
+/*
+ *  GreyscaleLuminanceSourceTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+
+namespace zxing {
+class GreyscaleLuminanceSourceTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(GreyscaleLuminanceSourceTest);
+  CPPUNIT_TEST(testMatrixView);
+  CPPUNIT_TEST(testCroppedMatrixView);
+  CPPUNIT_TEST(testRotatedMatrixView);
+  CPPUNIT_TEST(testRotatedPixels);
+  CPPUNIT_TEST(testRotateKernel);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testMatrixView();
+  void testCroppedMatrixView();
+  void testRotatedMatrixView();
+  void testRotatedPixels();
+  void testRotateKernel();
+
+private:
+  static void assertViewMatchesRows(LuminanceSource& source);
+};
+}
+
+#endif // __GREYSCALE_LUMINANCE_SOURCE_TEST_H__
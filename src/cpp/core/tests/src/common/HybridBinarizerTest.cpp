@@ -0,0 +1,266 @@
+/*
+ *  HybridBinarizerTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HybridBinarizerTest.h"
+#include <zxing/common/BinarizerKernels.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <stdlib.h>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(HybridBinarizerTest);
+
+namespace {
+  // The original one-pixel-at-a-time implementation, kept as the reference
+  // the optimized binarizer must match bit for bit.
+  Ref<BitMatrix> referenceBlackMatrix(unsigned char const* luminances,
+                                      int width,
+                                      int height) {
+    int subWidth = (width + 7) >> 3;
+    int subHeight = (height + 7) >> 3;
+    vector<int> blackPoints(subWidth * subHeight);
+    for (int y = 0; y < subHeight; y++) {
+      int yoffset = min(y << 3, height - 8);
+      for (int x = 0; x < subWidth; x++) {
+        int xoffset = min(x << 3, width - 8);
+        int sum = 0;
+        int mn = 0xFF;
+        int mx = 0;
+        for (int yy = 0; yy < 8; yy++) {
+          for (int xx = 0; xx < 8; xx++) {
+            int pixel = luminances[(yoffset + yy) * width + xoffset + xx];
+            sum += pixel;
+            mn = min(mn, pixel);
+            mx = max(mx, pixel);
+          }
+        }
+        int average = sum >> 6;
+        if (mx - mn <= 24) {
+          average = mn >> 1;
+          if (y > 0 && x > 0) {
+            int bp = (blackPoints[(y - 1) * subWidth + x] +
+                      2 * blackPoints[y * subWidth + x - 1] +
+                      blackPoints[(y - 1) * subWidth + x - 1]) >> 2;
+            if (mn < bp) {
+              average = bp;
+            }
+          }
+        }
+        blackPoints[y * subWidth + x] = average;
+      }
+    }
+    Ref<BitMatrix> matrix(new BitMatrix(width, height));
+    for (int y = 0; y < subHeight; y++) {
+      int yoffset = min(y << 3, height - 8);
+      for (int x = 0; x < subWidth; x++) {
+        int xoffset = min(x << 3, width - 8);
+        int left = min(max(x, 2), subWidth - 3);
+        int top = min(max(y, 2), subHeight - 3);
+        int sum = 0;
+        for (int z = -2; z <= 2; z++) {
+          for (int w = -2; w <= 2; w++) {
+            sum += blackPoints[(top + z) * subWidth + left + w];
+          }
+        }
+        int average = sum / 25;
+        for (int yy = 0; yy < 8; yy++) {
+          for (int xx = 0; xx < 8; xx++) {
+            if (luminances[(yoffset + yy) * width + xoffset + xx] <= average) {
+              matrix->set(xoffset + xx, yoffset + yy);
+            }
+          }
+        }
+      }
+    }
+    return matrix;
+  }
+}
+
+HybridBinarizerTest::HybridBinarizerTest() {
+  srand(getpid());
+}
+
+// A mix of noisy and nearly flat 16x16 patches, so that both the contrast
+// and the low dynamic range branches get exercised.
+vector<unsigned char> HybridBinarizerTest::randomImage(int width, int height) {
+  vector<unsigned char> image(width * height);
+  int patchesAcross = (width + 15) / 16;
+  int patchesDown = (height + 15) / 16;
+  vector<int> bases(patchesAcross * patchesDown);
+  vector<int> ranges(patchesAcross * patchesDown);
+  for (size_t i = 0; i < bases.size(); i++) {
+    bases[i] = rand() & 0xFF;
+    ranges[i] = (rand() & 1) ? 256 : (rand() % 30) + 1;
+  }
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int patch = (y / 16) * patchesAcross + x / 16;
+      int value = bases[patch] + rand() % ranges[patch] - ranges[patch] / 2;
+      image[y * width + x] = (unsigned char)max(0, min(255, value));
+    }
+  }
+  return image;
+}
+
+void HybridBinarizerTest::testBlockStatistics() {
+  const int width = 8 * 37;
+  const int height = 8;
+  vector<unsigned char> image = randomImage(width, height);
+  vector<int> sums(37), mins(37), maxs(37);
+  kernels::blockStatistics(simd::SCALAR, &image[0], width, 37, &sums[0], &mins[0], &maxs[0]);
+  for (int x = 0; x < 37; x++) {
+    int sum = 0;
+    int mn = 0xFF;
+    int mx = 0;
+    for (int yy = 0; yy < 8; yy++) {
+      for (int xx = 0; xx < 8; xx++) {
+        int pixel = image[yy * width + x * 8 + xx];
+        sum += pixel;
+        mn = min(mn, pixel);
+        mx = max(mx, pixel);
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(sum, sums[x]);
+    CPPUNIT_ASSERT_EQUAL(mn, mins[x]);
+    CPPUNIT_ASSERT_EQUAL(mx, maxs[x]);
+  }
+
+  simd::Level levels[] = { simd::SSE2, simd::AVX2, simd::NEON };
+  for (int i = 0; i < 3; i++) {
+    if (!simd::isSupported(levels[i])) {
+      continue;
+    }
+    // Every count from 0 up, so that each vector width's scalar tail runs.
+    for (int count = 0; count <= 37; count++) {
+      vector<int> vsums(37, -1), vmins(37, -1), vmaxs(37, -1);
+      kernels::blockStatistics(levels[i], &image[0], width, count,
+                               &vsums[0], &vmins[0], &vmaxs[0]);
+      for (int x = 0; x < count; x++) {
+        CPPUNIT_ASSERT_EQUAL(sums[x], vsums[x]);
+        CPPUNIT_ASSERT_EQUAL(mins[x], vmins[x]);
+        CPPUNIT_ASSERT_EQUAL(maxs[x], vmaxs[x]);
+      }
+      for (int x = count; x < 37; x++) {
+        CPPUNIT_ASSERT_EQUAL(-1, vsums[x]);
+      }
+    }
+  }
+}
+
+void HybridBinarizerTest::testThresholdRow() {
+  const int width = 200;
+  vector<unsigned char> pixels = randomImage(width, 1);
+  vector<unsigned char> thresholds = randomImage(width, 1);
+  vector<unsigned int> expected((width + 31) >> 5, 0);
+  for (int x = 0; x < width; x++) {
+    if (pixels[x] <= thresholds[x]) {
+      expected[x >> 5] |= 1u << (x & 31);
+    }
+  }
+
+  simd::Level levels[] = { simd::SCALAR, simd::SSE2, simd::AVX2, simd::NEON };
+  for (int i = 0; i < 4; i++) {
+    if (!simd::isSupported(levels[i])) {
+      continue;
+    }
+    for (int count = 1; count <= width; count++) {
+      int words = (count + 31) >> 5;
+      vector<unsigned int> bits(words, 0xFFFFFFFF);
+      kernels::thresholdRow(levels[i], &pixels[0], &thresholds[0], count, &bits[0]);
+      for (int w = 0; w < words; w++) {
+        unsigned int mask = (w + 1) * 32 <= count ? 0xFFFFFFFF : (1u << (count & 31)) - 1;
+        CPPUNIT_ASSERT_EQUAL(expected[w] & mask, bits[w]);
+      }
+    }
+  }
+}
+
+void HybridBinarizerTest::testBlackMatrix() {
+  runBlackMatrixTest(40, 40);
+  runBlackMatrixTest(320, 240);
+  runBlackMatrixTest(101, 67);
+  runBlackMatrixTest(333, 45);
+}
+
+void HybridBinarizerTest::runBlackMatrixTest(int width, int height) {
+  vector<unsigned char> image = randomImage(width, height);
+  Ref<BitMatrix> expected = referenceBlackMatrix(&image[0], width, height);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], width, height,
+                                                           0, 0, width, height));
+  Ref<Binarizer> binarizer(new HybridBinarizer(source));
+  Ref<BitMatrix> matrix = binarizer->getBlackMatrix();
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      CPPUNIT_ASSERT_EQUAL(expected->get(x, y), matrix->get(x, y));
+    }
+  }
+}
+void HybridBinarizerTest::testThreadedBlackMatrix() {
+  int sizes[][2] = { { 40, 40 }, { 333, 45 }, { 101, 267 }, { 640, 483 }, { 1001, 1003 } };
+  for (int i = 0; i < 5; i++) {
+    int width = sizes[i][0];
+    int height = sizes[i][1];
+    vector<unsigned char> image = randomImage(width, height);
+    Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], width, height,
+                                                             0, 0, width, height));
+    Ref<BitMatrix> serial = HybridBinarizer(source).getBlackMatrix();
+    for (int threads = 2; threads <= 8; threads += 3) {
+      Ref<HybridBinarizer> binarizer(new HybridBinarizer(source, threads));
+      Ref<BitMatrix> matrix = binarizer->getBlackMatrix();
+      int words = (matrix->getRowStride() >> 5) * height;
+      for (int w = 0; w < words; w++) {
+        CPPUNIT_ASSERT_EQUAL(serial->getBits()[w], matrix->getBits()[w]);
+      }
+    }
+  }
+}
+
+void HybridBinarizerTest::testLazyBlackMatrix() {
+  int sizes[][2] = { { 40, 40 }, { 128, 64 }, { 130, 200 }, { 333, 45 }, { 640, 483 } };
+  for (int i = 0; i < 5; i++) {
+    int width = sizes[i][0];
+    int height = sizes[i][1];
+    vector<unsigned char> image = randomImage(width, height);
+    Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], width, height,
+                                                             0, 0, width, height));
+    Ref<BitMatrix> serial = HybridBinarizer(source).getBlackMatrix();
+    Ref<HybridBinarizer> binarizer(new HybridBinarizer(source, 1, true));
+    Ref<BitMatrix> matrix = binarizer->getBlackMatrix();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, matrix->getTilesFilled());
+    // A single read only fills its own tile.
+    int x0 = rand() % width;
+    int y0 = rand() % height;
+    CPPUNIT_ASSERT_EQUAL(serial->get(x0, y0), matrix->get(x0, y0));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, matrix->getTilesFilled());
+    // Tiles filled in random order must still match the serial result.
+    for (int n = 0; n < 200; n++) {
+      int x = rand() % width;
+      int y = rand() % height;
+      CPPUNIT_ASSERT_EQUAL(serial->get(x, y), matrix->get(x, y));
+    }
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        CPPUNIT_ASSERT_EQUAL(serial->get(x, y), matrix->get(x, y));
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(matrix->getTileCount(), matrix->getTilesFilled());
+  }
+}
+}
@@ -0,0 +1,117 @@
+/*
+ *  IntegralImageBinarizerTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IntegralImageBinarizerTest.h"
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IntegralImageBinarizerTest);
+
+namespace {
+  const int WIDTH = 71;
+  const int HEIGHT = 53;
+
+  vector<unsigned char> randomImage() {
+    vector<unsigned char> image(WIDTH * HEIGHT);
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        // A left to right gradient with noise on top, like uneven lighting.
+        image[y * WIDTH + x] = (unsigned char)(x * 2 + (rand() % 100));
+      }
+    }
+    return image;
+  }
+
+  // Sums the window around every pixel directly.
+  bool referenceIsBlack(vector<unsigned char> const& image, int x, int y, int windowSize, int bias) {
+    int radius = windowSize / 2;
+    int sum = 0;
+    int area = 0;
+    for (int yy = max(0, y - radius); yy <= min(HEIGHT - 1, y + radius); yy++) {
+      for (int xx = max(0, x - radius); xx <= min(WIDTH - 1, x + radius); xx++) {
+        sum += image[yy * WIDTH + xx];
+        area++;
+      }
+    }
+    return image[y * WIDTH + x] * area * 100 <= sum * (100 - bias);
+  }
+}
+
+IntegralImageBinarizerTest::IntegralImageBinarizerTest() {
+  srand(getpid());
+}
+
+void IntegralImageBinarizerTest::testBlackMatrix() {
+  vector<unsigned char> image = randomImage();
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], WIDTH, HEIGHT,
+                                                           0, 0, WIDTH, HEIGHT));
+  int windows[] = { 3, 15, 41, 201 };
+  for (int i = 0; i < 4; i++) {
+    Ref<Binarizer> binarizer(new IntegralImageBinarizer(source, windows[i], 10));
+    Ref<BitMatrix> matrix = binarizer->getBlackMatrix();
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        CPPUNIT_ASSERT_EQUAL(referenceIsBlack(image, x, y, windows[i], 10), matrix->get(x, y));
+      }
+    }
+  }
+}
+
+void IntegralImageBinarizerTest::testBlackRow() {
+  vector<unsigned char> image = randomImage();
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], WIDTH, HEIGHT,
+                                                           0, 0, WIDTH, HEIGHT));
+  int windows[] = { 3, 15, 41, 201 };
+  for (int i = 0; i < 4; i++) {
+    Ref<Binarizer> binarizer(new IntegralImageBinarizer(source, windows[i], 10));
+    Ref<BitArray> row;
+    for (int y = 0; y < HEIGHT; y++) {
+      row = binarizer->getBlackRow(y, row);
+      for (int x = 0; x < WIDTH; x++) {
+        CPPUNIT_ASSERT_EQUAL(referenceIsBlack(image, x, y, windows[i], 10), row->get(x));
+      }
+    }
+  }
+}
+
+void IntegralImageBinarizerTest::testInvalidParameters() {
+  vector<unsigned char> image(25 * 25);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], 25, 25, 0, 0, 25, 25));
+  int windows[] = { 1, 4, 257 };
+  for (int i = 0; i < 3; i++) {
+    try {
+      IntegralImageBinarizer binarizer(source, windows[i]);
+      CPPUNIT_FAIL("Should have thrown an exception");
+    } catch (IllegalArgumentException const&) {
+      // good
+    }
+  }
+  try {
+    IntegralImageBinarizer binarizer(source, 15, 100);
+    CPPUNIT_FAIL("Should have thrown an exception");
+  } catch (IllegalArgumentException const&) {
+    // good
+  }
+}
+}
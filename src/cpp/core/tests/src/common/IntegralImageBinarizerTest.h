@@ -0,0 +1,45 @@
+#ifndef __INTEGRAL_IMAGE_BINARIZER_TEST_H__
+#define __INTEGRAL_IMAGE_BINARIZER_TEST_H__
+
+/*
+ *  IntegralImageBinarizerTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/common/IntegralImageBinarizer.h>
+
+namespace zxing {
+class IntegralImageBinarizerTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(IntegralImageBinarizerTest);
+  CPPUNIT_TEST(testBlackMatrix);
+  CPPUNIT_TEST(testBlackRow);
+  CPPUNIT_TEST(testInvalidParameters);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  IntegralImageBinarizerTest();
+
+protected:
+  void testBlackMatrix();
+  void testBlackRow();
+  void testInvalidParameters();
+};
+}
+
+#endif // __INTEGRAL_IMAGE_BINARIZER_TEST_H__
@@ -0,0 +1,111 @@
+/*
+ *  PlanarYUVLuminanceSourceTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PlanarYUVLuminanceSourceTest.h"
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PlanarYUVLuminanceSourceTest);
+
+namespace {
+  const int WIDTH = 37;
+  const int HEIGHT = 23;
+  const int STRIDE = 48;
+
+  // Padding and the interleaved chroma of an NV12 frame are 0xEE, which no
+  // Y pixel is, so reading them shows up as a mismatch.
+  vector<unsigned char> nv12Frame() {
+    vector<unsigned char> frame(STRIDE * HEIGHT * 3 / 2, 0xEE);
+    for (int y = 0; y < HEIGHT; y++) {
+      for (int x = 0; x < WIDTH; x++) {
+        frame[y * STRIDE + x] = (unsigned char)((y * WIDTH + x) % 0xEE);
+      }
+    }
+    return frame;
+  }
+
+  int pixel(int x, int y) {
+    return (y * WIDTH + x) % 0xEE;
+  }
+}
+
+// Checks, through getRow and the matrix view alike, that pixel (x, y) of
+// source is pixel (left + x * xdx + y * ydx, top + x * xdy + y * ydy) of
+// the frame.
+void PlanarYUVLuminanceSourceTest::assertPixels(LuminanceSource& source,
+                                                int left,
+                                                int top,
+                                                int xdx,
+                                                int xdy,
+                                                int ydx,
+                                                int ydy) {
+  LuminanceView view = source.getMatrixView();
+  vector<unsigned char> row(source.getWidth());
+  for (int y = 0; y < source.getHeight(); y++) {
+    source.getRow(y, &row[0]);
+    for (int x = 0; x < source.getWidth(); x++) {
+      int expected = pixel(left + x * xdx + y * ydx, top + x * xdy + y * ydy);
+      CPPUNIT_ASSERT_EQUAL(expected, (int)row[x]);
+      CPPUNIT_ASSERT_EQUAL(expected, (int)view.getRow(y)[x]);
+    }
+  }
+}
+
+void PlanarYUVLuminanceSourceTest::testStridedRows() {
+  vector<unsigned char> frame = nv12Frame();
+  PlanarYUVLuminanceSource source(&frame[0], STRIDE, WIDTH, HEIGHT, 0, 0, WIDTH, HEIGHT);
+  LuminanceView view = source.getMatrixView();
+  CPPUNIT_ASSERT(view.isBorrowed());
+  CPPUNIT_ASSERT(view.getRow(0) == &frame[0]);
+  CPPUNIT_ASSERT_EQUAL(STRIDE, view.getStride());
+  assertPixels(source, 0, 0, 1, 0, 0, 1);
+}
+
+void PlanarYUVLuminanceSourceTest::testCrop() {
+  vector<unsigned char> frame = nv12Frame();
+  PlanarYUVLuminanceSource source(&frame[0], STRIDE, WIDTH, HEIGHT, 5, 3, 20, 11);
+  assertPixels(source, 5, 3, 1, 0, 0, 1);
+  Ref<LuminanceSource> cropped = source.crop(2, 4, 10, 6);
+  CPPUNIT_ASSERT(cropped->getMatrixView().getRow(0) == &frame[7 * STRIDE + 7]);
+  assertPixels(*cropped, 7, 7, 1, 0, 0, 1);
+}
+
+void PlanarYUVLuminanceSourceTest::testRotate() {
+  vector<unsigned char> frame = nv12Frame();
+  PlanarYUVLuminanceSource source(&frame[0], STRIDE, WIDTH, HEIGHT, 5, 3, 20, 11);
+  // Counter-clockwise, the top right corner (24, 3) comes to the top left.
+  Ref<LuminanceSource> rotated = source.rotateCounterClockwise();
+  CPPUNIT_ASSERT_EQUAL(11, rotated->getWidth());
+  CPPUNIT_ASSERT_EQUAL(20, rotated->getHeight());
+  CPPUNIT_ASSERT(!rotated->getMatrixView().isBorrowed());
+  assertPixels(*rotated, 24, 3, 0, 1, -1, 0);
+
+  Ref<LuminanceSource> cropped = rotated->crop(1, 2, 8, 15);
+  assertPixels(*cropped, 22, 4, 0, 1, -1, 0);
+
+  Ref<LuminanceSource> upsideDown = rotated->rotateCounterClockwise();
+  assertPixels(*upsideDown, 24, 13, -1, 0, 0, -1);
+
+  Ref<LuminanceSource> upright = upsideDown->rotateCounterClockwise()->rotateCounterClockwise();
+  CPPUNIT_ASSERT(upright->getMatrixView().getRow(0) == &frame[3 * STRIDE + 5]);
+  assertPixels(*upright, 5, 3, 1, 0, 0, 1);
+}
+}
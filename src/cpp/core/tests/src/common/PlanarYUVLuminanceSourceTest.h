@@ -0,0 +1,46 @@
+#ifndef __PLANAR_YUV_LUMINANCE_SOURCE_TEST_H__
+#define __PLANAR_YUV_LUMINANCE_SOURCE_TEST_H__
+
+/*
+ *  PlanarYUVLuminanceSourceTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/common/PlanarYUVLuminanceSource.h>
+
+namespace zxing {
+class PlanarYUVLuminanceSourceTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(PlanarYUVLuminanceSourceTest);
+  CPPUNIT_TEST(testStridedRows);
+  CPPUNIT_TEST(testCrop);
+  CPPUNIT_TEST(testRotate);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testStridedRows();
+  void testCrop();
+  void testRotate();
+
+private:
+  static void assertPixels(LuminanceSource& source, int left, int top,
+                           int xdx, int xdy, int ydx, int ydy);
+};
+}
+
+#endif // __PLANAR_YUV_LUMINANCE_SOURCE_TEST_H__
@@ -0,0 +1,152 @@
+/*
+ *  PyramidLuminanceSourceTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PyramidLuminanceSourceTest.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <zxing/common/LuminanceKernels.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PyramidLuminanceSourceTest);
+
+namespace {
+  vector<unsigned char> randomImage(int size) {
+    vector<unsigned char> image(size);
+    for (int i = 0; i < size; i++) {
+      image[i] = (unsigned char)rand();
+    }
+    return image;
+  }
+
+  // Asserts that level is the 2x2 box average of above.
+  void assertHalved(LuminanceSource& above, LuminanceSource& level) {
+    CPPUNIT_ASSERT_EQUAL(above.getWidth() / 2, level.getWidth());
+    CPPUNIT_ASSERT_EQUAL(above.getHeight() / 2, level.getHeight());
+    LuminanceView big = above.getMatrixView();
+    LuminanceView small = level.getMatrixView();
+    for (int y = 0; y < level.getHeight(); y++) {
+      for (int x = 0; x < level.getWidth(); x++) {
+        int sum = big.getRow(2 * y)[2 * x] + big.getRow(2 * y)[2 * x + 1] +
+          big.getRow(2 * y + 1)[2 * x] + big.getRow(2 * y + 1)[2 * x + 1];
+        CPPUNIT_ASSERT_EQUAL((sum + 2) / 4, (int)small.getRow(y)[x]);
+      }
+    }
+  }
+}
+
+PyramidLuminanceSourceTest::PyramidLuminanceSourceTest() {
+  srand(getpid());
+}
+
+void PyramidLuminanceSourceTest::testDownsampleRow() {
+  const int count = 75;
+  vector<unsigned char> above = randomImage(2 * count);
+  vector<unsigned char> below = randomImage(2 * count);
+  // All white too, where a carry out of 16 bits or a saturating pack would
+  // show.
+  for (int i = 0; i < 40; i++) {
+    above[i] = below[i] = 0xFF;
+  }
+  vector<unsigned char> expected(count);
+  kernels::downsampleRow(simd::SCALAR, &above[0], &below[0], count, &expected[0]);
+  for (int i = 0; i < count; i++) {
+    int sum = above[2 * i] + above[2 * i + 1] + below[2 * i] + below[2 * i + 1];
+    CPPUNIT_ASSERT_EQUAL((sum + 2) >> 2, (int)expected[i]);
+  }
+  simd::Level levels[] = { simd::SSE2, simd::AVX2, simd::NEON };
+  for (int l = 0; l < 3; l++) {
+    if (!simd::isSupported(levels[l])) {
+      continue;
+    }
+    for (int n = 0; n <= count; n++) {
+      vector<unsigned char> luminances(count, 0xAB);
+      kernels::downsampleRow(levels[l], &above[0], &below[0], n, &luminances[0]);
+      for (int x = 0; x < n; x++) {
+        CPPUNIT_ASSERT_EQUAL((int)expected[x], (int)luminances[x]);
+      }
+      for (int x = n; x < count; x++) {
+        CPPUNIT_ASSERT_EQUAL(0xAB, (int)luminances[x]);
+      }
+    }
+  }
+}
+
+void PyramidLuminanceSourceTest::testLevels() {
+  // Odd sizes, so each level drops a row and a column.
+  const int width = 171;
+  const int height = 167;
+  vector<unsigned char> image = randomImage(width * height);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], width, height,
+                                                           0, 0, width, height));
+  PyramidLuminanceSource pyramid(source);
+  CPPUNIT_ASSERT_EQUAL(width, pyramid.getWidth());
+  CPPUNIT_ASSERT_EQUAL(height, pyramid.getHeight());
+  CPPUNIT_ASSERT(pyramid.getMatrixView().getRow(0) == &image[0]);
+  CPPUNIT_ASSERT_EQUAL(3, pyramid.getLevelCount());
+
+  Ref<LuminanceSource> half = pyramid.getLevel(1);
+  Ref<LuminanceSource> quarter = pyramid.getLevel(2);
+  assertHalved(*source, *half);
+  assertHalved(*half, *quarter);
+  CPPUNIT_ASSERT_EQUAL(42, quarter->getWidth());
+  CPPUNIT_ASSERT_EQUAL(41, quarter->getHeight());
+  // Levels are built once.
+  CPPUNIT_ASSERT(pyramid.getLevel(1).object_ == half.object_);
+  vector<unsigned char> row(quarter->getWidth());
+  quarter->getRow(7, &row[0]);
+  for (int x = 0; x < quarter->getWidth(); x++) {
+    CPPUNIT_ASSERT_EQUAL((int)quarter->getMatrixView().getRow(7)[x], (int)row[x]);
+  }
+
+  CPPUNIT_ASSERT_THROW(pyramid.getLevel(0), IllegalArgumentException);
+  CPPUNIT_ASSERT_THROW(pyramid.getLevel(3), IllegalArgumentException);
+}
+
+void PyramidLuminanceSourceTest::testSmallImage() {
+  vector<unsigned char> image = randomImage(100 * 60);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], 100, 60, 0, 0, 100, 60));
+  CPPUNIT_ASSERT_EQUAL(1, source->getLevelCount());
+  CPPUNIT_ASSERT_THROW(source->getLevel(1), IllegalArgumentException);
+  // Half of 60 is below the minimum dimension.
+  PyramidLuminanceSource pyramid(source);
+  CPPUNIT_ASSERT_EQUAL(1, pyramid.getLevelCount());
+  CPPUNIT_ASSERT_THROW(pyramid.getLevel(1), IllegalArgumentException);
+}
+
+void PyramidLuminanceSourceTest::testBitmapLevels() {
+  vector<unsigned char> image = randomImage(200 * 120);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], 200, 120, 0, 0, 200, 120));
+  Ref<LuminanceSource> pyramid(new PyramidLuminanceSource(source));
+  Ref<BinaryBitmap> bitmap(new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(pyramid))));
+  CPPUNIT_ASSERT_EQUAL(2, bitmap->getLevelCount());
+  Ref<BinaryBitmap> half = bitmap->getLevel(1);
+  CPPUNIT_ASSERT_EQUAL(100, half->getWidth());
+  CPPUNIT_ASSERT_EQUAL(60, half->getHeight());
+  CPPUNIT_ASSERT(bitmap->getLevel(1).object_ == half.object_);
+  Ref<BitMatrix> matrix = half->getBlackMatrix();
+  CPPUNIT_ASSERT_EQUAL(100, matrix->getWidth());
+  CPPUNIT_ASSERT_EQUAL(60, matrix->getHeight());
+}
+}
@@ -0,0 +1,153 @@
+/*
+ *  RGBLuminanceSourceTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RGBLuminanceSourceTest.h"
+#include <stdlib.h>
+#include <vector>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RGBLuminanceSourceTest);
+
+namespace {
+  const int WIDTH = 45;
+  const int HEIGHT = 17;
+  // Rows are padded by 3 pixels.
+  const int STRIDE = (WIDTH + 3) * 4;
+
+  vector<unsigned char> randomPixels(int size) {
+    vector<unsigned char> pixels(size);
+    for (int i = 0; i < size; i++) {
+      pixels[i] = (unsigned char)rand();
+    }
+    return pixels;
+  }
+
+  int weighted(int r, int g, int b) {
+    return (306 * r + 601 * g + 117 * b + 0x200) >> 10;
+  }
+}
+
+RGBLuminanceSourceTest::RGBLuminanceSourceTest() {
+  srand(getpid());
+}
+
+void RGBLuminanceSourceTest::testLuminanceRow() {
+  const int count = 77;
+  vector<unsigned char> pixels = randomPixels(count * 4);
+  // Extremes too, where packing would saturate if the sums were off.
+  for (int i = 0; i < 16; i++) {
+    pixels[i] = 0xFF;
+  }
+  kernels::LuminanceWeights weightings[] = {
+    RGBLuminanceSource::getWeights(RGBLuminanceSource::RGBA, RGBLuminanceSource::WEIGHTED),
+    RGBLuminanceSource::getWeights(RGBLuminanceSource::BGRA, RGBLuminanceSource::SUM)
+  };
+  simd::Level levels[] = { simd::SSE2, simd::AVX2, simd::NEON };
+  for (int w = 0; w < 2; w++) {
+    vector<unsigned char> expected(count);
+    kernels::luminanceRow(simd::SCALAR, &pixels[0], count, weightings[w], &expected[0]);
+    for (int i = 0; i < 3; i++) {
+      if (!simd::isSupported(levels[i])) {
+        continue;
+      }
+      // Every count from 0 up, so that each vector width's scalar tail runs.
+      for (int n = 0; n <= count; n++) {
+        vector<unsigned char> luminances(count, 0xAB);
+        kernels::luminanceRow(levels[i], &pixels[0], n, weightings[w], &luminances[0]);
+        for (int x = 0; x < n; x++) {
+          CPPUNIT_ASSERT_EQUAL((int)expected[x], (int)luminances[x]);
+        }
+        for (int x = n; x < count; x++) {
+          CPPUNIT_ASSERT_EQUAL(0xAB, (int)luminances[x]);
+        }
+      }
+    }
+  }
+}
+
+void RGBLuminanceSourceTest::testWeightings() {
+  vector<unsigned char> pixels = randomPixels(STRIDE * HEIGHT);
+  RGBLuminanceSource rgba(&pixels[0], STRIDE, WIDTH, HEIGHT, 0, 0, WIDTH, HEIGHT,
+                          RGBLuminanceSource::RGBA);
+  RGBLuminanceSource bgra(&pixels[0], STRIDE, WIDTH, HEIGHT, 0, 0, WIDTH, HEIGHT,
+                          RGBLuminanceSource::BGRA, RGBLuminanceSource::SUM);
+  vector<unsigned char> rgbaRow(WIDTH);
+  vector<unsigned char> bgraRow(WIDTH);
+  for (int y = 0; y < HEIGHT; y++) {
+    rgba.getRow(y, &rgbaRow[0]);
+    bgra.getRow(y, &bgraRow[0]);
+    for (int x = 0; x < WIDTH; x++) {
+      unsigned char const* p = &pixels[y * STRIDE + x * 4];
+      CPPUNIT_ASSERT_EQUAL(weighted(p[0], p[1], p[2]), (int)rgbaRow[x]);
+      CPPUNIT_ASSERT_EQUAL((p[2] + p[1] + p[0]) / 3, (int)bgraRow[x]);
+    }
+  }
+  // Every possible sum, including the largest.
+  for (int sum = 0; sum <= 3 * 255; sum++) {
+    unsigned char pixel[4] = { (unsigned char)(sum / 3), (unsigned char)((sum + 1) / 3),
+                               (unsigned char)((sum + 2) / 3), 0 };
+    unsigned char luminance;
+    kernels::luminanceRow(simd::SCALAR, pixel, 1,
+                          RGBLuminanceSource::getWeights(RGBLuminanceSource::RGBA,
+                                                         RGBLuminanceSource::SUM),
+                          &luminance);
+    CPPUNIT_ASSERT_EQUAL(sum / 3, (int)luminance);
+  }
+}
+
+void RGBLuminanceSourceTest::testLazyRows() {
+  vector<unsigned char> pixels = randomPixels(STRIDE * HEIGHT);
+  RGBLuminanceSource source(&pixels[0], STRIDE, WIDTH, HEIGHT, 0, 0, WIDTH, HEIGHT,
+                            RGBLuminanceSource::RGBA);
+  vector<unsigned char> row(WIDTH);
+  source.getRow(5, &row[0]);
+  // Rows are converted once: row 5 keeps its old luminance, while row 6,
+  // not yet asked for, sees the new pixels.
+  for (int i = 5 * STRIDE; i < 7 * STRIDE; i++) {
+    pixels[i] = 0;
+  }
+  vector<unsigned char> again(WIDTH);
+  source.getRow(5, &again[0]);
+  CPPUNIT_ASSERT(row == again);
+  LuminanceView view = source.getMatrixView();
+  CPPUNIT_ASSERT(view.isBorrowed());
+  for (int x = 0; x < WIDTH; x++) {
+    CPPUNIT_ASSERT_EQUAL((int)row[x], (int)view.getRow(5)[x]);
+    CPPUNIT_ASSERT_EQUAL(0, (int)view.getRow(6)[x]);
+  }
+}
+
+void RGBLuminanceSourceTest::testCrop() {
+  vector<unsigned char> pixels = randomPixels(STRIDE * HEIGHT);
+  RGBLuminanceSource source(&pixels[0], STRIDE, WIDTH, HEIGHT, 4, 2, 30, 12,
+                            RGBLuminanceSource::BGRA);
+  Ref<LuminanceSource> cropped = source.crop(3, 5, 20, 6);
+  CPPUNIT_ASSERT_EQUAL(20, cropped->getWidth());
+  CPPUNIT_ASSERT_EQUAL(6, cropped->getHeight());
+  LuminanceView view = cropped->getMatrixView();
+  for (int y = 0; y < 6; y++) {
+    for (int x = 0; x < 20; x++) {
+      unsigned char const* p = &pixels[(y + 7) * STRIDE + (x + 7) * 4];
+      CPPUNIT_ASSERT_EQUAL(weighted(p[2], p[1], p[0]), (int)view.getRow(y)[x]);
+    }
+  }
+}
+}
@@ -0,0 +1,127 @@
+/*
+ *  TemporalBinarizerTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TemporalBinarizerTest.h"
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <stdlib.h>
+
+namespace zxing {
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TemporalBinarizerTest);
+
+namespace {
+  void assertSameBits(Ref<BitMatrix> expected, Ref<BitMatrix> actual) {
+    int words = (expected->getRowStride() >> 5) * expected->getHeight();
+    for (int w = 0; w < words; w++) {
+      CPPUNIT_ASSERT_EQUAL(expected->getBits()[w], actual->getBits()[w]);
+    }
+  }
+}
+
+TemporalBinarizerTest::TemporalBinarizerTest() {
+  srand(getpid());
+}
+
+// Noisy and nearly flat 16x16 patches, as in HybridBinarizerTest.
+vector<unsigned char> TemporalBinarizerTest::randomImage(int width, int height) {
+  vector<unsigned char> image(width * height);
+  int patchesAcross = (width + 15) / 16;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int patch = (y / 16) * patchesAcross + x / 16;
+      int base = (patch * 97) & 0xFF;
+      int range = (patch & 1) ? 256 : 20;
+      int value = base + rand() % range - range / 2;
+      image[y * width + x] = (unsigned char)max(0, min(255, value));
+    }
+  }
+  return image;
+}
+
+Ref<BitMatrix> TemporalBinarizerTest::binarize(vector<unsigned char>& image,
+                                               int width,
+                                               int height,
+                                               Ref<TemporalBinarizer::History> history) {
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], width, height,
+                                                           0, 0, width, height));
+  return TemporalBinarizer(source, history).getBlackMatrix();
+}
+
+void TemporalBinarizerTest::testUnchangedFrame() {
+  const int width = 101;
+  const int height = 67;
+  vector<unsigned char> image = randomImage(width, height);
+  Ref<TemporalBinarizer::History> history(new TemporalBinarizer::History());
+  Ref<BitMatrix> first = binarize(image, width, height, history);
+  int blocks = ((width + 7) >> 3) * ((height + 7) >> 3);
+  CPPUNIT_ASSERT_EQUAL(blocks, history->getBlockCount());
+  CPPUNIT_ASSERT_EQUAL(blocks, history->getBlocksRecomputed());
+
+  // Nudging one pixel stays within the default delta.
+  image[30 * width + 40] ^= 1;
+  Ref<BitMatrix> second = binarize(image, width, height, history);
+  CPPUNIT_ASSERT_EQUAL(0, history->getBlocksRecomputed());
+  CPPUNIT_ASSERT_EQUAL(0, history->getBlocksThresholded());
+  assertSameBits(first, second);
+}
+
+void TemporalBinarizerTest::testChangedRegions() {
+  runChangedRegionsTest(40, 40);
+  runChangedRegionsTest(320, 240);
+  runChangedRegionsTest(101, 67);
+  runChangedRegionsTest(333, 45);
+}
+
+// With a delta of 0 and changes that always move a block's sum, every
+// frame must match a fresh HybridBinarizer bit for bit.
+void TemporalBinarizerTest::runChangedRegionsTest(int width, int height) {
+  vector<unsigned char> image = randomImage(width, height);
+  Ref<TemporalBinarizer::History> history(new TemporalBinarizer::History(0));
+  binarize(image, width, height, history);
+  for (int frame = 0; frame < 10; frame++) {
+    int left = rand() % width;
+    int top = rand() % height;
+    int right = min(width, left + 1 + rand() % 24);
+    int bottom = min(height, top + 1 + rand() % 24);
+    for (int y = top; y < bottom; y++) {
+      for (int x = left; x < right; x++) {
+        image[y * width + x] >>= 1;
+      }
+    }
+    Ref<BitMatrix> matrix = binarize(image, width, height, history);
+    Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&image[0], width, height,
+                                                             0, 0, width, height));
+    assertSameBits(HybridBinarizer(source).getBlackMatrix(), matrix);
+    CPPUNIT_ASSERT(history->getBlocksThresholded() >= history->getBlocksRecomputed());
+  }
+}
+
+void TemporalBinarizerTest::testSizeChange() {
+  Ref<TemporalBinarizer::History> history(new TemporalBinarizer::History());
+  vector<unsigned char> small = randomImage(64, 48);
+  binarize(small, 64, 48, history);
+  vector<unsigned char> large = randomImage(80, 48);
+  Ref<BitMatrix> matrix = binarize(large, 80, 48, history);
+  CPPUNIT_ASSERT_EQUAL(60, history->getBlockCount());
+  CPPUNIT_ASSERT_EQUAL(60, history->getBlocksRecomputed());
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&large[0], 80, 48, 0, 0, 80, 48));
+  assertSameBits(HybridBinarizer(source).getBlackMatrix(), matrix);
+}
+}
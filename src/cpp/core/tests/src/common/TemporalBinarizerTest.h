@@ -0,0 +1,52 @@
+#ifndef __TEMPORAL_BINARIZER_TEST_H__
+#define __TEMPORAL_BINARIZER_TEST_H__
+
+/*
+ *  TemporalBinarizerTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/common/TemporalBinarizer.h>
+#include <vector>
+
+namespace zxing {
+class TemporalBinarizerTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(TemporalBinarizerTest);
+  CPPUNIT_TEST(testUnchangedFrame);
+  CPPUNIT_TEST(testChangedRegions);
+  CPPUNIT_TEST(testSizeChange);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TemporalBinarizerTest();
+
+protected:
+  void testUnchangedFrame();
+  void testChangedRegions();
+  void testSizeChange();
+
+private:
+  std::vector<unsigned char> randomImage(int width, int height);
+  Ref<BitMatrix> binarize(std::vector<unsigned char>& image, int width, int height,
+                          Ref<TemporalBinarizer::History> history);
+  void runChangedRegionsTest(int width, int height);
+};
+}
+
+#endif // __TEMPORAL_BINARIZER_TEST_H__
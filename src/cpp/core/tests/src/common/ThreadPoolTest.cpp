@@ -0,0 +1,91 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  ThreadPoolTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadPoolTest.h"
+#include <string>
+#include <vector>
+#include <zxing/NotFoundException.h>
+#include <zxing/ReaderException.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ThreadPoolTest);
+
+namespace {
+  const int COUNT = 64;
+
+  class CountTask : public ThreadPool::Task {
+  public:
+    std::vector<int> runs;
+
+    CountTask() : runs(COUNT) {
+    }
+
+    void run(int index) {
+      runs[index]++;
+    }
+  };
+
+  // Throws an exception like the one given from one index.
+  template<typename E> class ThrowTask : public ThreadPool::Task {
+  public:
+    void run(int index) {
+      if (index == COUNT / 2) {
+        throw E("band failed");
+      }
+    }
+  };
+}
+
+void ThreadPoolTest::testRun() {
+  ThreadPool pool(4);
+  CountTask task;
+  pool.run(task, COUNT);
+  for (int i = 0; i < COUNT; i++) {
+    CPPUNIT_ASSERT_EQUAL(1, task.runs[i]);
+  }
+}
+
+void ThreadPoolTest::testFailureKeepsKind() {
+  ThreadPool pool(4);
+  ThrowTask<NotFoundException> notFound;
+  try {
+    pool.run(notFound, COUNT);
+    CPPUNIT_FAIL("expected NotFoundException");
+  } catch (NotFoundException const& e) {
+    CPPUNIT_ASSERT_EQUAL(std::string("band failed"), std::string(e.what()));
+  }
+  ThrowTask<IllegalArgumentException> illegalArgument;
+  try {
+    pool.run(illegalArgument, COUNT);
+    CPPUNIT_FAIL("expected IllegalArgumentException");
+  } catch (ReaderException const&) {
+    CPPUNIT_FAIL("IllegalArgumentException thrown as a ReaderException");
+  } catch (IllegalArgumentException const& e) {
+    CPPUNIT_ASSERT_EQUAL(std::string("band failed"), std::string(e.what()));
+  }
+  // The pool is still usable afterwards.
+  CountTask task;
+  pool.run(task, COUNT);
+  CPPUNIT_ASSERT_EQUAL(1, task.runs[COUNT - 1]);
+}
+
+}
@@ -102,6 +102,37 @@ void ReedSolomonTest::testTooManyErrors() {
   }
 }
 
+// Blocks are corrected in place whether they live in a FixedArray or are a
+// span of a larger buffer, and the rest of the buffer is left alone.
+void ReedSolomonTest::testSpans() {
+  int twoS = 2 * qrCodeCorrectable_;
+  size_t size = qrCodeTestWithEc_->size();
+  FixedArray<int, 255> fixed(size);
+  for (size_t i = 0; i < size; i++) {
+    fixed[i] = qrCodeTestWithEc_[i];
+  }
+  fixed[3] ^= 0x5A;
+  qrRSDecoder_->decode(fixed, twoS);
+  for (size_t i = 0; i < qrCodeTest_->size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(qrCodeTest_[i], fixed[i]);
+  }
+
+  ArrayRef<int> buffer(new Array<int>(size + 4));
+  for (size_t i = 0; i < size; i++) {
+    buffer[2 + i] = qrCodeTestWithEc_[i];
+  }
+  buffer[0] = buffer[1] = buffer[size + 2] = buffer[size + 3] = 0x77;
+  buffer[2 + 10] ^= 0x01;
+  buffer[2 + 20] ^= 0xFF;
+  qrRSDecoder_->decode(Span<int>(buffer).subspan(2, size), twoS);
+  for (size_t i = 0; i < qrCodeTest_->size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(qrCodeTest_[i], buffer[2 + i]);
+  }
+  CPPUNIT_ASSERT_EQUAL(0x77, buffer[0]);
+  CPPUNIT_ASSERT_EQUAL(0x77, buffer[1]);
+  CPPUNIT_ASSERT_EQUAL(0x77, buffer[size + 2]);
+  CPPUNIT_ASSERT_EQUAL(0x77, buffer[size + 3]);
+}
 
 void ReedSolomonTest::checkQRRSDecode(ArrayRef<int> &received) {
   int twoS = 2 * qrCodeCorrectable_;
@@ -37,6 +37,7 @@ class ReedSolomonTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testOneError);
   CPPUNIT_TEST(testMaxErrors);
   CPPUNIT_TEST(testTooManyErrors);
+  CPPUNIT_TEST(testSpans);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -48,6 +49,7 @@ protected:
   void testOneError();
   void testMaxErrors();
   void testTooManyErrors();
+  void testSpans();
 
 private:
   ArrayRef<int> qrCodeTest_;
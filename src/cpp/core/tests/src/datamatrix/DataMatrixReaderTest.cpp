@@ -0,0 +1,94 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  DataMatrixReaderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMatrixReaderTest.h"
+#include "../SymbolImage.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/datamatrix/DataMatrixReader.h>
+#include <zxing/datamatrix/detector/Detector.h>
+#include <zxing/datamatrix/decoder/Decoder.h>
+#include <string>
+#include <vector>
+
+namespace zxing {
+namespace datamatrix {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DataMatrixReaderTest);
+
+namespace {
+  const char* const TEXT = "PYRAMID";
+
+  // A 14 by 14 ECC 200 symbol holding TEXT in ASCII encodation.
+  const char* const SYMBOL[] = {
+    "X X X X X X X ",
+    "X X XX    X  X",
+    "X XX X X X    ",
+    "X X   X X  X X",
+    "X  XXX    X X ",
+    "XX  X XXX XXXX",
+    "XX X   XXXXXX ",
+    "X  XXXXX  X XX",
+    "X XXXX  XXX X ",
+    "XX XX  X XX  X",
+    "X XXXX   X X  ",
+    "X  XX X XXX  X",
+    "XX    X X  XX ",
+    "XXXXXXXXXXXXXX",
+  };
+
+  // At 12 pixels a module in a 320 by 320 image, whose pyramid has levels
+  // at 6 and 3 pixels a module. The white rectangle search starts 30
+  // pixels wide, so the symbol has to be wider than that even on the
+  // coarsest level.
+  const int MODULE_SIZE = 12;
+  const int SIZE = 320;
+}
+
+void DataMatrixReaderTest::testDecode() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  DataMatrixReader reader;
+  CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decodeText(reader, bitmap, false));
+}
+
+// Each level finds the symbol on its own, and the grid sampled from the
+// full resolution image decodes.
+void DataMatrixReaderTest::testDetectOnLevel() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  CPPUNIT_ASSERT_EQUAL(3, bitmap->getLevelCount());
+  Decoder decoder;
+  for (int level = 1; level < bitmap->getLevelCount(); level++) {
+    Detector detector(bitmap->getBlackMatrix());
+    Ref<BitMatrix> coarse = bitmap->getLevel(level)->getBlackMatrix();
+    Ref<DetectorResult> detectorResult(detector.detect(coarse, 1 << level));
+    CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decoder.decode(detectorResult->getBits())->getText()->getText());
+  }
+}
+
+void DataMatrixReaderTest::testCoarseToFine() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  DataMatrixReader reader;
+  CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decodeText(reader, bitmap, true));
+}
+
+}
+}
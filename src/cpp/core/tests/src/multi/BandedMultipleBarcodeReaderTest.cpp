@@ -0,0 +1,210 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  BandedMultipleBarcodeReaderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "BandedMultipleBarcodeReaderTest.h"
+#include "../SymbolImage.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/DecodeHints.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/IllegalArgumentException.h>
+#include <zxing/multi/BandedMultipleBarcodeReader.h>
+#include <zxing/qrcode/QRCodeReader.h>
+#include <string>
+#include <vector>
+
+namespace zxing {
+namespace multi {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BandedMultipleBarcodeReaderTest);
+
+namespace {
+  // Version 1-L symbols holding their names, with mask 0.
+  const char* const BAND_OVERLAP[] = {
+    "XXXXXXX   X X XXXXXXX",
+    "X     X     X X     X",
+    "X XXX X X X   X XXX X",
+    "X XXX X     X X XXX X",
+    "X XXX X  X XX X XXX X",
+    "X     X  XXX  X     X",
+    "XXXXXXX X X X XXXXXXX",
+    "        X X          ",
+    "XXX XXXXX X XXX   X  ",
+    "X X    XXX X   X X X ",
+    "      XXXX X XXXXXXXX",
+    "X XX   X X XX  XX  XX",
+    "    X XXX XX XXXX X X",
+    "        XX X X    XX ",
+    "XXXXXXX X X X  XX  XX",
+    "X     X XXXX    X  X ",
+    "X XXX X XX  X XX  XX ",
+    "X XXX X  XX   XX   X ",
+    "X XXX X X  XX XXX X X",
+    "X     X X      X X X ",
+    "XXXXXXX X X X X X  XX",
+  };
+  const char* const ONE_BAND[] = {
+    "XXXXXXX   X X XXXXXXX",
+    "X     X     X X     X",
+    "X XXX X X X   X XXX X",
+    "X XXX X     X X XXX X",
+    "X XXX X  X XX X XXX X",
+    "X     X  XXX  X     X",
+    "XXXXXXX X X X XXXXXXX",
+    "        X X          ",
+    "XXX XXXXX X XXX   X  ",
+    "X   XX  X XX   X  XX ",
+    "X XXXXX  X X  XXX  XX",
+    "  XX     X XXX XX   X",
+    "      XX   X  XX  XX ",
+    "        XX    XX   X ",
+    "XXXXXXX XXX X  XXXXXX",
+    "X     X XXX   X  X X ",
+    "X XXX X XX  X X X    ",
+    "X XXX X  X X X X X X ",
+    "X XXX X XX X XXXX X X",
+    "X     X XX XXX XX  X ",
+    "XXXXXXX X  X XX X XXX",
+  };
+  const char* const LAST_BAND[] = {
+    "XXXXXXX  X XX XXXXXXX",
+    "X     X  XXX  X     X",
+    "X XXX X XX XX X XXX X",
+    "X XXX X  X X  X XXX X",
+    "X XXX X   X X X XXX X",
+    "X     X     X X     X",
+    "XXXXXXX X X X XXXXXXX",
+    "        XX XX        ",
+    "XXX XXXXXXXX XX   X  ",
+    "XXXXX  XX     XX X X ",
+    "  X  XXXXXX X  XXXXXX",
+    " XX     XX         X ",
+    "X     XX  X X X XXXX ",
+    "        X XX   X X X ",
+    "XXXXXXX X XX  XXXX XX",
+    "X     X X XXXX XX    ",
+    "X XXX X XXXX  X XXX  ",
+    "X XXX X       XX   X ",
+    "X XXX X XXX X  XX X X",
+    "X     X XX    XX X X ",
+    "XXXXXXX XXX X X X  XX",
+  };
+
+  const int MODULES = 21;
+  const int MODULE_SIZE = 3;
+  const int WIDTH = 200;
+  const int HEIGHT = 600;
+  // Bands of 240 rows, 80 of them shared with the next band: rows 0, 160,
+  // 320 and 480 on, the last one only 120 rows high.
+  const size_t MAX_BYTES = WIDTH * 240 * BandedMultipleBarcodeReader::BYTES_PER_PIXEL;
+  const int OVERLAP = 80;
+
+  struct Placement {
+    const char* const* symbol;
+    const char* text;
+    int left;
+    int top;
+  };
+
+  const Placement PLACEMENTS[] = {
+    // Rows 170 to 232, whole in the first two bands.
+    { BAND_OVERLAP, "BAND OVERLAP", 20, 170 },
+    // Rows 250 to 312, whole in the second band only.
+    { ONE_BAND, "ONE BAND", 110, 250 },
+    // Rows 520 to 582, whole in the short last band only.
+    { LAST_BAND, "LAST BAND", 60, 520 },
+  };
+  const int SYMBOLS = sizeof(PLACEMENTS) / sizeof(PLACEMENTS[0]);
+
+  // Draws the placed symbols on white a row at a time, the way a scanner
+  // hands over a page; there is no matrix.
+  class PageSource : public LuminanceSource {
+   public:
+    int getWidth() const {
+      return WIDTH;
+    }
+
+    int getHeight() const {
+      return HEIGHT;
+    }
+
+    unsigned char* getRow(int y, unsigned char* row) {
+      for (int x = 0; x < WIDTH; x++) {
+        row[x] = 0xFF;
+      }
+      for (int i = 0; i < SYMBOLS; i++) {
+        Placement const& placement = PLACEMENTS[i];
+        drawSymbolRow(row, y, placement.symbol, MODULE_SIZE, placement.left, placement.top);
+      }
+      return row;
+    }
+
+    unsigned char* getMatrix() {
+      CPPUNIT_FAIL("A banded search must not ask for the whole matrix.");
+      return 0;
+    }
+  };
+}
+
+void BandedMultipleBarcodeReaderTest::testBandHeight() {
+  qrcode::QRCodeReader delegate;
+  BandedMultipleBarcodeReader reader(delegate, MAX_BYTES, OVERLAP);
+  CPPUNIT_ASSERT_EQUAL(240, reader.getBandHeight(WIDTH, HEIGHT));
+  // An image that fits is searched in one band.
+  CPPUNIT_ASSERT_EQUAL(200, reader.getBandHeight(WIDTH, 200));
+  // Bands no taller than the overlap would never move on.
+  CPPUNIT_ASSERT_THROW(reader.getBandHeight(WIDTH * 3, HEIGHT), IllegalArgumentException);
+  CPPUNIT_ASSERT_THROW(BandedMultipleBarcodeReader(delegate, MAX_BYTES, -1),
+                       IllegalArgumentException);
+}
+
+// Each symbol is reported once, with points in the whole image's
+// coordinates, including the one both of the first two bands find.
+void BandedMultipleBarcodeReaderTest::testDecodeMultiple() {
+  Ref<LuminanceSource> source(new PageSource());
+  Ref<BinaryBitmap> image(new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(source))));
+  qrcode::QRCodeReader delegate;
+  BandedMultipleBarcodeReader reader(delegate, MAX_BYTES, OVERLAP);
+  std::vector<Ref<Result> > results =
+    reader.decodeMultiple(image, DecodeHints(DecodeHints::DEFAULT_HINT));
+  CPPUNIT_ASSERT_EQUAL(SYMBOLS, (int)results.size());
+  for (int i = 0; i < SYMBOLS; i++) {
+    Placement const& placement = PLACEMENTS[i];
+    int found = 0;
+    for (size_t j = 0; j < results.size(); j++) {
+      if (results[j]->getText()->getText() != placement.text) {
+        continue;
+      }
+      found++;
+      std::vector<Ref<ResultPoint> > const& points = results[j]->getResultPoints();
+      CPPUNIT_ASSERT(!points.empty());
+      for (size_t k = 0; k < points.size(); k++) {
+        CPPUNIT_ASSERT(points[k]->getX() > placement.left);
+        CPPUNIT_ASSERT(points[k]->getX() < placement.left + MODULES * MODULE_SIZE);
+        CPPUNIT_ASSERT(points[k]->getY() > placement.top);
+        CPPUNIT_ASSERT(points[k]->getY() < placement.top + MODULES * MODULE_SIZE);
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(1, found);
+  }
+}
+
+}
+}
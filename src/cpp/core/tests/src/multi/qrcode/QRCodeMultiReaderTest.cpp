@@ -0,0 +1,128 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  QRCodeMultiReaderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "QRCodeMultiReaderTest.h"
+#include "../../SymbolImage.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/DecodeHints.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/multi/qrcode/QRCodeMultiReader.h>
+#include <string>
+#include <vector>
+
+namespace zxing {
+namespace multi {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(QRCodeMultiReaderTest);
+
+namespace {
+  // Version 1-L symbols holding their names, with mask 0.
+  const char* const FIRST_CODE[] = {
+    "XXXXXXX   X X XXXXXXX",
+    "X     X     X X     X",
+    "X XXX X X X   X XXX X",
+    "X XXX X     X X XXX X",
+    "X XXX X  X XX X XXX X",
+    "X     X  XXX  X     X",
+    "XXXXXXX X X X XXXXXXX",
+    "        X X          ",
+    "XXX XXXXX X XXX   X  ",
+    "   XXX     X  XX XXX ",
+    "XX  XXXX X X X XXXXXX",
+    "X X X  XXX XX   X  XX",
+    " X  XXX    X  X XXXXX",
+    "        X      X X X ",
+    "XXXXXXX XXX X XXX  XX",
+    "X     X X X    X   XX",
+    "X XXX X XX  X X XXX  ",
+    "X XXX X  XXX   XXX X ",
+    "X XXX X XX X XX XX  X",
+    "X     X XX XXX X   X ",
+    "XXXXXXX XX X  XXXXXXX",
+  };
+  const char* const SECOND_CODE[] = {
+    "XXXXXXX  X XX XXXXXXX",
+    "X     X  XXX  X     X",
+    "X XXX X XX XX X XXX X",
+    "X XXX X  X X  X XXX X",
+    "X XXX X   X X X XXX X",
+    "X     X     X X     X",
+    "XXXXXXX X X X XXXXXXX",
+    "        XX XX        ",
+    "XXX XXXXXXXX XX   X  ",
+    "XXXX   X     X X   X ",
+    " X X  XXX   XX XXXXXX",
+    "  X  X X  X    X    X",
+    "  XXX XX X  X X X X X",
+    "        X XX  XXXX   ",
+    "XXXXXXX XX X X  XX XX",
+    "X     X XXXXX  X    X",
+    "X XXX X XXXX  XXX X  ",
+    "X XXX X   XX   X  XX ",
+    "X XXX X XXX X XXXX  X",
+    "X     X XXX    XX  X ",
+    "XXXXXXX X XXX XX  XXX",
+  };
+
+  const int MODULE_SIZE = 5;
+  const int WIDTH = 320;
+  const int HEIGHT = 160;
+
+  std::vector<std::string> decodeMultiple(std::vector<unsigned char>& pixels) {
+    Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&pixels[0], WIDTH, HEIGHT,
+                                                             0, 0, WIDTH, HEIGHT));
+    Ref<BinaryBitmap> image(new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(source))));
+    QRCodeMultiReader reader;
+    std::vector<Ref<Result> > results =
+      reader.decodeMultiple(image, DecodeHints(DecodeHints::DEFAULT_HINT));
+    std::vector<std::string> texts;
+    for (size_t i = 0; i < results.size(); i++) {
+      texts.push_back(results[i]->getText()->getText());
+    }
+    return texts;
+  }
+}
+
+void QRCodeMultiReaderTest::testOneSymbol() {
+  std::vector<unsigned char> pixels(WIDTH * HEIGHT, 0xFF);
+  drawSymbol(pixels, WIDTH, FIRST_CODE, MODULE_SIZE, 100, 25);
+  std::vector<std::string> texts = decodeMultiple(pixels);
+  CPPUNIT_ASSERT_EQUAL((size_t)1, texts.size());
+  CPPUNIT_ASSERT_EQUAL(std::string("FIRST CODE"), texts[0]);
+}
+
+// Each symbol's finder patterns are put in order before its grid is
+// sampled; unordered, neither symbol decodes.
+void QRCodeMultiReaderTest::testTwoSymbols() {
+  std::vector<unsigned char> pixels(WIDTH * HEIGHT, 0xFF);
+  drawSymbol(pixels, WIDTH, FIRST_CODE, MODULE_SIZE, 30, 25);
+  drawSymbol(pixels, WIDTH, SECOND_CODE, MODULE_SIZE, 185, 30);
+  std::vector<std::string> texts = decodeMultiple(pixels);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, texts.size());
+  bool first = texts[0] == "FIRST CODE" || texts[1] == "FIRST CODE";
+  bool second = texts[0] == "SECOND CODE" || texts[1] == "SECOND CODE";
+  CPPUNIT_ASSERT(first);
+  CPPUNIT_ASSERT(second);
+}
+
+}
+}
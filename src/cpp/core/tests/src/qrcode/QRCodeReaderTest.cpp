@@ -0,0 +1,132 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  QRCodeReaderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QRCodeReaderTest.h"
+#include "../SymbolImage.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/DecodeHints.h>
+#include <zxing/qrcode/QRCodeReader.h>
+#include <zxing/qrcode/detector/Detector.h>
+#include <zxing/qrcode/decoder/Decoder.h>
+#include <string>
+#include <vector>
+
+namespace zxing {
+namespace qrcode {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(QRCodeReaderTest);
+
+namespace {
+  const char* const TEXT = "COARSE TO FINE";
+
+  // A version 1-L symbol holding TEXT, with mask 0.
+  const char* const SYMBOL[] = {
+    "XXXXXXX   X X XXXXXXX",
+    "X     X     X X     X",
+    "X XXX X X X   X XXX X",
+    "X XXX X     X X XXX X",
+    "X XXX X  X  X X XXX X",
+    "X     X  XXX  X     X",
+    "XXXXXXX X X X XXXXXXX",
+    "        X X          ",
+    "XXX XXXXX XXXXX   X  ",
+    "X XXXX    XX      XX ",
+    " XXXX X  X XX XXXX XX",
+    "X   X    X XX  X    X",
+    "      X  X X  X X X X",
+    "        XX X  XXXX X ",
+    "XXXXXXX XXXXXX  XXXXX",
+    "X     X X X  X     XX",
+    "X XXX X XXX    XXXXX ",
+    "X XXX X    X X X X X ",
+    "X XXX X XX XX XXX   X",
+    "X     X X XXX   X  X ",
+    "XXXXXXX X  XX X XXXXX",
+  };
+
+  // At 8 pixels a module in a 320 by 320 image, whose pyramid has levels
+  // at 4 and 2 pixels a module.
+  const int MODULE_SIZE = 8;
+  const int SIZE = 320;
+}
+
+void QRCodeReaderTest::testDecode() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  QRCodeReader reader;
+  CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decodeText(reader, bitmap, false));
+}
+
+// Each level finds the symbol on its own, and the grid sampled from the
+// full resolution image decodes.
+void QRCodeReaderTest::testDetectOnLevel() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  CPPUNIT_ASSERT_EQUAL(3, bitmap->getLevelCount());
+  DecodeHints hints(DecodeHints::DEFAULT_HINT);
+  Decoder decoder;
+  for (int level = 1; level < bitmap->getLevelCount(); level++) {
+    Detector detector(bitmap->getBlackMatrix());
+    Ref<BitMatrix> coarse = bitmap->getLevel(level)->getBlackMatrix();
+    Ref<DetectorResult> detectorResult(detector.detect(coarse, 1 << level, hints));
+    CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decoder.decode(detectorResult->getBits())->getText()->getText());
+  }
+}
+
+void QRCodeReaderTest::testCoarseToFine() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  QRCodeReader reader;
+  CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decodeText(reader, bitmap, true));
+}
+
+// The cross-checks read from the transposed copy find the same points as
+// the ones walking the matrix, on full resolution and on coarse levels.
+void QRCodeReaderTest::testColumnCopy() {
+  std::vector<unsigned char> pixels;
+  Ref<BinaryBitmap> bitmap = centredSymbol(pixels, SYMBOL, MODULE_SIZE, SIZE);
+  DecodeHints hints(DecodeHints::DEFAULT_HINT);
+  Detector plainDetector(bitmap->getBlackMatrix());
+  std::vector<Ref<ResultPoint> > expected(plainDetector.detect(hints)->getPoints());
+  Ref<BitMatrix> coarse = bitmap->getLevel(1)->getBlackMatrix();
+  std::vector<Ref<ResultPoint> > expectedCoarse(
+    plainDetector.detect(coarse, 2, hints)->getPoints());
+
+  hints.setColumnCopy(true);
+  Detector detector(bitmap->getBlackMatrix());
+  std::vector<Ref<ResultPoint> > actual(detector.detect(hints)->getPoints());
+  std::vector<Ref<ResultPoint> > actualCoarse(detector.detect(coarse, 2, hints)->getPoints());
+  CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+  CPPUNIT_ASSERT_EQUAL(expectedCoarse.size(), actualCoarse.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(expected[i]->getX(), actual[i]->getX());
+    CPPUNIT_ASSERT_EQUAL(expected[i]->getY(), actual[i]->getY());
+  }
+  for (size_t i = 0; i < expectedCoarse.size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(expectedCoarse[i]->getX(), actualCoarse[i]->getX());
+    CPPUNIT_ASSERT_EQUAL(expectedCoarse[i]->getY(), actualCoarse[i]->getY());
+  }
+
+  QRCodeReader reader;
+  CPPUNIT_ASSERT_EQUAL(std::string(TEXT), reader.decode(bitmap, hints)->getText()->getText());
+}
+
+}
+}
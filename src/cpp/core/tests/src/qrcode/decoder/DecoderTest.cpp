@@ -0,0 +1,123 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  DecoderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DecoderTest.h"
+#include "../../SymbolImage.h"
+#include <zxing/common/ThreadPool.h>
+#include <zxing/common/reedsolomon/GenericGF.h>
+#include <zxing/common/reedsolomon/GenericGFPoly.h>
+#include <zxing/qrcode/Version.h>
+#include <zxing/qrcode/decoder/DataMask.h>
+#include <string>
+#include <vector>
+
+namespace zxing {
+namespace qrcode {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DecoderTest);
+
+namespace {
+  const char* const TEXT = "SIXTEEN THREADS";
+
+  // A version 1-L symbol holding TEXT, with mask 0.
+  const char* const SYMBOL[] = {
+    "XXXXXXX  X  X XXXXXXX",
+    "X     X  XXX  X     X",
+    "X XXX X XX X  X XXX X",
+    "X XXX X  X X  X XXX X",
+    "X XXX X   XXX X XXX X",
+    "X     X       X     X",
+    "XXXXXXX X X X XXXXXXX",
+    "        XX X         ",
+    "XXX XXXXXXXXXXX   X  ",
+    " XXX X  XX X X XXXXX ",
+    "XX   XX XXXXX X XXXXX",
+    "   XXX   X     XX   X",
+    "XX    X  X  XXXX XX X",
+    "        XXXX   X XX  ",
+    "XXXXXXX X  XX XXX XXX",
+    "X     X X           X",
+    "X XXX X XXXXX XXXXXX ",
+    "X XXX X    X XXX   X ",
+    "X XXX X X  XX XXX X X",
+    "X     X XX XX      X ",
+    "XXXXXXX X X XXXXX XXX",
+  };
+
+  // The symbol with up to two modules of the bottom right data codeword
+  // flipped, so that most decodes need error correction.
+  Ref<BitMatrix> symbol(int damage) {
+    Ref<BitMatrix> bits = symbolMatrix(SYMBOL);
+    for (int i = 0; i < damage % 3; i++) {
+      bits->flip(20 - i, 20);
+    }
+    return bits;
+  }
+
+  class DecodeTask : public ThreadPool::Task {
+  public:
+    static const int DECODES = 200;
+    std::vector<int> failures;
+
+    DecodeTask(int threads) : failures(threads) {
+    }
+
+    void run(int index) {
+      Decoder decoder;
+      for (int i = 0; i < DECODES; i++) {
+        if (decoder.decode(symbol(i))->getText()->getText() != TEXT) {
+          failures[index]++;
+        }
+      }
+    }
+  };
+}
+
+void DecoderTest::testDecode() {
+  Decoder decoder;
+  for (int damage = 0; damage < 3; damage++) {
+    CPPUNIT_ASSERT_EQUAL(std::string(TEXT), decoder.decode(symbol(damage))->getText()->getText());
+  }
+}
+
+void DecoderTest::testSharedTablesAreImmortal() {
+  Ref<GenericGF> field = GenericGF::QR_CODE_FIELD_256;
+  Ref<GenericGFPoly> one = field->getOne();
+  Ref<Version> version(Version::getVersionForNumber(1));
+  CPPUNIT_ASSERT(field->count() == (int)Counted::IMMORTAL);
+  CPPUNIT_ASSERT(one->count() == (int)Counted::IMMORTAL);
+  CPPUNIT_ASSERT(one->getCoefficients()->count() == (int)Counted::IMMORTAL);
+  CPPUNIT_ASSERT(version->count() == (int)Counted::IMMORTAL);
+  CPPUNIT_ASSERT(DataMask::forReference(0).count() == (int)Counted::IMMORTAL);
+}
+
+// Every thread decodes with the same fields, versions and masks.
+void DecoderTest::testConcurrentDecode() {
+  const int threads = 16;
+  ThreadPool pool(threads);
+  DecodeTask task(threads);
+  pool.run(task, threads);
+  for (int i = 0; i < threads; i++) {
+    CPPUNIT_ASSERT_EQUAL(0, task.failures[i]);
+  }
+}
+
+}
+}
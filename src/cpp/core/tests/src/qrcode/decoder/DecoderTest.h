@@ -0,0 +1,46 @@
+#ifndef __DECODER_TEST_H__
+#define __DECODER_TEST_H__
+
+/*
+ *  DecoderTest.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/qrcode/decoder/Decoder.h>
+
+namespace zxing {
+namespace qrcode {
+
+class DecoderTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(DecoderTest);
+  CPPUNIT_TEST(testDecode);
+  CPPUNIT_TEST(testSharedTablesAreImmortal);
+  CPPUNIT_TEST(testConcurrentDecode);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testDecode();
+  void testSharedTablesAreImmortal();
+  void testConcurrentDecode();
+};
+
+}
+}
+
+#endif // __DECODER_TEST_H__
@@ -0,0 +1,176 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  FinderPatternFinderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "FinderPatternFinderTest.h"
+#include "PixelFinderPatternFinder.h"
+#include <zxing/DecodeHints.h>
+#include <zxing/ReaderException.h>
+#include <zxing/common/BitMatrix.h>
+#include <zxing/qrcode/detector/FinderPatternFinder.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+namespace zxing {
+namespace qrcode {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FinderPatternFinderTest);
+
+namespace {
+  const int MATRICES = 400;
+
+  unsigned int seed;
+
+  // Its own generator, so every run checks the same matrices.
+  int random(int limit) {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 8) % (unsigned int)limit);
+  }
+
+  // A finder pattern with its top left corner at x, y, clipped to matrix.
+  void drawFinder(BitMatrix& matrix, int left, int top, int moduleSize) {
+    for (int y = 0; y < 7 * moduleSize; y++) {
+      for (int x = 0; x < 7 * moduleSize; x++) {
+        int ring = std::max(abs(x / moduleSize - 3), abs(y / moduleSize - 3));
+        int matrixX = left + x;
+        int matrixY = top + y;
+        if (ring != 2 && matrixX >= 0 && matrixY >= 0 &&
+            matrixX < (int)matrix.getWidth() && matrixY < (int)matrix.getHeight()) {
+          matrix.set(matrixX, matrixY);
+        }
+      }
+    }
+  }
+
+  // A band a few pixels high of bars one to four pixels wide: rows across
+  // it look like finder patterns which the vertical check then turns down.
+  void drawStripes(BitMatrix& matrix, int left, int top, int height) {
+    int width = matrix.getWidth();
+    int bottom = std::min(top + height, (int)matrix.getHeight());
+    bool black = true;
+    for (int x = left; x < width; black = !black) {
+      int bar = 1 + random(4);
+      for (int i = 0; i < bar && x < width; i++, x++) {
+        for (int y = top; black && y < bottom; y++) {
+          matrix.set(x, y);
+        }
+      }
+    }
+  }
+
+  // Scattered finder patterns of any size and bands of stripes, sometimes
+  // three finder patterns placed as a symbol's, with up to 15% of the
+  // pixels flipped.
+  Ref<BitMatrix> randomMatrix() {
+    int width = 21 + random(700);
+    int height = 21 + random(700);
+    Ref<BitMatrix> matrix(new BitMatrix(width, height));
+    for (int i = random(6); i > 0; i--) {
+      drawFinder(*matrix, random(width) - 10, random(height) - 10, 1 + random(12));
+    }
+    for (int i = random(4); i > 0; i--) {
+      drawStripes(*matrix, random(width), random(height), 1 + random(6));
+    }
+    if (random(2) == 1) {
+      int moduleSize = 1 + random(6);
+      int offset = (14 + 4 * random(5)) * moduleSize;
+      int left = random(width);
+      int top = random(height);
+      drawFinder(*matrix, left, top, moduleSize);
+      drawFinder(*matrix, left + offset, top, moduleSize);
+      drawFinder(*matrix, left, top + offset, moduleSize);
+    }
+    for (int i = random(4) * width * height / 20; i > 0; i--) {
+      matrix->flip(random(width), random(height));
+    }
+    return matrix;
+  }
+
+  class RunFinderPatternFinder : public FinderPatternFinder {
+  public:
+    RunFinderPatternFinder(Ref<BitMatrix> image) :
+      FinderPatternFinder(image, Ref<ResultPointCallback>()) {
+    }
+
+    std::vector<Ref<FinderPattern> >& getCenters() {
+      return getPossibleCenters();
+    }
+  };
+
+  void assertSameCenters(std::vector<Ref<FinderPattern> > const& expected,
+                         std::vector<Ref<FinderPattern> > const& actual) {
+    CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+      CPPUNIT_ASSERT_EQUAL(expected[i]->getX(), actual[i]->getX());
+      CPPUNIT_ASSERT_EQUAL(expected[i]->getY(), actual[i]->getY());
+      CPPUNIT_ASSERT_EQUAL(expected[i]->getEstimatedModuleSize(),
+                           actual[i]->getEstimatedModuleSize());
+      CPPUNIT_ASSERT_EQUAL(expected[i]->getCount(), actual[i]->getCount());
+    }
+  }
+
+  std::vector<Ref<FinderPattern> > getPatterns(Ref<FinderPatternInfo> const& info) {
+    std::vector<Ref<FinderPattern> > patterns;
+    if (!info.empty()) {
+      patterns.push_back(info->getBottomLeft());
+      patterns.push_back(info->getTopLeft());
+      patterns.push_back(info->getTopRight());
+    }
+    return patterns;
+  }
+}
+
+// find() walks each row a run at a time, and must find exactly the centers
+// looking at every pixel did, including across the row skip after the
+// first confirmed centers and after crosses that do not check out.
+void FinderPatternFinderTest::testFindMatchesPixelScan() {
+  seed = 1;
+  int unconfirmed = 0;
+  int rowSkips = 0;
+  for (int n = 0; n < MATRICES; n++) {
+    Ref<BitMatrix> matrix = randomMatrix();
+    for (int tryHarder = 0; tryHarder < 2; tryHarder++) {
+      DecodeHints hints(DecodeHints::DEFAULT_HINT);
+      hints.setTryHarder(tryHarder == 1);
+      PixelFinderPatternFinder pixelFinder(matrix);
+      Ref<FinderPatternInfo> expected;
+      try {
+        expected = pixelFinder.find(hints);
+      } catch (ReaderException const&) {
+      }
+      RunFinderPatternFinder runFinder(matrix);
+      Ref<FinderPatternInfo> actual;
+      try {
+        actual = runFinder.find(hints);
+      } catch (ReaderException const&) {
+      }
+      assertSameCenters(pixelFinder.getCenters(), runFinder.getCenters());
+      assertSameCenters(getPatterns(expected), getPatterns(actual));
+      unconfirmed += pixelFinder.unconfirmed;
+      rowSkips += pixelFinder.rowSkips;
+    }
+  }
+  CPPUNIT_ASSERT(unconfirmed > 0);
+  CPPUNIT_ASSERT(rowSkips > 0);
+}
+
+}
+}
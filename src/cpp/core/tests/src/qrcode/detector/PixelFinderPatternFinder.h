@@ -0,0 +1,127 @@
+#ifndef __PIXEL_FINDER_PATTERN_FINDER_H__
+#define __PIXEL_FINDER_PATTERN_FINDER_H__
+
+/*
+ *  PixelFinderPatternFinder.h
+ *  zxing
+ *
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/DecodeHints.h>
+#include <zxing/common/BitMatrix.h>
+#include <zxing/qrcode/detector/FinderPatternFinder.h>
+#include <vector>
+
+namespace zxing {
+namespace qrcode {
+
+// find() as it was before rows were read a run at a time: every pixel
+// of the scanned rows is looked at with get(). Counts the branches of
+// the scan the matrices took.
+class PixelFinderPatternFinder : public FinderPatternFinder {
+public:
+  int unconfirmed;
+  int rowSkips;
+
+  PixelFinderPatternFinder(Ref<BitMatrix> image) :
+    FinderPatternFinder(image, Ref<ResultPointCallback>()), unconfirmed(0), rowSkips(0) {
+  }
+
+  std::vector<Ref<FinderPattern> >& getCenters() {
+    return getPossibleCenters();
+  }
+
+  Ref<FinderPatternInfo> find(DecodeHints const& hints) {
+    size_t maxI = image_->getHeight();
+    size_t maxJ = image_->getWidth();
+    int stateCount[5];
+    bool done = false;
+    int iSkip = (3 * maxI) / (4 * MAX_MODULES);
+    if (iSkip < MIN_SKIP || hints.getTryHarder()) {
+      iSkip = MIN_SKIP;
+    }
+    BitMatrix& matrix = *image_;
+    for (size_t i = iSkip - 1; i < maxI && !done; i += iSkip) {
+      for (int k = 0; k < 5; k++) {
+        stateCount[k] = 0;
+      }
+      int currentState = 0;
+      for (size_t j = 0; j < maxJ; j++) {
+        if (matrix.get(j, i)) {
+          if ((currentState & 1) == 1) {
+            currentState++;
+          }
+          stateCount[currentState]++;
+        } else if ((currentState & 1) == 0) {
+          if (currentState == 4) {
+            if (foundPatternCross(stateCount)) {
+              if (handlePossibleCenter(stateCount, i, j)) {
+                iSkip = 2;
+                if (hasSkipped_) {
+                  done = haveMultiplyConfirmedCenters();
+                } else {
+                  int rowSkip = findRowSkip();
+                  if (rowSkip > stateCount[2]) {
+                    rowSkips++;
+                    i += rowSkip - stateCount[2] - iSkip;
+                    j = maxJ - 1;
+                  }
+                }
+              } else {
+                unconfirmed++;
+                stateCount[0] = stateCount[2];
+                stateCount[1] = stateCount[3];
+                stateCount[2] = stateCount[4];
+                stateCount[3] = 1;
+                stateCount[4] = 0;
+                currentState = 3;
+                continue;
+              }
+              currentState = 0;
+              for (int k = 0; k < 5; k++) {
+                stateCount[k] = 0;
+              }
+            } else {
+              stateCount[0] = stateCount[2];
+              stateCount[1] = stateCount[3];
+              stateCount[2] = stateCount[4];
+              stateCount[3] = 1;
+              stateCount[4] = 0;
+              currentState = 3;
+            }
+          } else {
+            stateCount[++currentState]++;
+          }
+        } else {
+          stateCount[currentState]++;
+        }
+      }
+      if (foundPatternCross(stateCount) && handlePossibleCenter(stateCount, i, maxJ)) {
+        iSkip = stateCount[0];
+        if (hasSkipped_) {
+          done = haveMultiplyConfirmedCenters();
+        }
+      }
+    }
+    std::vector<Ref<FinderPattern> > patterns = orderBestPatterns(selectBestPatterns());
+    return Ref<FinderPatternInfo>(new FinderPatternInfo(patterns));
+  }
+};
+
+}
+}
+
+#endif // __PIXEL_FINDER_PATTERN_FINDER_H__
@@ -17,11 +17,23 @@
 #include "MagickBitmapSource.h"
 
 #include <iostream>
+#include <string.h>
 
 using namespace Magick;
 
 namespace zxing {
 
+namespace {
+  void toLuminance(const Magick::PixelPacket* p, unsigned char* m, int count) {
+    for (int i = 0; i < count; i++, p++) {
+      // We assume 16 bit values here
+      // 0x200 = 1<<9, half an lsb of the result to force rounding
+      m[i] = (unsigned char)((306 * ((int)p->red >> 8) + 601 * ((int)p->green >> 8) +
+          117 * ((int)p->blue >> 8) + 0x200) >> 10);
+    }
+  }
+}
+
 MagickBitmapSource::MagickBitmapSource(Image& image) : image_(image) {
   width = image.columns();
   height = image.rows();
@@ -40,18 +52,17 @@ int MagickBitmapSource::getHeight() const {
 }
 
 unsigned char* MagickBitmapSource::getRow(int y, unsigned char* row) {
-  const Magick::PixelPacket* pixel_cache = image_.getConstPixels(0, y, width, 1);
   int width = getWidth();
   if (row == NULL) {
     row = new unsigned char[width];
   }
-  for (int x = 0; x < width; x++) {
-    const PixelPacket* p = pixel_cache + x;
-    // We assume 16 bit values here
-    // 0x200 = 1<<9, half an lsb of the result to force rounding
-    row[x] = (unsigned char)((306 * ((int)p->red >> 8) + 601 * ((int)p->green >> 8) +
-        117 * ((int)p->blue >> 8) + 0x200) >> 10);
+  if (luminances_.array_ != 0) {
+    // Already converted for a matrix view.
+    memcpy(row, &luminances_[y * width], width);
+    return row;
   }
+  const Magick::PixelPacket* pixel_cache = image_.getConstPixels(0, y, width, 1);
+  toLuminance(pixel_cache, row, width);
   return row;
 
 }
@@ -59,22 +70,23 @@ unsigned char* MagickBitmapSource::getRow(int y, unsigned char* row) {
 /** This is a more efficient implementation. */
 unsigned char* MagickBitmapSource::getMatrix() {
   const Magick::PixelPacket* pixel_cache = image_.getConstPixels(0, 0, width, height);
-  int width = getWidth();
-  int height =  getHeight();
   unsigned char* matrix = new unsigned char[width*height];
-  unsigned char* m = matrix;
-  const Magick::PixelPacket* p = pixel_cache;
-  for (int y = 0; y < height; y++) {
-    for (int x = 0; x < width; x++) {
-      *m = (unsigned char)((306 * ((int)p->red >> 8) + 601 * ((int)p->green >> 8) +
-          117 * ((int)p->blue >> 8) + 0x200) >> 10);
-      m++;
-      p++;
-    }
-  }
+  toLuminance(pixel_cache, matrix, width * height);
   return matrix;
 }
 
+/**
+ * Magick only holds RGB pixels, so the luminance is converted once and kept
+ * with the source. Later views borrow it.
+ */
+LuminanceView MagickBitmapSource::getMatrixView() {
+  if (luminances_.array_ == 0) {
+    luminances_ = new Array<unsigned char>(width * height);
+    toLuminance(image_.getConstPixels(0, 0, width, height), &luminances_[0], width * height);
+  }
+  return LuminanceView(&luminances_[0], width, width, height);
+}
+
 bool MagickBitmapSource::isRotateSupported() const {
   return true;
 }
@@ -26,6 +26,8 @@ private:
   Magick::Image image_;
   int width;
   int height;
+  // Converted on the first getMatrixView() and lent out from then on.
+  ArrayRef<unsigned char> luminances_;
 
 public:
   MagickBitmapSource(Magick::Image& image);
@@ -36,6 +38,7 @@ public:
   int getHeight() const;
   unsigned char* getRow(int y, unsigned char* row);
   unsigned char* getMatrix();
+  LuminanceView getMatrixView();
   bool isCropSupported() const;
   Ref<LuminanceSource> crop(int left, int top, int width, int height);
   bool isRotateSupported() const;
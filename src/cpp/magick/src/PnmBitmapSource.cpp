@@ -0,0 +1,218 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PnmBitmapSource.h"
+
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+using namespace std;
+
+namespace zxing {
+
+namespace {
+  bool isWhitespace(unsigned char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  // Reads the next number of the header, skipping whitespace and comments;
+  // -1 if there is none.
+  int readHeaderValue(unsigned char const* data, size_t size, size_t& offset) {
+    while (offset < size && (isWhitespace(data[offset]) || data[offset] == '#')) {
+      if (data[offset] == '#') {
+        while (offset < size && data[offset] != '\n' && data[offset] != '\r') {
+          offset++;
+        }
+      } else {
+        offset++;
+      }
+    }
+    if (offset >= size || data[offset] < '0' || data[offset] > '9') {
+      return -1;
+    }
+    int value = 0;
+    while (offset < size && data[offset] >= '0' && data[offset] <= '9') {
+      value = value * 10 + (data[offset++] - '0');
+      if (value > 0xFFFFFF) {
+        return -1;
+      }
+    }
+    return value;
+  }
+
+  /**
+   * Samples are scaled to 0-255 through a table, then weighted as
+   * MagickBitmapSource weighs them, so both give the same luminances for the
+   * same picture. 16 bit samples are big endian.
+   */
+  void toLuminance(unsigned char const* pixels, int width, int height, int channels,
+                   int maxval, unsigned char* luminances) {
+    vector<int> scaled(maxval + 1);
+    for (int i = 0; i <= maxval; i++) {
+      scaled[i] = (i * 255 + maxval / 2) / maxval;
+    }
+    int sampleBytes = maxval > 255 ? 2 : 1;
+    int count = width * channels;
+    vector<int> samples(count);
+    for (int y = 0; y < height; y++) {
+      if (sampleBytes == 1) {
+        for (int i = 0; i < count; i++) {
+          samples[i] = scaled[pixels[i]];
+        }
+      } else {
+        for (int i = 0; i < count; i++) {
+          int sample = (pixels[2 * i] << 8) | pixels[2 * i + 1];
+          samples[i] = scaled[sample > maxval ? maxval : sample];
+        }
+      }
+      if (channels == 1) {
+        for (int x = 0; x < width; x++) {
+          luminances[x] = (unsigned char)samples[x];
+        }
+      } else {
+        for (int x = 0; x < width; x++) {
+          luminances[x] = (unsigned char)((306 * samples[3 * x] + 601 * samples[3 * x + 1] +
+              117 * samples[3 * x + 2] + 0x200) >> 10);
+        }
+      }
+      pixels += (size_t)count * sampleBytes;
+      luminances += width;
+    }
+  }
+}
+
+PnmBitmapSource::Mapping::Mapping(void* data, size_t size) : data_(data), size_(size) {
+}
+
+PnmBitmapSource::Mapping::~Mapping() {
+  munmap(data_, size_);
+}
+
+unsigned char* PnmBitmapSource::Mapping::getData() const {
+  return (unsigned char*)data_;
+}
+
+size_t PnmBitmapSource::Mapping::getSize() const {
+  return size_;
+}
+
+PnmBitmapSource::PnmBitmapSource(Ref<Mapping> mapping, ArrayRef<unsigned char> luminances,
+                                 Ref<LuminanceSource> source) :
+  mapping_(mapping), luminances_(luminances), source_(source) {
+}
+
+PnmBitmapSource::~PnmBitmapSource() {
+}
+
+/**
+ * The mapping is private and writable: nothing writes to it, but the
+ * greyscale sources take their pixels as non-const, and a write would then
+ * only ever touch a copy of the page.
+ */
+Ref<LuminanceSource> PnmBitmapSource::open(string const& filename) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw IllegalArgumentException("Unable to open the file.");
+  }
+  unsigned char magic[2];
+  struct stat status;
+  if (read(fd, magic, 2) != 2 || magic[0] != 'P' || (magic[1] != '5' && magic[1] != '6') ||
+      fstat(fd, &status) != 0) {
+    close(fd);
+    return Ref<LuminanceSource>();
+  }
+  size_t size = status.st_size;
+  void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw IllegalArgumentException("Unable to map the file.");
+  }
+  Ref<Mapping> mapping(new Mapping(data, size));
+
+  unsigned char const* header = mapping->getData();
+  size_t offset = 2;
+  int width = readHeaderValue(header, size, offset);
+  int height = readHeaderValue(header, size, offset);
+  int maxval = readHeaderValue(header, size, offset);
+  if (width <= 0 || height <= 0 || maxval <= 0 || maxval > 0xFFFF ||
+      offset >= size || !isWhitespace(header[offset])) {
+    throw IllegalArgumentException("Malformed PNM header.");
+  }
+  offset++;
+  int channels = magic[1] == '6' ? 3 : 1;
+  size_t rowBytes = (size_t)width * channels * (maxval > 255 ? 2 : 1);
+  if ((size - offset) / rowBytes < (size_t)height) {
+    throw IllegalArgumentException("PNM file is truncated.");
+  }
+
+  unsigned char* pixels = mapping->getData() + offset;
+  if (channels == 1 && maxval == 255) {
+    Ref<LuminanceSource> source(new GreyscaleLuminanceSource(pixels, width, height,
+                                                             0, 0, width, height));
+    return Ref<LuminanceSource>(new PnmBitmapSource(mapping, ArrayRef<unsigned char>(), source));
+  }
+  ArrayRef<unsigned char> luminances(new Array<unsigned char>(width * height));
+  toLuminance(pixels, width, height, channels, maxval, &luminances[0]);
+  Ref<LuminanceSource> source(new GreyscaleLuminanceSource(&luminances[0], width, height,
+                                                           0, 0, width, height));
+  return Ref<LuminanceSource>(new PnmBitmapSource(Ref<Mapping>(), luminances, source));
+}
+
+int PnmBitmapSource::getWidth() const {
+  return source_->getWidth();
+}
+
+int PnmBitmapSource::getHeight() const {
+  return source_->getHeight();
+}
+
+unsigned char* PnmBitmapSource::getRow(int y, unsigned char* row) {
+  return source_->getRow(y, row);
+}
+
+unsigned char* PnmBitmapSource::getMatrix() {
+  return source_->getMatrix();
+}
+
+LuminanceView PnmBitmapSource::getMatrixView() {
+  return source_->getMatrixView();
+}
+
+bool PnmBitmapSource::isCropSupported() const {
+  return source_->isCropSupported();
+}
+
+Ref<LuminanceSource> PnmBitmapSource::crop(int left, int top, int width, int height) {
+  return Ref<LuminanceSource>(new PnmBitmapSource(mapping_, luminances_,
+                                                  source_->crop(left, top, width, height)));
+}
+
+bool PnmBitmapSource::isRotateSupported() const {
+  return source_->isRotateSupported();
+}
+
+Ref<LuminanceSource> PnmBitmapSource::rotateCounterClockwise() {
+  return Ref<LuminanceSource>(new PnmBitmapSource(mapping_, luminances_,
+                                                  source_->rotateCounterClockwise()));
+}
+
+}
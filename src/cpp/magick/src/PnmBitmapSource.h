@@ -0,0 +1,80 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __PNM_BITMAP_SOURCE_H_
+#define __PNM_BITMAP_SOURCE_H_
+/*
+ *  Copyright 2013 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string>
+#include <zxing/LuminanceSource.h>
+#include <zxing/common/Array.h>
+
+namespace zxing {
+
+/**
+ * Reads binary PGM (P5) and PPM (P6) files without ImageMagick. The file is
+ * memory mapped; an 8 bit PGM's samples already are the luminances, so its
+ * rows and matrix view point straight into the mapping. Colour and 16 bit
+ * files are converted to 8 bit luminance once, with MagickBitmapSource's
+ * weights, when opened.
+ *
+ * Crops and rotations are wrapped too, so they keep the mapping alive.
+ */
+class PnmBitmapSource : public LuminanceSource {
+public:
+  class Mapping : public Counted {
+  private:
+    void* data_;
+    size_t size_;
+
+  public:
+    Mapping(void* data, size_t size);
+    ~Mapping();
+
+    unsigned char* getData() const;
+    size_t getSize() const;
+  };
+
+private:
+  Ref<Mapping> mapping_;
+  ArrayRef<unsigned char> luminances_;
+  Ref<LuminanceSource> source_;
+
+  PnmBitmapSource(Ref<Mapping> mapping, ArrayRef<unsigned char> luminances,
+                  Ref<LuminanceSource> source);
+
+public:
+  // An empty Ref if the file does not start like a binary PGM or PPM, so the
+  // caller can hand it to ImageMagick instead. Throws
+  // IllegalArgumentException for one that cannot be read or is truncated.
+  static Ref<LuminanceSource> open(std::string const& filename);
+
+  ~PnmBitmapSource();
+
+  int getWidth() const;
+  int getHeight() const;
+  unsigned char* getRow(int y, unsigned char* row);
+  unsigned char* getMatrix();
+  LuminanceView getMatrixView();
+  bool isCropSupported() const;
+  Ref<LuminanceSource> crop(int left, int top, int width, int height);
+  bool isRotateSupported() const;
+  Ref<LuminanceSource> rotateCounterClockwise();
+};
+
+}
+
+#endif /* __PNM_BITMAP_SOURCE_H_ */
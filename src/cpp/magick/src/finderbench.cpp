@@ -0,0 +1,146 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Times the QR Code finder pattern search on each image's HybridBinarizer
+ * matrix, once looking at every pixel of the scanned rows with get(), as
+ * FinderPatternFinder::find used to, and once with find, which walks each
+ * row a run at a time. Both are timed with and without try harder, which
+ * scans every third row, and must find the same patterns.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <Magick++.h>
+#include "MagickBitmapSource.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/DecodeHints.h>
+#include <zxing/ReaderException.h>
+#include <zxing/common/BitMatrix.h>
+#include <zxing/common/Counted.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/qrcode/detector/FinderPatternFinder.h>
+#include <zxing/Exception.h>
+#include "qrcode/detector/PixelFinderPatternFinder.h"
+
+using namespace Magick;
+using namespace std;
+using namespace zxing;
+using namespace zxing::qrcode;
+
+namespace {
+
+double now() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+// FinderPatternFinder::find, constructed the same way as PixelFinderPatternFinder.
+class RunFinderPatternFinder : public FinderPatternFinder {
+ public:
+  RunFinderPatternFinder(Ref<BitMatrix> image) :
+    FinderPatternFinder(image, Ref<ResultPointCallback>()) {
+  }
+};
+
+// Times one search; the top left pattern's center, or -1, -1, goes in x, y.
+template<typename Finder>
+double timeFind(Ref<BitMatrix> matrix, bool tryHarder, float& x, float& y) {
+  DecodeHints hints(DecodeHints::BARCODEFORMAT_QR_CODE_HINT);
+  hints.setTryHarder(tryHarder);
+  Finder finder(matrix);
+  x = -1;
+  y = -1;
+  double start = now();
+  try {
+    Ref<FinderPatternInfo> info = finder.find(hints);
+    x = info->getTopLeft()->getX();
+    y = info->getTopLeft()->getY();
+  } catch (ReaderException const&) {
+  }
+  return now() - start;
+}
+
+}
+
+int main(int argc, char** argv) {
+  int loops = 1;
+  int images = 0;
+  double pixelTotal = 0;
+  double runTotal = 0;
+  double pixelHarderTotal = 0;
+  double runHarderTotal = 0;
+
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg.compare("--loops") == 0 && i + 1 < argc) {
+      loops = atoi(argv[++i]);
+      continue;
+    }
+    Image image;
+    try {
+      image.read(arg);
+    } catch (...) {
+      cerr << "Unable to open image " << arg << ", ignoring" << endl;
+      continue;
+    }
+    try {
+      Ref<LuminanceSource> source(new MagickBitmapSource(image));
+      Ref<Binarizer> binarizer(new HybridBinarizer(source));
+      Ref<BitMatrix> matrix = BinaryBitmap(binarizer).getBlackMatrix();
+      for (int loop = 0; loop < loops; loop++) {
+        float pixelX, pixelY, runX, runY;
+        float pixelHarderX, pixelHarderY, runHarderX, runHarderY;
+        double pixel = timeFind<PixelFinderPatternFinder>(matrix, false, pixelX, pixelY);
+        double run = timeFind<RunFinderPatternFinder>(matrix, false, runX, runY);
+        double pixelHarder =
+          timeFind<PixelFinderPatternFinder>(matrix, true, pixelHarderX, pixelHarderY);
+        double runHarder = timeFind<RunFinderPatternFinder>(matrix, true, runHarderX, runHarderY);
+        if (pixelX != runX || pixelY != runY ||
+            pixelHarderX != runHarderX || pixelHarderY != runHarderY) {
+          cerr << arg << ": searches disagree" << endl;
+          return 1;
+        }
+
+        pixelTotal += pixel;
+        runTotal += run;
+        pixelHarderTotal += pixelHarder;
+        runHarderTotal += runHarder;
+        cout << arg << " (" << matrix->getWidth() << "x" << matrix->getHeight() << "): "
+             << (runX >= 0 ? "found" : "not found") << ", pixel " << pixel << " ms, runs "
+             << run << " ms; try harder " << (runHarderX >= 0 ? "found" : "not found")
+             << ", pixel " << pixelHarder << " ms, runs " << runHarder << " ms" << endl;
+      }
+      images++;
+    } catch (zxing::Exception& e) {
+      cerr << "zxing::Exception: " << e.what() << endl;
+      return 1;
+    }
+  }
+  if (images == 0 || loops < 1) {
+    cout << "Usage: " << argv[0] << " [--loops <n>] <image1> [<image2> ...]" << endl;
+    return 1;
+  }
+
+  cout << "pixel " << pixelTotal << " ms, runs " << runTotal << " ms; try harder pixel "
+       << pixelHarderTotal << " ms, runs " << runHarderTotal << " ms" << endl;
+  return 0;
+}
@@ -0,0 +1,115 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Replays a sequence of images as consecutive video frames, binarizing each
+ * with a fresh HybridBinarizer and with a TemporalBinarizer that carries its
+ * history from frame to frame, and reports the blocks the latter redid and
+ * the time it saved.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <Magick++.h>
+#include "MagickBitmapSource.h"
+#include <zxing/common/Counted.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/TemporalBinarizer.h>
+#include <zxing/Exception.h>
+
+using namespace Magick;
+using namespace std;
+using namespace zxing;
+
+static double now() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+int main(int argc, char** argv) {
+  int delta = TemporalBinarizer::DEFAULT_DELTA;
+  int loops = 1;
+  vector<Ref<LuminanceSource> > frames;
+
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg.compare("--delta") == 0 && i + 1 < argc) {
+      delta = atoi(argv[++i]);
+      continue;
+    }
+    if (arg.compare("--loops") == 0 && i + 1 < argc) {
+      loops = atoi(argv[++i]);
+      continue;
+    }
+    Image image;
+    try {
+      image.read(arg);
+    } catch (...) {
+      cerr << "Unable to open image " << arg << ", ignoring" << endl;
+      continue;
+    }
+    Ref<LuminanceSource> source(new MagickBitmapSource(image));
+    // Convert to luminance up front, so only binarization gets timed.
+    source->getMatrixView();
+    frames.push_back(source);
+  }
+  if (frames.empty() || loops < 1) {
+    cout << "Usage: " << argv[0] << " [--delta <n>] [--loops <n>] <frame1> [<frame2> ...]" << endl;
+    return 1;
+  }
+
+  try {
+    Ref<TemporalBinarizer::History> history(new TemporalBinarizer::History(delta));
+    double hybridTotal = 0;
+    double temporalTotal = 0;
+    long recomputedTotal = 0;
+    long thresholdedTotal = 0;
+    long blocksTotal = 0;
+    for (int loop = 0; loop < loops; loop++) {
+      for (size_t i = 0; i < frames.size(); i++) {
+        double start = now();
+        HybridBinarizer(frames[i]).getBlackMatrix();
+        double hybrid = now() - start;
+        start = now();
+        TemporalBinarizer(frames[i], history).getBlackMatrix();
+        double temporal = now() - start;
+
+        hybridTotal += hybrid;
+        temporalTotal += temporal;
+        recomputedTotal += history->getBlocksRecomputed();
+        thresholdedTotal += history->getBlocksThresholded();
+        blocksTotal += history->getBlockCount();
+        cout << "frame " << (loop * frames.size() + i) << ": "
+             << history->getBlocksRecomputed() << " recomputed, "
+             << history->getBlocksThresholded() << " thresholded of "
+             << history->getBlockCount() << " blocks, hybrid "
+             << hybrid << " ms, temporal " << temporal << " ms" << endl;
+      }
+    }
+    cout << recomputedTotal << " recomputed, " << thresholdedTotal << " thresholded of "
+         << blocksTotal << " blocks; hybrid " << hybridTotal << " ms, temporal "
+         << temporalTotal << " ms, saved " << (hybridTotal - temporalTotal) << " ms" << endl;
+  } catch (zxing::Exception& e) {
+    cerr << "zxing::Exception: " << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
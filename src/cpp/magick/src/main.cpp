@@ -18,8 +18,10 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <stdlib.h>
 #include <Magick++.h>
 #include "MagickBitmapSource.h"
+#include "PnmBitmapSource.h"
 #include <zxing/common/Counted.h>
 #include <zxing/Binarizer.h>
 #include <zxing/MultiFormatReader.h>
@@ -27,6 +29,8 @@
 #include <zxing/ReaderException.h>
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/DualBinarizer.h>
+#include <zxing/common/PyramidLuminanceSource.h>
 #include <exception>
 #include <zxing/Exception.h>
 #include <zxing/common/IllegalArgumentException.h>
@@ -38,6 +42,7 @@
 #include <zxing/multi/ByQuadrantReader.h>
 #include <zxing/multi/MultipleBarcodeReader.h>
 #include <zxing/multi/GenericMultipleBarcodeReader.h>
+#include <zxing/multi/BandedMultipleBarcodeReader.h>
 
 //#include <zxing/qrcode/detector/Detector.h>
 //#include <zxing/qrcode/detector/QREdgeDetector.h>
@@ -54,6 +59,12 @@ static bool show_format = false;
 static bool tryHarder = false;
 static bool show_filename = false;
 static bool search_multi = false;
+static int threads = 1;
+static bool lazy = false;
+static bool coarse = false;
+static bool column_copy = false;
+// Megabytes for BandedMultipleBarcodeReader's bands; 0 searches whole images.
+static int band_memory = 0;
 
 static const int MAX_EXPECTED = 4096;
 
@@ -67,13 +78,45 @@ vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image, DecodeHints hints){
 //   MultiFormatReader mformat;
 //   ByQuadrantReader delegate(mformat);
 
+  if (band_memory > 0) {
+    BandedMultipleBarcodeReader reader(delegate, (size_t)band_memory << 20);
+    return reader.decodeMultiple(image, hints);
+  }
   GenericMultipleBarcodeReader reader(delegate);
 //   QRCodeMultiReader reader;
   return reader.decodeMultiple(image,hints);
 }
 
 
-int test_image(Image& image, bool hybrid, string expected = "") {
+/**
+ * Makes the bitmap for one binarizer of an image's shared source. With a
+ * dual binarizer, both matrices come from its single pass; a global matrix
+ * it could not make is left for the readers to find out about, as they
+ * would without it.
+ */
+Ref<BinaryBitmap> binarize(Ref<LuminanceSource> source, Ref<DualBinarizer> dual, bool hybrid,
+                           Ref<Binarizer>& binarizer) {
+  if (hybrid) {
+    if (dual.empty()) {
+      binarizer = new HybridBinarizer(source, threads, lazy);
+    } else {
+      binarizer = dual;
+    }
+    return Ref<BinaryBitmap>(new BinaryBitmap(binarizer));
+  }
+  binarizer = new GlobalHistogramBinarizer(source);
+  if (!dual.empty()) {
+    try {
+      return Ref<BinaryBitmap>(new BinaryBitmap(binarizer, dual->getGlobalBlackMatrix()));
+    } catch (zxing::IllegalArgumentException const&) {
+      // Too little dynamic range; GlobalHistogramBinarizer will say so again.
+    }
+  }
+  return Ref<BinaryBitmap>(new BinaryBitmap(binarizer));
+}
+
+int test_image(Ref<LuminanceSource> source, Ref<DualBinarizer> dual, bool hybrid,
+               string expected = "") {
 
   string cell_result;
   int res = -1;
@@ -83,17 +126,11 @@ int test_image(Image& image, bool hybrid, string expected = "") {
   const char* result_format = "";
 
   try {
-    Ref<MagickBitmapSource> source(new MagickBitmapSource(image));
-
-    if (hybrid) {
-      binarizer = new HybridBinarizer(source);
-    } else {
-      binarizer = new GlobalHistogramBinarizer(source);
-    }
-
+    Ref<BinaryBitmap> binary = binarize(source, dual, hybrid, binarizer);
     DecodeHints hints(DecodeHints::DEFAULT_HINT);
     hints.setTryHarder(tryHarder);
-    Ref<BinaryBitmap> binary(new BinaryBitmap(binarizer));
+    hints.setCoarseToFine(coarse);
+    hints.setColumnCopy(column_copy);
     Ref<Result> result(decode(binary, hints));
     cell_result = result->getText()->getText();
     result_format = barcodeFormatNames[result->getBarcodeFormat()];
@@ -112,6 +149,18 @@ int test_image(Image& image, bool hybrid, string expected = "") {
     res = -5;
   }
 
+  if (lazy && hybrid && !binarizer.empty()) {
+    // The matrix is cached by now, so this only reports the tiles the
+    // detectors read.
+    try {
+      Ref<BitMatrix> lazyMatrix = binarizer->getBlackMatrix();
+      cerr << "  Lazy tiles filled: " << lazyMatrix->getTilesFilled() << "/"
+           << lazyMatrix->getTileCount() << endl;
+    } catch (zxing::Exception& e) {
+      // Too small for HybridBinarizer and too flat for the global fallback.
+    }
+  }
+
   if (cell_result.compare(expected)) {
     res = -6;
     if (!raw_dump) {
@@ -133,15 +182,17 @@ int test_image(Image& image, bool hybrid, string expected = "") {
   return res;
 }
 
-int test_image_hybrid(Image& image, string expected = "") {
-  return test_image(image, true, expected);
+int test_image_hybrid(Ref<LuminanceSource> source, Ref<DualBinarizer> dual,
+                      string expected = "") {
+  return test_image(source, dual, true, expected);
 }
 
-int test_image_global(Image& image, string expected = "") {
-  return test_image(image, false, expected);
+int test_image_global(Ref<LuminanceSource> source, Ref<DualBinarizer> dual,
+                      string expected = "") {
+  return test_image(source, dual, false, expected);
 }
 
-int test_image_multi(Image& image, bool hybrid){
+int test_image_multi(Ref<LuminanceSource> source, Ref<DualBinarizer> dual, bool hybrid){
   vector<Ref<Result> > results;
   string cell_result;
   int res = -1;
@@ -150,16 +201,11 @@ int test_image_multi(Image& image, bool hybrid){
   Ref<Binarizer> binarizer(NULL);
 
   try {
-    Ref<MagickBitmapSource> source(new MagickBitmapSource(image));
-
-    if (hybrid) {
-      binarizer = new HybridBinarizer(source);
-    } else {
-      binarizer = new GlobalHistogramBinarizer(source);
-    }
+    Ref<BinaryBitmap> binary = binarize(source, dual, hybrid, binarizer);
     DecodeHints hints(DecodeHints::DEFAULT_HINT);
     hints.setTryHarder(tryHarder);
-    Ref<BinaryBitmap> binary(new BinaryBitmap(binarizer));
+    hints.setCoarseToFine(coarse);
+    hints.setColumnCopy(column_copy);
     results = decodeMultiple(binary, hints);
     res = 0;
   } catch (ReaderException e) {
@@ -191,12 +237,12 @@ int test_image_multi(Image& image, bool hybrid){
   return res;
 }
 
-int test_image_multi_hybrid(Image& image){
-  return test_image_multi(image, true);
+int test_image_multi_hybrid(Ref<LuminanceSource> source, Ref<DualBinarizer> dual){
+  return test_image_multi(source, dual, true);
 }
 
-int test_image_multi_global(Image& image){
-  return test_image_multi(image, false);
+int test_image_multi_global(Ref<LuminanceSource> source, Ref<DualBinarizer> dual){
+  return test_image_multi(source, dual, false);
 }
 
 string get_expected(string imagefilename) {
@@ -236,7 +282,7 @@ string get_expected(string imagefilename) {
 
 int main(int argc, char** argv) {
   if (argc <= 1) {
-    cout << "Usage: " << argv[0] << " [--dump-raw] [--show-format] [--try-harder] [--search_multi] [--show-filename] <filename1> [<filename2> ...]" << endl;
+    cout << "Usage: " << argv[0] << " [--dump-raw] [--show-format] [--try-harder] [--search_multi] [--show-filename] [--threads <n>] [--lazy] [--coarse] [--column-copy] [--band-memory <MB>] <filename1> [<filename2> ...]" << endl;
     return 1;
   }
 
@@ -273,13 +319,41 @@ int main(int argc, char** argv) {
       search_multi = true;
       continue;
     }
+    if (infilename.compare("--lazy") == 0) {
+      lazy = true;
+      continue;
+    }
+    if (infilename.compare("--coarse") == 0) {
+      coarse = true;
+      continue;
+    }
+    if (infilename.compare("--column-copy") == 0) {
+      column_copy = true;
+      continue;
+    }
+    if (infilename.compare("--band-memory") == 0 && i + 1 < argc) {
+      band_memory = atoi(argv[++i]);
+      continue;
+    }
+    if (infilename.compare("--threads") == 0 && i + 1 < argc) {
+      threads = atoi(argv[++i]);
+      continue;
+    }
     if (!raw_dump)
       cerr << "Processing: " << infilename << endl;
     if (show_filename)
       cout << infilename << " ";
-    Image image;
+    // Binary PGM and PPM files are mapped directly; ImageMagick reads the
+    // rest. Both binarizers share one source, so the pixels are converted to
+    // luminance once.
+    Ref<LuminanceSource> source;
     try {
-      image.read(infilename);
+      source = PnmBitmapSource::open(infilename);
+      if (source.empty()) {
+        Image image;
+        image.read(infilename);
+        source = new MagickBitmapSource(image);
+      }
     } catch (...) {
       cerr << "Unable to open image, ignoring" << endl;
       continue;
@@ -288,11 +362,22 @@ int main(int argc, char** argv) {
     string expected;
     expected = get_expected(infilename);
 
+    if (coarse) {
+      source = new PyramidLuminanceSource(source);
+    }
+    // Unless HybridBinarizer's own threaded or lazy modes were asked for,
+    // both matrices also come from a single pass. Banded searches never
+    // binarize the whole image.
+    Ref<DualBinarizer> dual;
+    if (threads == 1 && !lazy && band_memory == 0) {
+      dual = new DualBinarizer(source);
+    }
+
     if (search_multi){
       int gresult = 1;
       int hresult = 1;
-      gresult = test_image_multi_global(image);
-      hresult = test_image_multi_hybrid(image);
+      gresult = test_image_multi_global(source, dual);
+      hresult = test_image_multi_hybrid(source, dual);
       gresult = gresult == 0;
       hresult = hresult == 0;
       gonly += gresult && !hresult;
@@ -303,8 +388,8 @@ int main(int argc, char** argv) {
     } else {
       int gresult = 1;
       int hresult = 1;
-      hresult = test_image_hybrid(image, expected);
-      gresult = test_image_global(image, expected);
+      hresult = test_image_hybrid(source, dual, expected);
+      gresult = test_image_global(source, dual, expected);
       gresult = gresult == 0;
       hresult = hresult == 0;
 
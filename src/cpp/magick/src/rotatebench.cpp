@@ -0,0 +1,213 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Times the rotated pass of a try harder 1D decode, which is what
+ * OneDReader falls back to on images such as 4K frames with a vertical
+ * barcode. Each image is rotated counter-clockwise once by reading columns
+ * a byte at a time, as GreyscaleRotatedLuminanceSource used to, and once
+ * by GreyscaleRotatedLuminanceSource's tiled transpose, and decoded both
+ * ways. Reading every row in order and the full matrix rotation are timed
+ * too.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <Magick++.h>
+#include "MagickBitmapSource.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/DecodeHints.h>
+#include <zxing/ReaderException.h>
+#include <zxing/common/Counted.h>
+#include <zxing/common/GlobalHistogramBinarizer.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/oned/MultiFormatOneDReader.h>
+#include <zxing/Exception.h>
+
+using namespace Magick;
+using namespace std;
+using namespace zxing;
+using namespace zxing::oned;
+
+namespace {
+
+double now() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+// Reads each rotated row as a column of the image, one byte per image row.
+class ColumnRotatedSource : public LuminanceSource {
+ private:
+  unsigned char* greyData_;
+  int dataWidth_;
+  int width_;
+  int height_;
+
+ public:
+  ColumnRotatedSource(unsigned char* greyData, int dataWidth, int dataHeight) :
+    greyData_(greyData), dataWidth_(dataWidth), width_(dataHeight), height_(dataWidth) {
+  }
+
+  int getWidth() const {
+    return width_;
+  }
+
+  int getHeight() const {
+    return height_;
+  }
+
+  unsigned char* getRow(int y, unsigned char* row) {
+    if (row == NULL) {
+      row = new unsigned char[width_];
+    }
+    int offset = dataWidth_ - 1 - y;
+    for (int x = 0; x < width_; x++) {
+      row[x] = greyData_[offset];
+      offset += dataWidth_;
+    }
+    return row;
+  }
+
+  unsigned char* getMatrix() {
+    unsigned char* result = new unsigned char[width_ * height_];
+    for (int y = 0; y < height_; y++) {
+      getRow(y, &result[y * width_]);
+    }
+    return result;
+  }
+};
+
+// The rotated pass of OneDReader::decode, on an already rotated source.
+double decodeRotated(Ref<LuminanceSource> rotated, bool& found) {
+  DecodeHints hints(DecodeHints::ONED_HINT);
+  hints.setTryHarder(true);
+  double start = now();
+  try {
+    Ref<Binarizer> binarizer(new GlobalHistogramBinarizer(rotated));
+    Ref<BinaryBitmap> image(new BinaryBitmap(binarizer));
+    MultiFormatOneDReader(hints).decode(image, hints);
+    found = true;
+  } catch (ReaderException const&) {
+    found = false;
+  }
+  return now() - start;
+}
+
+double readRows(Ref<LuminanceSource> rotated) {
+  vector<unsigned char> row(rotated->getWidth());
+  double start = now();
+  for (int y = 0; y < rotated->getHeight(); y++) {
+    rotated->getRow(y, &row[0]);
+  }
+  return now() - start;
+}
+
+double rotateMatrix(Ref<LuminanceSource> rotated) {
+  double start = now();
+  rotated->getMatrixView();
+  return now() - start;
+}
+
+}
+
+int main(int argc, char** argv) {
+  int loops = 1;
+  int images = 0;
+  double columnDecodeTotal = 0;
+  double tiledDecodeTotal = 0;
+  double columnRowsTotal = 0;
+  double tiledRowsTotal = 0;
+  double columnMatrixTotal = 0;
+  double tiledMatrixTotal = 0;
+
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg.compare("--loops") == 0 && i + 1 < argc) {
+      loops = atoi(argv[++i]);
+      continue;
+    }
+    Image image;
+    try {
+      image.read(arg);
+    } catch (...) {
+      cerr << "Unable to open image " << arg << ", ignoring" << endl;
+      continue;
+    }
+    try {
+      Ref<LuminanceSource> source(new MagickBitmapSource(image));
+      int width = source->getWidth();
+      int height = source->getHeight();
+      LuminanceView view = source->getMatrixView();
+      vector<unsigned char> grey(width * height);
+      for (int y = 0; y < height; y++) {
+        memcpy(&grey[y * width], view.getRow(y), width);
+      }
+      Ref<LuminanceSource> upright(new GreyscaleLuminanceSource(&grey[0], width, height,
+                                                                0, 0, width, height));
+      for (int loop = 0; loop < loops; loop++) {
+        // Fresh sources every time, as the tiled one keeps what it rotated.
+        bool columnFound, tiledFound;
+        double columnDecode =
+          decodeRotated(Ref<LuminanceSource>(new ColumnRotatedSource(&grey[0], width, height)),
+                        columnFound);
+        double tiledDecode = decodeRotated(upright->rotateCounterClockwise(), tiledFound);
+        double columnRows =
+          readRows(Ref<LuminanceSource>(new ColumnRotatedSource(&grey[0], width, height)));
+        double tiledRows = readRows(upright->rotateCounterClockwise());
+        double columnMatrix =
+          rotateMatrix(Ref<LuminanceSource>(new ColumnRotatedSource(&grey[0], width, height)));
+        double tiledMatrix = rotateMatrix(upright->rotateCounterClockwise());
+        if (columnFound != tiledFound) {
+          cerr << arg << ": rotations disagree" << endl;
+          return 1;
+        }
+
+        columnDecodeTotal += columnDecode;
+        tiledDecodeTotal += tiledDecode;
+        columnRowsTotal += columnRows;
+        tiledRowsTotal += tiledRows;
+        columnMatrixTotal += columnMatrix;
+        tiledMatrixTotal += tiledMatrix;
+        cout << arg << " (" << width << "x" << height << "): "
+             << (tiledFound ? "decoded" : "not found") << ", decode column "
+             << columnDecode << " ms, tiled " << tiledDecode << " ms; rows column "
+             << columnRows << " ms, tiled " << tiledRows << " ms; matrix column "
+             << columnMatrix << " ms, tiled " << tiledMatrix << " ms" << endl;
+      }
+      images++;
+    } catch (zxing::Exception& e) {
+      cerr << "zxing::Exception: " << e.what() << endl;
+      return 1;
+    }
+  }
+  if (images == 0 || loops < 1) {
+    cout << "Usage: " << argv[0] << " [--loops <n>] <image1> [<image2> ...]" << endl;
+    return 1;
+  }
+
+  cout << "decode column " << columnDecodeTotal << " ms, tiled " << tiledDecodeTotal
+       << " ms; rows column " << columnRowsTotal << " ms, tiled " << tiledRowsTotal
+       << " ms; matrix column " << columnMatrixTotal << " ms, tiled " << tiledMatrixTotal
+       << " ms" << endl;
+  return 0;
+}